@@ -4,9 +4,11 @@
 #include "../engine/MatchingEngine.hpp"
 #include "../monitoring/Metrics.hpp"
 #include "../risk/RiskEngine.hpp"
+#include "../utils/ApiKeys.hpp"
 #include <cpprest/http_listener.h>
 #include <cpprest/json.h>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <atomic>
 
@@ -21,7 +23,8 @@ public:
     RestApi(const std::string& address, 
             std::shared_ptr<engine::MatchingEngine> engine,
             std::shared_ptr<monitoring::Metrics> metrics,
-            std::shared_ptr<risk::RiskEngine> riskEngine);
+            std::shared_ptr<risk::RiskEngine> riskEngine,
+            std::shared_ptr<const utils::ApiKeys> apiKeys);
     ~RestApi();
     
     void start();
@@ -32,6 +35,7 @@ private:
     std::shared_ptr<engine::MatchingEngine> engine_;
     std::shared_ptr<monitoring::Metrics> metrics_;
     std::shared_ptr<risk::RiskEngine> riskEngine_;
+    std::shared_ptr<const utils::ApiKeys> apiKeys_;
     std::atomic<bool> running_{false};
     std::thread serverThread_;
     
@@ -46,13 +50,21 @@ private:
     void handleStatistics(const http_request& request);
     void handleOrderBook(const http_request& request);
     void handleSubmitOrder(const http_request& request);
+    void handleSubmitBulkOrders(const http_request& request);
+    void handleSubmitParentOrder(const http_request& request);
+    void handleCancelParentOrder(const http_request& request);
     void handleCancelOrder(const http_request& request);
     void handlePositions(const http_request& request);
     void handleRiskLimits(const http_request& request);
+    void handleValueAtRisk(const http_request& request);
     void handleSystemStatus(const http_request& request);
     void handleConfig(const http_request& request);
     
+    // The user of the request's X-Api-Key; replies 401 and returns nothing without one
+    std::optional<engine::UserId> authenticate(const http_request& request);
+    
     // Utility methods
+    engine::OrderPtr orderFromJson(json::value& body, engine::UserId userId);
     json::value engineStatusToJson(engine::EngineStatus status);
     json::value orderToJson(const engine::Order& order);
     json::value tradeToJson(const engine::Trade& trade);
@@ -7,73 +7,44 @@
 
 namespace engine {
 
-// Iceberg Order - shows only a portion of the total quantity
+// Iceberg Order - shows only a portion of the total quantity. The book keeps
+// the visible peak and replenishes it from the remainder as each peak fills.
 class IcebergOrder : public Order {
 public:
     IcebergOrder(OrderId id, UserId uid, std::string sym, OrderSide s, 
                  Price p, Quantity totalQty, Quantity peakSize,
                  Timestamp ts = std::chrono::steady_clock::now().time_since_epoch())
         : Order(id, uid, std::move(sym), OrderType::ICEBERG, s, p, totalQty, ts)
-        , peakSize_(peakSize)
-        , hiddenQuantity_(totalQty - std::min(peakSize, totalQty))
     {
-        visibleQuantity_ = std::min(peakSize, totalQty);
+        setPeakSize(peakSize);
     }
     
-    Quantity getVisibleQuantity() const { return visibleQuantity_; }
-    Quantity getHiddenQuantity() const { return hiddenQuantity_; }
-    Quantity getPeakSize() const { return peakSize_; }
-    
-    void replenish() {
-        if (hiddenQuantity_ > 0) {
-            Quantity replenishAmount = std::min(peakSize_, hiddenQuantity_);
-            visibleQuantity_ += replenishAmount;
-            hiddenQuantity_ -= replenishAmount;
-        }
-    }
-    
-private:
-    Quantity peakSize_;
-    Quantity visibleQuantity_;
-    Quantity hiddenQuantity_;
+    Quantity getHiddenQuantity() const { return getRemainingQuantity() - getVisibleQuantity(); }
 };
 
-// Stop Order - becomes active when price reaches trigger level
+// Stop-limit order - parked in the book's stop tree until a print reaches the
+// trigger price, then matched as a limit order at orderPrice
 class StopOrder : public Order {
 public:
     StopOrder(OrderId id, UserId uid, std::string sym, OrderSide s, 
               Price triggerPrice, Price orderPrice, Quantity qty,
               Timestamp ts = std::chrono::steady_clock::now().time_since_epoch())
-        : Order(id, uid, std::move(sym), OrderType::LIMIT, s, orderPrice, qty, ts)
-        , triggerPrice_(triggerPrice)
-        , activated_(false)
-    {}
+        : Order(id, uid, std::move(sym), OrderType::STOP_LIMIT, s, orderPrice, qty, ts)
+    {
+        setStopPrice(triggerPrice);
+    }
     
     bool shouldActivate(Price currentPrice) const {
-        if (activated_) return false;
-        
-        if (side_ == OrderSide::BUY) {
-            return currentPrice >= triggerPrice_;
+        if (getSide() == OrderSide::BUY) {
+            return currentPrice >= getStopPrice();
         } else {
-            return currentPrice <= triggerPrice_;
+            return currentPrice <= getStopPrice();
         }
     }
     
-    void activate() {
-        activated_ = true;
-    }
-    
-    bool isActivated() const {
-        return activated_;
-    }
-    
     Price getTriggerPrice() const {
-        return triggerPrice_;
+        return getStopPrice();
     }
-    
-private:
-    Price triggerPrice_;
-    bool activated_;
 };
 
 // TWAP Order - Time Weighted Average Price
@@ -0,0 +1,132 @@
+// include/engine/Events.hpp
+#pragma once
+
+#include "Order.hpp"
+
+namespace engine {
+
+enum class ExecType {
+    NEW,
+    PARTIAL_FILL,
+    FILL,
+    CANCELLED,
+    REJECTED,
+    REPLACED,        // modified in the book; quantities as after the modify
+    MODIFY_REJECTED  // a modify not applied; the order stands as it was
+};
+
+// One per acknowledgement, fill, partial fill, cancel or reject. Kept trivially
+// copyable so it can travel through the lock-free rings without allocating;
+// gateways keep their own per-order context (ClOrdID, symbol, session).
+struct ExecutionEvent {
+    uint64_t execId{0};
+    OrderId orderId{0};
+    UserId userId{0};
+    OrderSide side{OrderSide::BUY};
+    ExecType execType{ExecType::NEW};
+    Quantity orderQty{0};
+    Quantity lastQty{0};
+    Price lastPx{0.0};
+    Quantity cumQty{0};
+    Quantity leavesQty{0};
+    Price avgPx{0.0};
+    Price reservedPx{0.0}; // for releasing the order's risk reservation
+    uint32_t sessionIndex{0};
+    uint32_t sessionOrderSlot{0};
+    OrderId parentId{0}; // a child's parent order, folded on its owner's lane
+    uint64_t expiryTimer{0}; // a DAY/GTD order's timer, cancelled on its owner's lane once done
+    
+    static ExecutionEvent fromOrder(const Order& order, ExecType type,
+                                    Quantity lastQty = 0, Price lastPx = 0.0) {
+        ExecutionEvent event;
+        event.orderId = order.getId();
+        event.userId = order.getUserId();
+        event.side = order.getSide();
+        event.execType = type;
+        event.orderQty = order.getQuantity();
+        event.lastQty = lastQty;
+        event.lastPx = lastPx;
+        event.cumQty = order.getFilledQuantity();
+        event.leavesQty = (type == ExecType::CANCELLED || type == ExecType::REJECTED)
+                              ? 0 : order.getRemainingQuantity();
+        event.avgPx = order.getAveragePrice();
+        event.reservedPx = order.getReservedPrice();
+        event.sessionIndex = order.getSessionIndex();
+        event.sessionOrderSlot = order.getSessionOrderSlot();
+        event.parentId = order.getParentId();
+        event.expiryTimer = order.getExpiryTimer();
+        return event;
+    }
+};
+
+// Which gateway receives an order's events, by the session index it was entered
+// through: FIX sessions are numbered from 1, the stream transports (ZMQ, shared
+// memory) from STREAM_SESSION_BASE. Session 0 (REST, internal) has no gateway.
+enum class Gateway {
+    FIX,
+    STREAM
+};
+
+constexpr uint32_t STREAM_SESSION_BASE = 1u << 16;
+
+inline Gateway gatewayOf(uint32_t sessionIndex) {
+    return sessionIndex >= STREAM_SESSION_BASE ? Gateway::STREAM : Gateway::FIX;
+}
+
+// An instrument's best bid and ask as displayed (0 quantity for an empty side)
+// and its last print, published whenever one of them changes. Trivially
+// copyable like ExecutionEvent, so the symbol travels inline.
+struct TopOfBook {
+    static constexpr size_t MAX_SYMBOL_SIZE = 15;
+    
+    char symbol[MAX_SYMBOL_SIZE + 1]{};
+    Price bidPrice{0.0};
+    Quantity bidQuantity{0};
+    Price askPrice{0.0};
+    Quantity askQuantity{0};
+    Price lastPrice{0.0};
+    
+    bool sameQuote(const TopOfBook& other) const {
+        return bidPrice == other.bidPrice && bidQuantity == other.bidQuantity &&
+               askPrice == other.askPrice && askQuantity == other.askQuantity &&
+               lastPrice == other.lastPrice;
+    }
+};
+
+// Incremental market data for one modify: the displayed state of the level the
+// order now rests at and, when it moved, of the level it left
+struct BookUpdate {
+    OrderSide side{OrderSide::BUY};
+    Price price{0.0};
+    Quantity quantity{0};           // displayed at price; 0 once the level is gone
+    uint32_t orderCount{0};
+    Price previousPrice{0.0};       // 0 unless the order moved
+    Quantity previousQuantity{0};
+    uint32_t previousOrderCount{0};
+};
+
+// The indicative uncross of a call auction, published as it changes: the price
+// that would execute the most volume now, that volume (0 while the book does
+// not cross) and what would be left unfilled on the heavier side
+struct AuctionUpdate {
+    Price indicativePrice{0.0};
+    Quantity indicativeVolume{0};
+    Quantity surplus{0};
+    OrderSide surplusSide{OrderSide::BUY};
+    
+    bool operator==(const AuctionUpdate&) const = default;
+};
+
+// An AuctionUpdate as the engine queues it for the market data publisher
+struct IndicativeUpdate {
+    char symbol[TopOfBook::MAX_SYMBOL_SIZE + 1]{};
+    AuctionUpdate auction;
+};
+
+// Likewise a BookUpdate
+struct DepthUpdate {
+    char symbol[TopOfBook::MAX_SYMBOL_SIZE + 1]{};
+    BookUpdate book;
+};
+
+} // namespace engine
\ No newline at end of file
@@ -2,17 +2,25 @@
 #pragma once
 
 #include "OrderBook.hpp"
+#include "Events.hpp"
+#include "ParentOrderManager.hpp"
 #include "Types.hpp"
 #include "../networking/Protocol.hpp"
+#include "../risk/CircuitBreaker.hpp"
 #include "../utils/LockFreeQueue.hpp"
+#include "../utils/TimerWheel.hpp"
 #include "../utils/ThreadPool.hpp"
 #include "../utils/Logger.hpp"
 #include "../utils/Config.hpp"
+#include <array>
 #include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <shared_mutex>
 #include <chrono>
+#include <future>
+#include <optional>
+#include <thread>
 
 namespace engine {
 
@@ -32,6 +40,19 @@ struct Statistics {
     uint64_t maxLatencyNs{0};
 };
 
+// One instrument's two-sided quote in a mass quote: the open quantity to show
+// on each side; 0 pulls that side. A side that re-enters carries its slot as
+// its session order slot, the gateway's context for its reports.
+struct QuoteEntry {
+    std::string symbol;
+    Price bidPrice{0.0};
+    Quantity bidQuantity{0};
+    Price askPrice{0.0};
+    Quantity askQuantity{0};
+    uint32_t bidSlot{0};
+    uint32_t askSlot{0};
+};
+
 class MatchingEngine {
 public:
     MatchingEngine(const utils::Config& config);
@@ -44,8 +65,91 @@ public:
     
     // Order management
     OrderResponse submitOrder(OrderPtr order);
-    bool cancelOrder(OrderId orderId, UserId userId);
-    bool modifyOrder(OrderId orderId, UserId userId, Quantity newQuantity, Price newPrice);
+    
+    // Only the user's own orders; a gateway passes its session so that clients
+    // sharing a user cannot cancel each other's. False for any other order.
+    bool cancelOrder(OrderId orderId, UserId userId, uint32_t sessionIndex = 0);
+    
+    // Mass cancel, e.g. a market maker pulling its quotes: every working order
+    // of the user on symbol, or on every instrument when symbol is empty. Each
+    // is reported CANCELLED; returns how many were.
+    size_t cancelUserOrders(UserId userId, const std::string& symbol = "");
+    
+    // Cancel-on-disconnect: every working order entered through the gateway session
+    size_t cancelSessionOrders(uint32_t sessionIndex);
+    
+    // Cancel/replace, queued on the user's lane like a new order, since a new
+    // price may trade; newQuantity is the new total, fills included. Applied
+    // modifies report REPLACED. One that is not the user's (or, given a session,
+    // not entered through it), or that the book or risk cannot apply, leaves the
+    // order unchanged and reports MODIFY_REJECTED to that session. False if the
+    // symbol is unknown or the lane's queue is full.
+    bool modifyOrder(OrderId orderId, UserId userId, const std::string& symbol, Quantity newQuantity,
+                     Price newPrice, uint32_t sessionIndex = 0);
+    
+    // Asynchronous entry: queues the order on the lane that owns its user's risk
+    // shard and returns immediately. Outcomes arrive as ExecutionEvents; false if
+    // the lane's queue is full.
+    bool enqueueOrder(OrderPtr order);
+    
+    // One order of a bulk batch as the lane left it
+    struct BatchOutcome {
+        OrderId orderId{0};
+        OrderStatus status{OrderStatus::NEW};
+        Quantity filledQuantity{0};
+        Price averagePrice{0.0};
+    };
+    
+    // Bulk entry for one user (e.g. a market maker's quote refresh): the lane risk
+    // checks the batch as a unit, then matches the orders in sequence. If the batch
+    // is rejected every order is rejected. The future carries the outcomes, in
+    // order, once the lane is done; invalid if the lane's queue is full.
+    std::future<std::vector<BatchOutcome>> enqueueOrders(std::vector<OrderPtr> orders);
+    
+    // TWAP/VWAP entry: the parent's lane works it as child orders, one per slice
+    // of the schedule, and reports the children's fills as the parent's. A
+    // parent is cancelled with cancelParentOrder, not cancelOrder.
+    bool enqueueParentOrder(OrderPtr parent, ParentOrderManager::Schedule schedule);
+    bool cancelParentOrder(OrderId parentId, UserId userId);
+    
+    // Market makers quote through one bid and one ask slot per instrument,
+    // allocated here once per user (engine.market_makers at start). A mass quote then
+    // replaces each listed instrument's pair on the user's lane: resting sides
+    // are modified in place and only filled or pulled ones re-enter, so a
+    // refresh costs no cancel/new pair. A side risk refuses is pulled; a
+    // crossed entry is skipped. Sides that re-enter report to sessionIndex's
+    // gateway. False if the lane's queue is full.
+    void registerMarketMaker(UserId userId);
+    bool enqueueMassQuote(UserId userId, std::vector<QuoteEntry> quotes, uint32_t sessionIndex = 0);
+    
+    // Call auctions (opening with engine.opening_auction, or any time): from
+    // startAuction the instrument collects orders without matching and
+    // publishes its indicative uncross as it changes; uncrossAuction queues the
+    // uncross on a matching lane, which executes it in one batch and resumes
+    // continuous matching. False for an unknown symbol or a full queue.
+    bool startAuction(const std::string& symbol);
+    bool uncrossAuction(const std::string& symbol);
+    
+    // Outbound acks, fills, partials, cancels and rejects of the orders entered
+    // through gateway, in matching order. Single consumer per gateway.
+    std::optional<ExecutionEvent> pollExecutionEvent(Gateway gateway = Gateway::FIX);
+    
+    // Top-of-book changes, in matching order per instrument. Single consumer (the
+    // stream gateway); changes are dropped while it is behind, the next one
+    // carrying the full state again.
+    std::optional<TopOfBook> pollTopOfBook();
+    
+    // Indicative uncross changes of instruments in a call auction, with the same
+    // single consumer and drop policy as pollTopOfBook.
+    std::optional<IndicativeUpdate> pollIndicative();
+    
+    // Level changes from modifies (BookUpdate), in matching order per
+    // instrument; same single consumer. A dropped one is not repeated, so a
+    // subscriber that sees a gap resynchronises from getMarketData.
+    std::optional<DepthUpdate> pollDepthUpdate();
+    
+    // Ids for orders the gateways build
+    OrderId generateOrderId();
     
     // Market data
     MarketDataSnapshot getMarketData(const std::string& symbol, uint8_t depth = 10) const;
@@ -58,18 +162,108 @@ public:
     
 private:
     struct InstrumentData {
+        explicit InstrumentData(const std::string& symbol) : symbol(symbol), orderBook(symbol) {
+            symbol.copy(lastTop.symbol, TopOfBook::MAX_SYMBOL_SIZE);
+        }
+        
+        std::string symbol;
         OrderBook orderBook;
         std::vector<Trade> recentTrades;
+        std::unordered_map<UserId, OrderBook::Quote> quotes; // market makers' slots, under mutex
+        TopOfBook lastTop;                                    // as last published, under mutex
         mutable std::shared_mutex mutex;
     };
     
+    // A new parent order, or userId's cancel of one (cancelId) when parent is null
+    struct ParentRequest {
+        OrderPtr parent;
+        ParentOrderManager::Schedule schedule;
+        OrderId cancelId{0};
+        UserId userId{0};
+    };
+    
+    struct ModifyRequest {
+        OrderId orderId{0};
+        UserId userId{0};
+        Quantity quantity{0};
+        Price price{0.0};
+        InstrumentData* instrument{nullptr};
+        uint32_t sessionIndex{0};
+    };
+    
+    struct QuoteRequest {
+        UserId userId{0};
+        std::vector<QuoteEntry> entries;
+        uint32_t sessionIndex{0};
+    };
+    
+    // One queued submission: a single order, a bulk batch when order is null, a
+    // parent-order request, a modify, a mass quote or an auction uncross
+    struct LaneItem {
+        OrderPtr order;
+        std::vector<OrderPtr> batch;
+        std::unique_ptr<ParentRequest> parent;
+        std::unique_ptr<ModifyRequest> modify;
+        std::unique_ptr<QuoteRequest> quotes;
+        InstrumentData* uncross{nullptr};
+        std::unique_ptr<std::promise<std::vector<BatchOutcome>>> batchDone;
+    };
+    
+    // A lane timer: the expiry of one of its resting orders, or the next slice
+    // of one of its parent orders
+    struct TimerEvent {
+        enum class Kind { ORDER_EXPIRY, PARENT_SLICE };
+        
+        Kind kind{Kind::ORDER_EXPIRY};
+        OrderId orderId{0};
+        InstrumentData* instrument{nullptr};
+    };
+    
+    // One per risk shard (engine.matching_threads). Each lane's thread runs risk
+    // checks and matching for its users only, so their risk records have one writer.
+    struct MatchingLane {
+        utils::LockFreeQueue<LaneItem, 65536> orders;
+        std::mutex enqueueMutex; // the ring is single-producer
+        std::thread thread;
+        size_t shard{0};
+        
+        // Millisecond ticks of the system clock; advanced by the lane thread on
+        // every pass, so timers fire there between orders without any polling of
+        // the orders themselves
+        utils::TimerWheel<TimerEvent> timers;
+        ParentOrderManager parents;
+        
+        // Fills of this lane's child orders, from whichever lane matched them;
+        // pushed under executionPublishMutex_
+        utils::LockFreeQueue<ExecutionEvent, 4096> childFills;
+        
+        // Expiry timers of this lane's orders that filled or were cancelled,
+        // wherever that happened; pushed under executionPublishMutex_ and
+        // cancelled here, as the wheel is the lane thread's alone
+        utils::LockFreeQueue<uint64_t, 4096> doneTimers;
+    };
+    
     std::unordered_map<std::string, InstrumentData> instruments_;
     utils::Config config_;
     
+    // Checked under the instrument's lock, which makes that lock holder the
+    // breaker's single caller per instrument; null when risk.circuit_breaker_enabled
+    // is off
+    std::unique_ptr<risk::CircuitBreaker> circuitBreaker_;
+    
     // Multi-threaded processing
     utils::ThreadPool processingPool_;
-    utils::LockFreeQueue<OrderPtr, 100000> orderQueue_;
+    std::vector<std::unique_ptr<MatchingLane>> lanes_;
     utils::LockFreeQueue<OrderResponse, 100000> responseQueue_;
+    std::array<utils::LockFreeQueue<ExecutionEvent, 65536>, 2> executionQueues_; // by Gateway
+    utils::LockFreeQueue<TopOfBook, 65536> topOfBookQueue_;
+    utils::LockFreeQueue<IndicativeUpdate, 4096> indicativeQueue_;
+    utils::LockFreeQueue<DepthUpdate, 65536> depthQueue_;
+    
+    // The rings are single-producer; lanes publish through this
+    std::mutex executionPublishMutex_;
+    
+    int64_t sessionCloseMs_{0}; // DAY expiry, milliseconds after UTC midnight
     
     std::atomic<bool> running_{false};
     std::atomic<EngineStatus> status_{EngineStatus::STOPPED};
@@ -82,15 +276,39 @@ private:
     // Order ID generation
     std::atomic<OrderId> nextOrderId_{1};
     std::atomic<TradeId> nextTradeId_{1};
+    std::atomic<uint64_t> nextExecId_{1};
     
     void initializeInstruments();
-    void processOrders();
-    void processSingleOrder(OrderPtr order);
+    void processOrders(MatchingLane& lane);
+    void processSingleOrder(MatchingLane& lane, OrderPtr order);
+    void processBatch(MatchingLane& lane, std::vector<OrderPtr>& batch,
+                      std::promise<std::vector<BatchOutcome>>& done);
+    void matchOrder(MatchingLane& lane, OrderPtr order);
+    void processModify(MatchingLane& lane, const ModifyRequest& request);
+    void processMassQuote(MatchingLane& lane, const QuoteRequest& request);
+    OrderBook::QuoteSide checkQuoteSide(InstrumentData& instrument, Order& order, OrderBook::QuoteSide target,
+                                        uint32_t sessionIndex, uint32_t slot,
+                                        std::vector<ExecutionEvent>& executions);
+    void keepTrades(InstrumentData& instrument, const std::vector<Trade>& trades);
+    bool tradingHalted(const std::string& symbol, bool countOrder);
+    void checkPrints(const std::string& symbol, const std::vector<Trade>& trades);
+    void processUncross(MatchingLane& lane, InstrumentData& instrument);
+    void publishAuctionUpdate(InstrumentData& instrument);
+    void publishMarketData(InstrumentData& instrument);
+    void publishBookUpdates(InstrumentData& instrument, std::vector<BookUpdate>& updates);
+    void fireTimer(MatchingLane& lane, const TimerEvent& event);
+    bool cancelOnLane(MatchingLane& lane, InstrumentData& instrument, OrderId orderId);
+    void publishCancels(InstrumentData& instrument);
+    void processParentRequest(MatchingLane& lane, ParentRequest& request);
+    void releaseParentSlice(MatchingLane& lane, OrderId parentId, InstrumentData& instrument);
+    void foldChildFills(MatchingLane& lane);
+    int64_t expiryTick(const Order& order) const;
+    static int64_t timerTick(std::chrono::system_clock::time_point time);
+    void rejectOrder(const OrderPtr& order, const std::string& reason);
     void sendResponse(const OrderResponse& response);
+    void publishExecutions(std::vector<ExecutionEvent>& events);
     void updateStatistics(uint64_t processingTimeNs);
     
-    // ID generation
-    OrderId generateOrderId();
     TradeId generateTradeId();
 };
 
@@ -13,7 +13,7 @@ public:
         : orderId(id), userId(uid), symbol(std::move(sym)), type(t), side(s), 
           price(p), quantity(q), timestamp(ts) 
     {
-        if (type == OrderType::MARKET) {
+        if (type == OrderType::MARKET || type == OrderType::STOP) {
             price = (side == OrderSide::BUY) ? std::numeric_limits<Price>::max() 
                                             : std::numeric_limits<Price>::min();
         }
@@ -28,8 +28,21 @@ public:
     Price getPrice() const { return price; }
     Quantity getQuantity() const { return quantity; }
     Quantity getFilledQuantity() const { return filledQuantity; }
+    Price getAveragePrice() const {
+        return filledQuantity > 0 ? filledNotional / static_cast<double>(filledQuantity) : 0.0;
+    }
     Timestamp getTimestamp() const { return timestamp; }
     OrderStatus getStatus() const { return status; }
+    uint32_t getSessionIndex() const { return sessionIndex; }
+    uint32_t getSessionOrderSlot() const { return sessionOrderSlot; }
+    Price getReservedPrice() const { return reservedPrice; }
+    Price getStopPrice() const { return stopPrice; }
+    Quantity getPeakSize() const { return peakSize; }
+    Quantity getVisibleQuantity() const { return visibleQuantity; }
+    TimeInForce getTimeInForce() const { return timeInForce; }
+    Timestamp getExpireTime() const { return expireTime; }
+    OrderId getParentId() const { return parentId; }
+    uint64_t getExpiryTimer() const { return expiryTimer; }
     
     // State management
     Quantity getRemainingQuantity() const {
@@ -57,7 +70,58 @@ public:
         status = newStatus;
     }
     
+    // Set by the entering gateway so reports can be routed back without a lookup
+    void setSessionRoute(uint32_t session, uint32_t slot) {
+        sessionIndex = session;
+        sessionOrderSlot = slot;
+    }
+    
+    // STOP and STOP_LIMIT: the last-trade price that elects the order
+    void setStopPrice(Price stop) {
+        stopPrice = stop;
+    }
+    
+    // ICEBERG: the quantity shown per replenishment; 0 shows it all
+    void setPeakSize(Quantity peak) {
+        peakSize = peak;
+    }
+    
+    // GTD orders expire at expireAt (system clock, since the epoch)
+    void setTimeInForce(TimeInForce tif, Timestamp expireAt = Timestamp{0}) {
+        timeInForce = tif;
+        expireTime = expireAt;
+    }
+    
+    // DAY and GTD once resting: the entering lane's timer that expires the order
+    void setExpiryTimer(uint64_t timer) {
+        expiryTimer = timer;
+    }
+    
+    // Quotes: re-enters a filled or pulled order object as a fresh order under a
+    // new id, so a market maker's quote slots are allocated once while each
+    // arrival is reported, and can be cancelled, as an order of its own
+    void rearm(OrderId newId, Price newPrice, Quantity newQuantity) {
+        orderId = newId;
+        price = newPrice;
+        quantity = newQuantity;
+        filledQuantity = 0;
+        filledNotional = 0.0;
+        visibleQuantity = 0;
+        status = OrderStatus::NEW;
+        reservedPrice = 0.0;
+        expiryTimer = 0;
+        timestamp = std::chrono::steady_clock::now().time_since_epoch();
+    }
+    
+    // Set by pre-trade risk: the unit price its exposure reservation was taken at
+    void setReservedPrice(Price reserved) {
+        reservedPrice = reserved;
+    }
+    
 private:
+    friend class OrderBook;
+    friend class ParentOrderManager;
+    
     OrderId orderId;
     UserId userId;
     std::string symbol;
@@ -66,12 +130,31 @@ private:
     Price price;
     Quantity quantity;
     Quantity filledQuantity{0};
+    double filledNotional{0.0};
     Timestamp timestamp;
     OrderStatus status{OrderStatus::NEW};
     
     // For iceberg orders
     Quantity visibleQuantity{0};
     Quantity peakSize{0};
+    
+    // Gateway routing (cold): entering session, 0 if none, and the order's slot in it
+    uint32_t sessionIndex{0};
+    uint32_t sessionOrderSlot{0};
+    
+    // Pre-trade risk (cold)
+    Price reservedPrice{0.0};
+    
+    // Stop orders (cold)
+    Price stopPrice{0.0};
+    
+    // Time in force (cold)
+    TimeInForce timeInForce{TimeInForce::GTC};
+    Timestamp expireTime{0};
+    uint64_t expiryTimer{0};
+    
+    // TWAP/VWAP children (cold): the parent working the order, 0 if none
+    OrderId parentId{0};
 };
 
 } // namespace engine
\ No newline at end of file
@@ -3,6 +3,10 @@
 
 #include "Order.hpp"
 #include "Trade.hpp"
+#include "Events.hpp"
+#include <chrono>
+#include <functional>
+#include <limits>
 #include <map>
 #include <list>
 #include <unordered_map>
@@ -20,7 +24,50 @@ public:
     // Order management
     std::vector<Trade> addOrder(OrderPtr order);
     bool cancelOrder(OrderId orderId);
-    bool modifyOrder(OrderId orderId, Quantity newQuantity, Price newPrice);
+    
+    // A client cancel: false, changing nothing, unless the order is userId's and,
+    // when sessionIndex is not 0, was entered through that gateway session
+    bool cancelOrder(OrderId orderId, UserId userId, uint32_t sessionIndex);
+    
+    // Mass cancel: every working order of the user, or entered through the
+    // gateway session, parked stops included. Walks the owner's chain of entries,
+    // so it costs O(orders cancelled) whatever the size of the book. Returns the
+    // number cancelled, each reported CANCELLED like a single cancel.
+    size_t cancelUserOrders(UserId userId);
+    size_t cancelSessionOrders(uint32_t sessionIndex);
+    
+    // Cancel/replace of a resting order; newQuantity is the new total, fills
+    // included. Reducing at the same price keeps queue position; a new price or
+    // a larger size re-enters the order at the back, matching if it now crosses
+    // (its trades are appended to trades). Either way one REPLACED event and one
+    // BookUpdate. False, changing nothing, if canModify would be false.
+    bool modifyOrder(OrderId orderId, Quantity newQuantity, Price newPrice, std::vector<Trade>& trades);
+    bool canModify(OrderId orderId, Quantity newQuantity, Price newPrice) const;
+    OrderPtr findOrder(OrderId orderId) const;
+    
+    // A market maker's two-sided quote: one LIMIT order object per side,
+    // allocated once and re-entered in place by every update
+    struct Quote {
+        OrderPtr bid;
+        OrderPtr ask;
+    };
+    
+    // One side's target: the open quantity to show at price; 0 pulls the side
+    struct QuoteSide {
+        Price price{0.0};
+        Quantity quantity{0};
+    };
+    
+    // Replaces both sides under one lock, so no match or read sees half an
+    // update. A resting side changes as modifyOrder would (in place if it only
+    // shrinks), or is pulled if it cannot or approveModify, asked only once the
+    // book would apply the change, refuses it; a side not resting enters as a new
+    // order, already re-armed by the caller (Order::rearm). The side moving away
+    // goes first, so a quote shifting through its own old price never trades
+    // with itself.
+    using ApproveModify = std::function<bool(Order& order, Quantity newQuantity, Price newPrice)>;
+    std::vector<Trade> updateQuote(Quote& quote, QuoteSide bid, QuoteSide ask,
+                                   const ApproveModify& approveModify = {});
     
     // Market data
     struct PriceLevel {
@@ -35,6 +82,9 @@ public:
     };
     
     Depth getDepth(uint8_t levels = 10) const;
+    
+    // Fills out's prices and quantities; the caller sets the symbol
+    void getTopOfBook(TopOfBook& out) const;
     std::vector<Trade> getRecentTrades(size_t count = 100) const;
     
     Price getBestBid() const;
@@ -44,21 +94,101 @@ public:
     // Statistics
     Quantity getTotalVolume() const;
     size_t getTotalOrders() const;
+    size_t getStopOrderCount() const;
+    
+    // Dynamic price band: one order's sweep may not print further than percent
+    // from the last trade before it. A sweep the band stops has its remainder
+    // cancelled and pauses matching for pause; orders arriving meanwhile are
+    // cancelled. percent 0 disables the band.
+    void setPriceBand(double percent, std::chrono::milliseconds pause);
+    bool isPaused() const;
+    
+    // Call auction: from startAuction limit and iceberg orders rest without
+    // matching, crossed or not, stops park and immediate orders are cancelled.
+    // uncross executes every crossing order at the equilibrium price, the one
+    // with the most executable volume (then the least surplus, then nearest the
+    // last trade), and returns the book to continuous matching. The equilibrium
+    // is a tick price: bid limits round down to a tick and ask limits up, so no
+    // order executes beyond its limit.
+    void startAuction();
+    std::vector<Trade> uncross();
+    TradingPhase getPhase() const;
+    void setTickSize(Price tickSize);
+    
+    // How each level's resting orders share an incoming order. Auctions and
+    // fill-or-kill checks are unaffected.
+    struct AllocationSettings {
+        MatchingAlgorithm algorithm{MatchingAlgorithm::FIFO};
+        Quantity minimumAllocation{1}; // PRO_RATA: smaller shares fall to time priority
+        UserId leadMarketMaker{0};     // FIFO_LMM: whose orders take leadShare of each level first
+        double leadShare{0.0};
+    };
+    void setAllocation(const AllocationSettings& settings);
+    
+    // Moves the execution events produced since the last call onto the end of out.
+    // Call under the same lock as the addOrder/cancelOrder that produced them.
+    void drainExecutionEvents(std::vector<ExecutionEvent>& out);
+    
+    // Likewise for the incremental market data of modifies
+    void drainBookUpdates(std::vector<BookUpdate>& out);
+    
+    // During a call, the indicative uncross if it changed since the last call
+    bool drainAuctionUpdate(AuctionUpdate& out);
     
 private:
+    struct PriceLevelQueue;
+    struct OrderEntry;
+    
+    // Links of an intrusive doubly linked chain of entries
+    struct OwnerLink {
+        OrderEntry* prev{nullptr};
+        OrderEntry* next{nullptr};
+    };
+    
+    // The handle to a working order: its queue node and its level, which map
+    // nodes keep at a stable address until the level empties (null for a parked
+    // stop, whose node is in a stop list). Entries are map nodes too, so they are
+    // chained in place per user and per entering session for mass cancel.
     struct OrderEntry {
         OrderPtr order;
         typename std::list<OrderPtr>::iterator iterator;
+        PriceLevelQueue* level{nullptr};
+        OwnerLink byUser;
+        OwnerLink bySession;
+    };
+    
+    // A price level's queue and its quantities, kept as orders rest, fill and
+    // cancel: displayed (icebergs count only their current peak) and total
+    // remaining, so neither depth nor a fill-or-kill check walks the queue
+    struct PriceLevelQueue {
+        std::list<OrderPtr> orders;
+        Quantity visibleQuantity{0};
+        Quantity totalQuantity{0};
     };
     
-    using OrderTree = std::map<Price, std::list<OrderPtr>, std::greater<Price>>;
-    using OrderTreeAsk = std::map<Price, std::list<OrderPtr>>;
+    using OrderTree = std::map<Price, PriceLevelQueue, std::greater<Price>>;
+    using OrderTreeAsk = std::map<Price, PriceLevelQueue>;
+    using StopTree = std::map<Price, std::list<OrderPtr>, std::greater<Price>>;
+    using StopTreeAsk = std::map<Price, std::list<OrderPtr>>;
     
     std::string symbol_;
     OrderTree bids_;
     OrderTreeAsk asks_;
     std::unordered_map<OrderId, OrderEntry> orders_;
     
+    // Chain heads over the entries of orders_ and stopOrders_; session 0 (not
+    // entered through a gateway) is not chained
+    std::unordered_map<UserId, OrderEntry*> userOrders_;
+    std::unordered_map<uint32_t, OrderEntry*> sessionOrders_;
+    
+    // Parked stops by stop price, each tree's begin() electing first: buy stops
+    // elect when the last trade >= stop (lowest first), sell stops when <= stop
+    // (highest first); FIFO within a price
+    StopTreeAsk buyStops_;
+    StopTree sellStops_;
+    std::unordered_map<OrderId, OrderEntry> stopOrders_;
+    Price lastTradePrice_{0.0};
+    
     mutable std::shared_mutex mutex_;
     
     std::vector<Trade> recentTrades_;
@@ -66,21 +196,97 @@ private:
     
     Quantity totalVolume_{0};
     size_t totalOrders_{0};
+    TradeId lastTradeId_{0};
+    
+    std::vector<ExecutionEvent> executionEvents_;
+    std::vector<BookUpdate> bookUpdates_;
+    
+    // Sweep limits for the next order, recentred on its last print
+    double bandPercent_{0.0};
+    Price bandLower_{0.0};
+    Price bandUpper_{std::numeric_limits<Price>::max()};
+    std::chrono::milliseconds bandPause_{0};
+    bool paused_{false};
+    std::chrono::steady_clock::time_point resumeAt_;
+    
+    TradingPhase phase_{TradingPhase::CONTINUOUS};
+    Price tickSize_{0.01};
+    AuctionUpdate indicative_;
+    bool indicativeChanged_{false};
+    
+    // The crossed range's levels in ticks, ascending, and the distinct ticks;
+    // rebuilt by each equilibrium, reused
+    struct AuctionLevel {
+        double tick;
+        Quantity quantity;
+    };
+    std::vector<AuctionLevel> auctionBids_;
+    std::vector<AuctionLevel> auctionAsks_;
+    std::vector<double> auctionTicks_;
+    
+    AllocationSettings allocation_;
+    std::vector<Quantity> shares_; // pro-rata shares of the level being filled, reused
+    
+    // Allocation policies, one per MatchingAlgorithm: static fill(book, order,
+    // level, trades) shares the order's quantity among the level. sweep picks
+    // one per order, so each policy's loop is compiled into its own sweep and
+    // a fill never goes through an indirect call.
+    struct FifoAllocation;
+    struct ProRataAllocation;
+    struct LeadMarketMakerAllocation;
     
     // Matching algorithms
     std::vector<Trade> matchLimitOrder(OrderPtr order);
     std::vector<Trade> matchMarketOrder(OrderPtr order);
     std::vector<Trade> matchFOKOrder(OrderPtr order);
     std::vector<Trade> matchIOCOrder(OrderPtr order);
-    std::vector<Trade> matchIcebergOrder(OrderPtr order);
+    void sweep(const OrderPtr& order, Price limit, std::vector<Trade>& trades);
+    template<typename Allocation>
+    void sweepWith(const OrderPtr& order, Price limit, std::vector<Trade>& trades);
+    template<typename Allocation, typename Tree, typename Crosses>
+    void sweepLevels(Tree& tree, const OrderPtr& order, Crosses crosses, std::vector<Trade>& trades);
+    bool canFill(const Order& order, Price limit) const;
+    Price bandedLimit(const Order& order) const;
+    bool crossesBook(const Order& order) const;
+    void fillAtLevel(const OrderPtr& order, PriceLevelQueue& level, std::vector<Trade>& trades);
+    void fillResting(const OrderPtr& order, PriceLevelQueue& level, std::list<OrderPtr>::iterator position,
+                     Quantity quantity, std::vector<Trade>& trades);
+    void restOrder(const OrderPtr& order, PriceLevelQueue& level);
+    static Quantity displayedQuantity(const Order& order);
+    
+    // Stop orders
+    std::vector<Trade> parkStopOrder(OrderPtr order);
+    std::vector<Trade> matchElectedStop(OrderPtr order);
+    OrderPtr popElectedStop();
+    void removeStop(OrderId orderId);
+    void electStops(std::vector<Trade>& trades);
     
-    void executeTrade(OrderPtr buyOrder, OrderPtr sellOrder, 
-                     Quantity quantity, Price price);
+    Trade executeTrade(OrderPtr buyOrder, OrderPtr sellOrder, 
+                      Quantity quantity, Price price);
     void addToRecentTrades(const Trade& trade);
     
     // Utility functions
     void removeOrder(OrderId orderId);
+    void cancelEntry(OrderEntry& entry);
+    size_t cancelChain(OrderEntry* head, OwnerLink OrderEntry::*link);
+    void chainEntry(OrderEntry& entry);
+    void unchainEntry(OrderEntry& entry);
     void updateOrderStatus(OrderPtr order, OrderStatus newStatus);
+    void unlinkOrder(const OrderEntry& entry);
+    void afterMatch(std::vector<Trade>& trades);
+    bool inPause();
+    bool canModifyLocked(OrderId orderId, Quantity newQuantity, Price newPrice) const;
+    void modifyLocked(std::unordered_map<OrderId, OrderEntry>::iterator it, Quantity newQuantity,
+                      Price newPrice, std::vector<Trade>& trades);
+    void updateQuoteSide(const OrderPtr& order, QuoteSide target, const ApproveModify& approveModify,
+                         std::vector<Trade>& trades);
+    void levelState(OrderSide side, Price price, Quantity& quantity, uint32_t& orderCount) const;
+    void recentreBand(Price lastPrice);
+    AuctionUpdate equilibrium();
+    void refreshIndicative();
+    template<typename Tree>
+    void takeAuctionFill(Tree& tree, typename Tree::iterator level, const OrderPtr& order, Quantity quantity);
+    void stopSweep(const OrderPtr& order);
 };
 
 } // namespace engine
\ No newline at end of file
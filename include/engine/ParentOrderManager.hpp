@@ -0,0 +1,82 @@
+// include/engine/ParentOrderManager.hpp
+#pragma once
+
+#include "Order.hpp"
+#include "Events.hpp"
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+// Works TWAP and VWAP parent orders as a series of child orders, one slice at
+// a time. A parent never rests on a book: each slice cuts a child sized to the
+// parent's cumulative target for the slice less what it has filled, so whatever
+// the previous child left (cancelled by the caller first) rolls into the next.
+// Child fills are folded into the parent as the lane sees them, and reported as
+// the parent's own executions; any it did not see are folded at the next slice.
+// One per matching lane, used from its thread only.
+class ParentOrderManager {
+public:
+    // Slices run at equal intervals over duration; slice i targets weights[i] of
+    // the total. Equal weights give TWAP, an intraday volume profile VWAP.
+    struct Schedule {
+        std::chrono::milliseconds duration{0};
+        std::vector<double> weights;
+        
+        static Schedule twap(std::chrono::milliseconds duration, size_t slices) {
+            return Schedule{duration, std::vector<double>(slices, 1.0)};
+        }
+        static Schedule vwap(std::chrono::milliseconds duration, std::vector<double> volumeProfile) {
+            return Schedule{duration, std::move(volumeProfile)};
+        }
+    };
+    
+    struct Slice {
+        OrderPtr child;       // to submit; null when nothing is due this slice
+        int64_t nextTick{-1}; // when to release the next slice; -1 once the parent is done
+    };
+    
+    // A LIMIT or MARKET parent starting at startTick (milliseconds); false if
+    // the schedule is empty or the id is already working
+    bool add(OrderPtr parent, const Schedule& schedule, int64_t startTick);
+    
+    // The child cut by the last slice, if any. Cancel it before the next
+    // releaseSlice so its fills are final when they are folded in.
+    OrderPtr workingChild(OrderId parentId) const;
+    
+    // Folds a FILL or PARTIAL_FILL of a working child into its parent, reporting
+    // it on events; other events, and those of a finished child, are ignored
+    void onChildFill(const ExecutionEvent& fill, std::vector<ExecutionEvent>& events);
+    
+    // Folds the working child's fills not yet reported into the parent, and
+    // cuts the next child as childId. After the last slice the parent is
+    // finished: reported FILL, or CANCELLED for what it did not fill.
+    Slice releaseSlice(OrderId parentId, OrderId childId, std::vector<ExecutionEvent>& events);
+    
+    // Ends a parent early on its owner's request; its working child is the
+    // caller's to cancel first. False if it is not working or not userId's.
+    bool cancel(OrderId parentId, UserId userId, std::vector<ExecutionEvent>& events);
+    
+    size_t size() const { return parents_.size(); }
+    
+private:
+    struct ParentState {
+        OrderPtr parent;
+        OrderPtr child;
+        Quantity childReported{0};       // folded by onChildFill
+        double childReportedNotional{0.0};
+        std::vector<double> cumulativeWeights; // normalised, ending at 1
+        int64_t startTick{0};
+        int64_t intervalMs{0};
+        size_t nextSlice{0};
+    };
+    
+    std::unordered_map<OrderId, ParentState> parents_;
+    
+    static void fold(ParentState& state, Quantity quantity, double notional, std::vector<ExecutionEvent>& events);
+    static void foldChild(ParentState& state, std::vector<ExecutionEvent>& events);
+    static void finish(ParentState& state, std::vector<ExecutionEvent>& events);
+};
+
+} // namespace engine
\ No newline at end of file
@@ -7,21 +7,30 @@ namespace engine {
 
 class Trade {
 public:
-    Trade(TradeId id, OrderId buyId, OrderId sellId, Quantity q, Price p, Timestamp ts)
-        : tradeId(id), buyOrderId(buyId), sellOrderId(sellId), quantity(q), price(p), timestamp(ts)
+    Trade(TradeId id, std::string sym, OrderId buyId, OrderId sellId, UserId buyer, UserId seller,
+          Quantity q, Price p, Timestamp ts)
+        : tradeId(id), symbol(std::move(sym)), buyOrderId(buyId), sellOrderId(sellId),
+          buyerId(buyer), sellerId(seller), quantity(q), price(p), timestamp(ts)
     {}
     
+    // Trade ids are a per-instrument sequence
     TradeId getId() const { return tradeId; }
+    const std::string& getSymbol() const { return symbol; }
     OrderId getBuyOrderId() const { return buyOrderId; }
     OrderId getSellOrderId() const { return sellOrderId; }
+    UserId getBuyerId() const { return buyerId; }
+    UserId getSellerId() const { return sellerId; }
     Quantity getQuantity() const { return quantity; }
     Price getPrice() const { return price; }
     Timestamp getTimestamp() const { return timestamp; }
     
 private:
     TradeId tradeId;
+    std::string symbol;
     OrderId buyOrderId;
     OrderId sellOrderId;
+    UserId buyerId;
+    UserId sellerId;
     Quantity quantity;
     Price price;
     Timestamp timestamp;
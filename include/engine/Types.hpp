@@ -10,6 +10,7 @@ namespace engine {
 
 // Basic types
 using OrderId = uint64_t;
+using TradeId = uint64_t;
 using UserId = uint32_t;
 using Quantity = int64_t;
 using Price = double;
@@ -21,7 +22,29 @@ enum class OrderType {
     MARKET,
     FOK,    // Fill-or-Kill
     IOC,    // Immediate-or-Cancel
-    ICEBERG
+    ICEBERG,
+    STOP,       // Market order once a print reaches the stop price
+    STOP_LIMIT  // Limit order once a print reaches the stop price
+};
+
+// How long an order that rests may stay on the book
+enum class TimeInForce {
+    GTC,  // Good-till-cancel
+    DAY,  // Until the session close (engine.session_close_utc)
+    GTD   // Good-till-date: until its expire time
+};
+
+// How an incoming order is shared among the resting orders of a price level
+enum class MatchingAlgorithm {
+    FIFO,      // price-time priority
+    PRO_RATA,  // in proportion to displayed size, with a minimum allocation
+    FIFO_LMM   // a lead market maker's share first, then price-time
+};
+
+// How a book matches: continuously, or by collecting orders for one uncross
+enum class TradingPhase {
+    CONTINUOUS,
+    CALL_AUCTION
 };
 
 enum class OrderSide {
@@ -2,18 +2,40 @@
 #pragma once
 
 #include "../engine/Types.hpp"
+#include "../engine/Events.hpp"
+#include "NativeFixSession.hpp"
+#include "../utils/LockFreeQueue.hpp"
 #include "quickfix/Application.h"
 #include "quickfix/MessageCracker.h"
 #include "quickfix/Values.h"
+#include <array>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace networking {
 
+struct FixAdapterOptions {
+    bool nativeSession{false};       // serve FIX directly with NativeFixSession instead of QuickFIX
+    int nativePort{9878};
+    std::string senderCompId{"EXCHANGE"};
+    bool logMessages{false};         // render every message with toString() at debug level
+    bool mappedStore{true};          // MappedFixStore instead of QuickFIX's FileStore
+    std::string storePath{"store"};  // store directory for the native session layer
+    bool cancelOnDisconnect{true};   // mass cancel a session's working orders on logout or drop
+};
+
 class FixAdapter : public FIX::Application, public FIX::MessageCracker {
 public:
     FixAdapter(std::shared_ptr<engine::MatchingEngine> engine, 
-               const std::string& configFile);
+               const std::string& configFile,
+               FixAdapterOptions options = {});
     ~FixAdapter();
     
     void start();
@@ -35,19 +57,134 @@ public:
     void onMessage(const FIX42::OrderStatusRequest& message, const FIX::SessionID& sessionID);
     
     // Send FIX messages
-    void sendExecutionReport(const engine::Order& order, const FIX::SessionID& sessionID);
     void sendOrderCancelReject(const FIX42::OrderCancelRequest& request, 
                               const FIX::SessionID& sessionID, const std::string& reason);
+    void sendOrderCancelReject(const FIX42::OrderCancelReplaceRequest& request,
+                              const FIX::SessionID& sessionID, const std::string& reason);
     void sendMarketDataSnapshot(const std::string& symbol, const engine::OrderBook::Depth& depth);
     
 private:
     std::shared_ptr<engine::MatchingEngine> engine_;
+    // Owned here because the initiator keeps references to them
+    std::unique_ptr<FIX::SessionSettings> settings_;
+    std::unique_ptr<FIX::MessageStoreFactory> storeFactory_;
+    std::unique_ptr<FIX::LogFactory> logFactory_;
     std::unique_ptr<FIX::SocketInitiator> initiator_;
     std::string configFile_;
     std::atomic<bool> running_{false};
     
-    std::unordered_map<engine::OrderId, FIX::SessionID> orderSessions_;
-    mutable std::shared_mutex sessionsMutex_;
+    static constexpr size_t MAX_SESSIONS = 256;
+    static constexpr engine::UserId FIX_USER_ID = 1; // every FIX order; sessions tell clients apart
+    static constexpr uint32_t MAX_OPEN_ORDERS_PER_SESSION = 16384;
+    static constexpr uint32_t NO_ORDER_SLOT = UINT32_MAX;
+    
+    // Report fields that the engine does not carry, captured from the NewOrderSingle
+    struct OrderContext {
+        std::string clOrdId;
+        std::string symbol;
+        char side;
+        engine::Quantity orderQty;
+    };
+    
+    // A cancel/replace in flight, until the engine reports REPLACED or MODIFY_REJECTED
+    struct PendingReplace {
+        std::string clOrdId;
+        std::string origClOrdId;
+    };
+    
+    // One per session, addressed by the dense index stored on each order it enters.
+    // Every ring has one producer and one consumer: order slots are taken by the
+    // session thread and returned by the sender; events are pushed by the
+    // dispatcher and drained by the sender.
+    struct SessionSlot {
+        FIX::SessionID sessionID;
+        std::atomic<std::shared_ptr<NativeFixSession>> nativeSession;
+        bool native{false};
+        std::string counterparty; // native: the SenderCompID bound at logon
+        std::atomic<bool> active{false};
+        
+        std::vector<OrderContext> orders;
+        utils::LockFreeQueue<uint32_t, MAX_OPEN_ORDERS_PER_SESSION + 1> freeOrders;
+        uint32_t spareOrder{NO_ORDER_SLOT};
+        std::atomic<uint32_t> openOrders{0};
+        
+        utils::LockFreeQueue<engine::ExecutionEvent, 4096> outbound;
+        std::thread sender;
+        
+        // Where events go once outbound is full, in order after it, so the
+        // dispatcher never waits on one slow session. Set while spill is not empty.
+        std::deque<engine::ExecutionEvent> spill;
+        std::mutex spillMutex;
+        std::atomic<bool> spilling{false};
+        uint64_t spilledReports{0}; // under spillMutex, since the session last caught up
+        
+        // One per order at a time: added by the session thread, taken by the sender
+        std::unordered_map<engine::OrderId, PendingReplace> replaces;
+        std::mutex replacesMutex;
+    };
+    
+    // Index 0 means "not entered through FIX". Slots are created under
+    // sessionsMutex_ and never move, so the report path reads them without a lock.
+    std::array<std::unique_ptr<SessionSlot>, MAX_SESSIONS> sessions_;
+    uint32_t sessionCount_{1};
+    std::map<FIX::SessionID, uint32_t> quickfixSessions_;
+    std::unordered_map<std::string, uint32_t> nativeSlots_; // by counterparty, like quickfixSessions_
+    std::mutex sessionsMutex_;
+    std::thread executionReportThread_;
+    
+    FixAdapterOptions options_;
+    
+    // Native session layer: one acceptor thread plus one reader thread per
+    // connection. A connection has no slot until its Logon names the
+    // counterparty; a counterparty that logs on again is rebound to its slot, so
+    // reports of orders it left resting reach the new connection.
+    struct NativeBinding {
+        std::weak_ptr<NativeFixSession> session;
+        uint32_t sessionIndex{0}; // written at logon, then read by the reader thread only
+    };
+    struct NativeConnection {
+        std::shared_ptr<NativeFixSession> session;
+        std::shared_ptr<NativeBinding> binding;
+        std::thread thread;
+    };
+    int nativeListenSocket_{-1};
+    std::thread nativeAcceptorThread_;
+    std::vector<NativeConnection> nativeConnections_;
+    std::mutex nativeConnectionsMutex_;
+    
+    void startNative();
+    void stopNative();
+    void runNativeAcceptor();
+    void onNativeMessage(uint32_t sessionIndex, NativeFixSession& session, const FixMessageView& message);
+    bool bindNativeSession(NativeBinding& binding);
+    void unbindNativeSession(const NativeBinding& binding);
+    
+    // Returns a free slot index, reusing a disconnected native slot with no open
+    // orders (and dropping its counterparty binding) before creating a new one;
+    // 0 when the table is full. Caller holds sessionsMutex_.
+    uint32_t acquireSessionSlot(bool native);
+    uint32_t findQuickfixSession(const FIX::SessionID& sessionID);
+    
+    // Shared by the QuickFIX and native paths once the fields have been extracted.
+    // Queues the order and returns without waiting for matching; reports follow
+    // asynchronously on the session's sender thread.
+    void submitNewOrder(uint32_t sessionIndex, OrderContext context, char fixOrdType, double price,
+                        double stopPrice);
+    
+    // Likewise for a cancel/replace; returns the reason it was refused, empty if queued
+    std::string submitReplace(uint32_t sessionIndex, engine::OrderId orderId, PendingReplace replace,
+                              const std::string& symbol, engine::Quantity orderQty, double price);
+    
+    // Dispatcher: engine events -> per-session outbound rings, by the order's session index.
+    // A session that falls behind spills; the others are never held up by it.
+    void runExecutionReports();
+    void runSessionSender(SessionSlot& slot);
+    void deliverReport(SessionSlot& slot, const engine::ExecutionEvent& event);
+    void sendExecutionReport(const engine::ExecutionEvent& event, SessionSlot& slot,
+                             const OrderContext& context, std::string_view origClOrdId = {});
+    void sendOrderCancelReject(SessionSlot& slot, engine::OrderId orderId, std::string_view clOrdId,
+                               std::string_view origClOrdId, char ordStatus, char responseTo,
+                               std::string_view reason);
     
     // FIX message construction
     FIX42::NewOrderSingle createNewOrderSingle(const engine::Order& order);
@@ -61,6 +198,7 @@ private:
     char orderTypeToFix(engine::OrderType type);
     char orderSideToFix(engine::OrderSide side);
     char orderStatusToFix(engine::OrderStatus status);
+    char execTypeToFix(engine::ExecType type);
     
     void logFIXMessage(const std::string& direction, const FIX::Message& message);
 };
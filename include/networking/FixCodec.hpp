@@ -0,0 +1,301 @@
+// include/networking/FixCodec.hpp
+#pragma once
+
+#include "../engine/Types.hpp"
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace networking {
+
+enum class FixVersion {
+    FIX42,
+    FIX44
+};
+
+constexpr char FIX_SOH = '\x01';
+
+// Zero-allocation view over one complete tag=value message. Field values point
+// into the caller's buffer, which must outlive the view.
+class FixMessageView {
+public:
+    static constexpr size_t MAX_FIELDS = 128;
+    static constexpr uint32_t INDEXED_TAGS = 128;
+    
+    // Length of the first complete message in buffer, 0 if more bytes are needed,
+    // -1 if the buffer does not start with a valid BeginString/BodyLength header
+    static ptrdiff_t frameLength(std::string_view buffer);
+    
+    // Splits a complete frame into fields and verifies the checksum
+    bool parse(std::string_view message);
+    
+    std::string_view get(uint32_t tag) const;
+    bool has(uint32_t tag) const { return !get(tag).empty(); }
+    
+    int64_t getInt(uint32_t tag, int64_t defaultValue = 0) const;
+    double getDouble(uint32_t tag, double defaultValue = 0.0) const;
+    char getChar(uint32_t tag, char defaultValue = '\0') const;
+    
+    std::string_view getMsgType() const { return get(35); }
+    std::string_view getBeginString() const { return get(8); }
+    std::string_view raw() const { return message_; }
+    
+    // Visits every field in wire order, repeating groups included
+    template<typename Fn>
+    void forEachField(Fn&& fn) const {
+        for (size_t i = 0; i < fieldCount_; ++i) {
+            fn(fields_[i].tag, message_.substr(fields_[i].offset, fields_[i].length));
+        }
+    }
+    
+private:
+    struct Field {
+        uint32_t tag;
+        uint32_t offset;
+        uint32_t length;
+    };
+    
+    std::string_view message_;
+    std::array<Field, MAX_FIELDS> fields_;
+    std::array<uint8_t, INDEXED_TAGS> tagIndex_; // field position + 1 for common low tags
+    size_t fieldCount_{0};
+};
+
+// Builds an arbitrary message into a caller-owned buffer; BodyLength and CheckSum
+// are filled in by finish(). Used for session-level messages and rejects.
+class FixMessageBuilder {
+public:
+    FixMessageBuilder(char* buffer, size_t capacity, std::string_view beginString,
+                      std::string_view msgType);
+    
+    FixMessageBuilder& add(uint32_t tag, std::string_view value);
+    FixMessageBuilder& add(uint32_t tag, int64_t value);
+    FixMessageBuilder& add(uint32_t tag, char value);
+    
+    // Returns the finished message, or an empty view if the buffer overflowed
+    std::string_view finish();
+    
+private:
+    char* buffer_;
+    size_t capacity_;
+    size_t size_{0};
+    size_t bodyStart_{0};
+    bool overflow_{false};
+    
+    void append(std::string_view data);
+};
+
+// UTCTimestamp with milliseconds, "YYYYMMDD-HH:MM:SS.sss" (21 chars)
+void formatFixTimestamp(char* out, std::chrono::system_clock::time_point time);
+
+uint8_t fixChecksum(const char* data, size_t size);
+
+// Values patched into a prepared ExecutionReport for each fill, partial or cancel
+struct ExecutionReportFields {
+    uint64_t msgSeqNum;
+    uint64_t execId;
+    char execType;
+    char ordStatus;
+    engine::Quantity lastQty;
+    engine::Price lastPx;
+    engine::Quantity leavesQty;
+    engine::Quantity cumQty;
+    engine::Price avgPx;
+};
+
+// Pre-laid-out ExecutionReport. prepare() writes the header and per-order constant
+// fields once and reserves fixed-width slots for everything that changes between
+// reports, so BodyLength never changes and encode() only rewrites the slots and
+// the checksum.
+template<FixVersion Version>
+class ExecutionReportEncoder {
+public:
+    static constexpr size_t BUFFER_SIZE = 512;
+    
+    static constexpr std::string_view beginString() {
+        return Version == FixVersion::FIX42 ? "FIX.4.2" : "FIX.4.4";
+    }
+    
+    // FIX 4.2 reports fills as ExecType 1/2; 4.4 folds them into F (Trade)
+    static constexpr char fillExecType(bool fullyFilled) {
+        if constexpr (Version == FixVersion::FIX42) {
+            return fullyFilled ? '2' : '1';
+        } else {
+            return 'F';
+        }
+    }
+    
+    bool prepare(std::string_view senderCompId, std::string_view targetCompId,
+                 engine::OrderId orderId, std::string_view clOrdId, std::string_view symbol,
+                 char side, engine::Quantity orderQty) {
+        if (senderCompId.size() + targetCompId.size() + clOrdId.size() + symbol.size() > 256) {
+            return false;
+        }
+        
+        size_ = 0;
+        append("8=");
+        append(beginString());
+        append("\x01" "9=");
+        size_t bodyLengthPos = size_;
+        append("000\x01");
+        size_t bodyStart = size_;
+        
+        append("35=8\x01" "34=");
+        seqNumSlot_ = reserve(SEQNUM_WIDTH);
+        append("\x01" "49=");
+        append(senderCompId);
+        append("\x01" "52=");
+        sendingTimeSlot_ = reserve(TIMESTAMP_WIDTH);
+        append("\x01" "56=");
+        append(targetCompId);
+        
+        append("\x01" "37=");
+        appendInt(static_cast<int64_t>(orderId));
+        append("\x01" "11=");
+        append(clOrdId);
+        append("\x01" "17=");
+        execIdSlot_ = reserve(EXECID_WIDTH);
+        if constexpr (Version == FixVersion::FIX42) {
+            append("\x01" "20=0");
+        }
+        append("\x01" "150=");
+        execTypeSlot_ = reserve(1);
+        append("\x01" "39=");
+        ordStatusSlot_ = reserve(1);
+        append("\x01" "55=");
+        append(symbol);
+        append("\x01" "54=");
+        buffer_[size_++] = side;
+        append("\x01" "38=");
+        appendInt(orderQty);
+        append("\x01" "32=");
+        lastQtySlot_ = reserve(QTY_WIDTH);
+        append("\x01" "31=");
+        lastPxSlot_ = reserve(PRICE_WIDTH);
+        append("\x01" "151=");
+        leavesQtySlot_ = reserve(QTY_WIDTH);
+        append("\x01" "14=");
+        cumQtySlot_ = reserve(QTY_WIDTH);
+        append("\x01" "6=");
+        avgPxSlot_ = reserve(PRICE_WIDTH);
+        append("\x01" "60=");
+        transactTimeSlot_ = reserve(TIMESTAMP_WIDTH);
+        append("\x01");
+        
+        size_t bodyLength = size_ - bodyStart;
+        writeFixedInt(buffer_.data() + bodyLengthPos, 3, static_cast<int64_t>(bodyLength));
+        
+        // Slots are still zero-filled here; their bytes are added back on every encode
+        constantChecksum_ = 0;
+        for (size_t i = 0; i < size_; ++i) {
+            constantChecksum_ += static_cast<uint8_t>(buffer_[i]);
+        }
+        constantChecksum_ -= slotZeroSum();
+        
+        checksumPos_ = size_;
+        append("10=000\x01");
+        return true;
+    }
+    
+    std::string_view encode(const ExecutionReportFields& fields,
+                            std::chrono::system_clock::time_point now = std::chrono::system_clock::now()) {
+        writeFixedInt(slot(seqNumSlot_), SEQNUM_WIDTH, static_cast<int64_t>(fields.msgSeqNum));
+        formatFixTimestamp(slot(sendingTimeSlot_), now);
+        std::memcpy(slot(transactTimeSlot_), slot(sendingTimeSlot_), TIMESTAMP_WIDTH);
+        writeFixedInt(slot(execIdSlot_), EXECID_WIDTH, static_cast<int64_t>(fields.execId));
+        *slot(execTypeSlot_) = fields.execType;
+        *slot(ordStatusSlot_) = fields.ordStatus;
+        writeFixedInt(slot(lastQtySlot_), QTY_WIDTH, fields.lastQty);
+        writeFixedPrice(slot(lastPxSlot_), fields.lastPx);
+        writeFixedInt(slot(leavesQtySlot_), QTY_WIDTH, fields.leavesQty);
+        writeFixedInt(slot(cumQtySlot_), QTY_WIDTH, fields.cumQty);
+        writeFixedPrice(slot(avgPxSlot_), fields.avgPx);
+        
+        uint32_t sum = constantChecksum_;
+        for (const auto& [offset, width] : slots()) {
+            for (size_t i = 0; i < width; ++i) {
+                sum += static_cast<uint8_t>(buffer_[offset + i]);
+            }
+        }
+        writeFixedInt(buffer_.data() + checksumPos_ + 3, 3, sum % 256);
+        
+        return std::string_view(buffer_.data(), size_);
+    }
+    
+private:
+    // Leading zeros are legal in FIX int/float fields, which keeps every slot fixed width
+    static constexpr size_t SEQNUM_WIDTH = 9;
+    static constexpr size_t TIMESTAMP_WIDTH = 21;
+    static constexpr size_t EXECID_WIDTH = 16;
+    static constexpr size_t QTY_WIDTH = 12;
+    static constexpr size_t PRICE_WIDTH = 17; // 10 integer digits, '.', 6 decimals
+    static constexpr size_t SLOT_COUNT = 11;
+    
+    struct Slot {
+        size_t offset;
+        size_t width;
+    };
+    
+    std::array<char, BUFFER_SIZE> buffer_{};
+    size_t size_{0};
+    size_t checksumPos_{0};
+    uint32_t constantChecksum_{0};
+    
+    Slot seqNumSlot_{}, sendingTimeSlot_{}, execIdSlot_{}, execTypeSlot_{}, ordStatusSlot_{};
+    Slot lastQtySlot_{}, lastPxSlot_{}, leavesQtySlot_{}, cumQtySlot_{}, avgPxSlot_{};
+    Slot transactTimeSlot_{};
+    
+    std::array<Slot, SLOT_COUNT> slots() const {
+        return {seqNumSlot_, sendingTimeSlot_, execIdSlot_, execTypeSlot_, ordStatusSlot_,
+                lastQtySlot_, lastPxSlot_, leavesQtySlot_, cumQtySlot_, avgPxSlot_,
+                transactTimeSlot_};
+    }
+    
+    uint32_t slotZeroSum() const {
+        uint32_t sum = 0;
+        for (const auto& [offset, width] : slots()) {
+            sum += static_cast<uint32_t>(width) * static_cast<uint8_t>('0');
+        }
+        return sum;
+    }
+    
+    char* slot(const Slot& s) { return buffer_.data() + s.offset; }
+    
+    void append(std::string_view data) {
+        std::memcpy(buffer_.data() + size_, data.data(), data.size());
+        size_ += data.size();
+    }
+    
+    void appendInt(int64_t value) {
+        auto result = std::to_chars(buffer_.data() + size_, buffer_.data() + BUFFER_SIZE, value);
+        size_ = static_cast<size_t>(result.ptr - buffer_.data());
+    }
+    
+    Slot reserve(size_t width) {
+        Slot s{size_, width};
+        std::memset(buffer_.data() + size_, '0', width);
+        size_ += width;
+        return s;
+    }
+    
+    static void writeFixedInt(char* out, size_t width, int64_t value) {
+        uint64_t v = value < 0 ? 0 : static_cast<uint64_t>(value);
+        for (size_t i = width; i > 0; --i) {
+            out[i - 1] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        }
+    }
+    
+    static void writeFixedPrice(char* out, engine::Price price) {
+        constexpr int64_t SCALE = 1000000;
+        int64_t scaled = static_cast<int64_t>(price * SCALE + (price >= 0 ? 0.5 : -0.5));
+        writeFixedInt(out, PRICE_WIDTH - 7, scaled / SCALE);
+        out[PRICE_WIDTH - 7] = '.';
+        writeFixedInt(out + PRICE_WIDTH - 6, 6, scaled % SCALE);
+    }
+};
+
+} // namespace networking
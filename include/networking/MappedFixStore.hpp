@@ -0,0 +1,61 @@
+// include/networking/MappedFixStore.hpp
+#pragma once
+
+#include "../persistence/MappedMessageStore.hpp"
+#include "quickfix/MessageStore.h"
+#include "quickfix/SessionSettings.h"
+#include <string>
+
+namespace networking {
+
+// QuickFIX MessageStore over persistence::MappedMessageStore. Drop-in replacement
+// for FIX::FileStore: one preallocated mapped file per session instead of
+// buffered writes to a body file, a header file and two sequence files.
+class MappedFixStore : public FIX::MessageStore {
+public:
+    MappedFixStore(const std::string& path, uint32_t indexCapacity, size_t dataCapacity);
+    
+    bool set(int seqNum, const std::string& message) override;
+    void get(int beginSeqNum, int endSeqNum, std::vector<std::string>& messages) const override;
+    
+    int getNextSenderMsgSeqNum() const override;
+    int getNextTargetMsgSeqNum() const override;
+    void setNextSenderMsgSeqNum(int seqNum) override;
+    void setNextTargetMsgSeqNum(int seqNum) override;
+    void incrNextSenderMsgSeqNum() override;
+    void incrNextTargetMsgSeqNum() override;
+    
+    FIX::UtcTimeStamp getCreationTime() const override;
+    
+    void reset() override;
+    void refresh() override;
+    
+private:
+    persistence::MappedMessageStore store_;
+};
+
+// Store files live under FileStorePath (or the directory given here) as
+// <BeginString>-<SenderCompID>-<TargetCompID>.store
+class MappedFixStoreFactory : public FIX::MessageStoreFactory {
+public:
+    MappedFixStoreFactory(const FIX::SessionSettings& settings,
+                          uint32_t indexCapacity = persistence::MappedMessageStore::DEFAULT_INDEX_CAPACITY,
+                          size_t dataCapacity = persistence::MappedMessageStore::DEFAULT_DATA_CAPACITY);
+    MappedFixStoreFactory(const std::string& directory,
+                          uint32_t indexCapacity = persistence::MappedMessageStore::DEFAULT_INDEX_CAPACITY,
+                          size_t dataCapacity = persistence::MappedMessageStore::DEFAULT_DATA_CAPACITY);
+    
+    FIX::MessageStore* create(const FIX::SessionID& sessionID) override;
+    void destroy(FIX::MessageStore* store) override;
+    
+    static std::string storePath(const std::string& directory, const std::string& beginString,
+                                 const std::string& senderCompId, const std::string& targetCompId);
+    
+private:
+    const FIX::SessionSettings* settings_{nullptr};
+    std::string directory_;
+    uint32_t indexCapacity_;
+    size_t dataCapacity_;
+};
+
+} // namespace networking
\ No newline at end of file
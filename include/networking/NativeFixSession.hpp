@@ -0,0 +1,118 @@
+// include/networking/NativeFixSession.hpp
+#pragma once
+
+#include "FixCodec.hpp"
+#include "../persistence/MappedMessageStore.hpp"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace networking {
+
+// Minimal FIX 4.2/4.4 acceptor session over a connected socket. Handles Logon,
+// Heartbeat, TestRequest, ResendRequest and Logout itself and hands application
+// messages to the handler as parsed views into the receive buffer, strictly in
+// MsgSeqNum order: a gap is answered with a ResendRequest and nothing past it is
+// handed on until it is filled. Used instead of QuickFIX when fix.native_enabled is set.
+//
+// With a store directory, outbound messages and both sequence numbers persist in
+// a MappedMessageStore per counterparty, and resend requests are replayed from it;
+// without one, resend requests are answered with a gap fill.
+//
+// A logon handler sees each valid Logon, counterparty known, before it is
+// answered, so the owner can bind the session; false refuses it with a Logout.
+class NativeFixSession {
+public:
+    using MessageHandler = std::function<void(NativeFixSession& session, const FixMessageView& message)>;
+    using LogonHandler = std::function<bool(NativeFixSession& session)>;
+    
+    NativeFixSession(int socketFd, std::string senderCompId, MessageHandler handler,
+                     std::string storeDirectory = {}, LogonHandler logonHandler = {});
+    ~NativeFixSession();
+    
+    NativeFixSession(const NativeFixSession&) = delete;
+    NativeFixSession& operator=(const NativeFixSession&) = delete;
+    
+    // Reads and dispatches until the peer disconnects, logs out, or stop() is called
+    void run();
+    void stop();
+    
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    bool isLoggedOn() const { return loggedOn_.load(std::memory_order_acquire); }
+    FixVersion getVersion() const { return version_; }
+    const std::string& getTargetCompId() const { return targetCompId_; }
+    const std::string& getSenderCompId() const { return senderCompId_; }
+    
+    // Encodes through the session's prepared templates and sends with the next MsgSeqNum.
+    // A replace report (origClOrdId given) is built instead, since it changes the
+    // ClOrdID and OrderQty the order's template was prepared with.
+    bool sendExecutionReport(engine::OrderId orderId, std::string_view clOrdId, std::string_view symbol,
+                             char side, engine::Quantity orderQty, ExecutionReportFields fields,
+                             std::string_view origClOrdId = {});
+    
+    // Builds an arbitrary message; build() receives a builder with the standard header set
+    template<typename BuildFn>
+    bool sendMessage(std::string_view msgType, BuildFn&& build) {
+        std::lock_guard lock(sendMutex_);
+        std::array<char, 1024> buffer;
+        FixMessageBuilder builder(buffer.data(), buffer.size(), beginString(), msgType);
+        addHeader(builder);
+        build(builder);
+        return sendRaw(builder.finish());
+    }
+    
+private:
+    static constexpr size_t RECEIVE_BUFFER_SIZE = 64 * 1024;
+    
+    int socket_;
+    std::string senderCompId_;
+    std::string targetCompId_;
+    MessageHandler handler_;
+    std::string storeDirectory_;
+    LogonHandler logonHandler_;
+    std::unique_ptr<persistence::MappedMessageStore> store_;
+    FixVersion version_{FixVersion::FIX42};
+    
+    std::atomic<bool> running_{true};
+    std::atomic<bool> loggedOn_{false};
+    uint64_t nextIncomingSeqNum_{1};
+    uint64_t nextOutgoingSeqNum_{1};
+    uint64_t resendRequestedTo_{0}; // a ResendRequest is outstanding while nextIncomingSeqNum_ <= this
+    
+    std::array<char, RECEIVE_BUFFER_SIZE> receiveBuffer_;
+    size_t receivedBytes_{0};
+    
+    // Guards the outbound sequence number, the socket write side and the templates
+    std::mutex sendMutex_;
+    ExecutionReportEncoder<FixVersion::FIX42> fix42Encoder_;
+    ExecutionReportEncoder<FixVersion::FIX44> fix44Encoder_;
+    engine::OrderId preparedOrderId_{0};
+    
+    std::string_view beginString() const;
+    void addHeader(FixMessageBuilder& builder);
+    // Persists (when a store is open) and sends under the next MsgSeqNum
+    bool sendRaw(std::string_view message);
+    // The same report through a builder, for orders whose identifiers do not fit a template
+    bool sendBuiltExecutionReport(engine::OrderId orderId, std::string_view clOrdId, std::string_view symbol,
+                                  char side, engine::Quantity orderQty, const ExecutionReportFields& fields,
+                                  std::string_view origClOrdId = {});
+    bool writeSocket(std::string_view message);
+    
+    void setNextIncomingSeqNum(uint64_t seqNum);
+    void resend(uint64_t beginSeqNum, uint64_t endSeqNum);
+    void sendGapFill(uint64_t seqNum, uint64_t newSeqNum);
+    
+    void processMessage(const FixMessageView& message);
+    void onLogon(const FixMessageView& message, uint64_t seqNum);
+    
+    // True when seqNum is the next expected. A lower one is dropped if PossDupFlag
+    // is set and logs the session out if not; a higher one requests a resend.
+    bool acceptSeqNum(const FixMessageView& message, uint64_t seqNum);
+    void requestResend(uint64_t receivedSeqNum);
+    void logout(const std::string& text);
+};
+
+} // namespace networking
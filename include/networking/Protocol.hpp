@@ -2,6 +2,7 @@
 #pragma once
 
 #include "../engine/Types.hpp"
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -15,6 +16,7 @@ struct OrderRequest {
     engine::Price price;
     engine::Quantity quantity;
     std::string clientOrderId;
+    std::string apiKey; // an api.keys key; the order is its user's
 };
 
 // Order response
@@ -24,6 +26,7 @@ struct OrderResponse {
     std::string message;
     engine::Quantity filledQuantity;
     engine::Price averagePrice;
+    std::string clientOrderId;
 };
 
 // Trade notification
@@ -54,16 +57,61 @@ struct MarketDataSnapshot {
     engine::Quantity totalVolume;
 };
 
+// Indicative uncross of an instrument in a call auction
+struct AuctionIndicative {
+    std::string symbol;
+    std::chrono::system_clock::time_point timestamp;
+    engine::Price indicativePrice;
+    engine::Quantity indicativeVolume;  // 0 while the book does not cross
+    engine::Quantity surplus;
+    engine::OrderSide surplusSide;
+};
+
+// One price level of an instrument changed by a modify: the level's displayed
+// state now (0 quantity once it is gone) and, when the order moved price, that
+// of the level it left (previousPrice 0 otherwise)
+struct DepthUpdate {
+    std::string symbol;
+    std::chrono::system_clock::time_point timestamp;
+    engine::OrderSide side;
+    engine::Price price;
+    engine::Quantity quantity;
+    uint32_t orderCount;
+    engine::Price previousPrice;
+    engine::Quantity previousQuantity;
+    uint32_t previousOrderCount;
+};
+
+// A market maker's quote refresh: each entry replaces its instrument's two-sided
+// quote, 0 quantity pulling that side
+struct MassQuote {
+    struct Entry {
+        std::string symbol;
+        engine::Price bidPrice;
+        engine::Quantity bidQuantity;
+        engine::Price askPrice;
+        engine::Quantity askQuantity;
+    };
+    
+    std::string apiKey;
+    std::vector<Entry> entries;
+};
+
 // Protocol message types
 enum class MessageType {
     ORDER_REQUEST = 1,
     ORDER_RESPONSE = 2,
     TRADE_NOTIFICATION = 3,
     MARKET_DATA_SNAPSHOT = 4,
-    HEARTBEAT = 5
+    HEARTBEAT = 5,
+    AUCTION_INDICATIVE = 6,
+    MASS_QUOTE = 7,
+    DEPTH_UPDATE = 8
 };
 
-// Serialization functions (to be implemented)
+// Text encoding: '|'-separated fields, the MessageType first. Only the last
+// field of a message may contain '|'. Deserializers throw std::invalid_argument
+// on a malformed message or one of another type.
 std::string serializeOrderRequest(const OrderRequest& request);
 OrderRequest deserializeOrderRequest(const std::string& data);
 
@@ -73,4 +121,16 @@ OrderResponse deserializeOrderResponse(const std::string& data);
 std::string serializeTradeNotification(const TradeNotification& notification);
 TradeNotification deserializeTradeNotification(const std::string& data);
 
+std::string serializeMarketDataSnapshot(const MarketDataSnapshot& snapshot);
+MarketDataSnapshot deserializeMarketDataSnapshot(const std::string& data);
+
+std::string serializeAuctionIndicative(const AuctionIndicative& indicative);
+AuctionIndicative deserializeAuctionIndicative(const std::string& data);
+
+std::string serializeMassQuote(const MassQuote& quote);
+MassQuote deserializeMassQuote(const std::string& data);
+
+std::string serializeDepthUpdate(const DepthUpdate& update);
+DepthUpdate deserializeDepthUpdate(const std::string& data);
+
 } // namespace networking
\ No newline at end of file
@@ -0,0 +1,95 @@
+// include/networking/ShmTransport.hpp
+#pragma once
+
+#include "../utils/LockFreeQueue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace networking {
+
+// Fixed-size frame carried through shared memory. Messages that do not fit are rejected.
+struct ShmFrame {
+    static constexpr size_t MAX_TOPIC_SIZE = 32;
+    static constexpr size_t MAX_DATA_SIZE = 472;
+    
+    uint16_t topicSize;
+    uint16_t dataSize;
+    char topic[MAX_TOPIC_SIZE];
+    char data[MAX_DATA_SIZE];
+};
+
+using ShmRing = utils::LockFreeQueue<ShmFrame, 4096>;
+
+static_assert(std::is_trivially_copyable_v<ShmFrame>);
+static_assert(std::atomic<size_t>::is_always_lock_free && std::atomic<bool>::is_always_lock_free,
+              "ring indices must be address-free to live in shared memory");
+
+// Same-host transport for co-located strategies: two SPSC rings in a POSIX shared
+// memory segment, one per direction. The engine side creates the segment, clients
+// attach to it by name. Each direction must have exactly one producer thread.
+class ShmTransport {
+public:
+    enum class Role {
+        ENGINE,  // creates the segment; receives order entry, sends market data/acks
+        CLIENT   // attaches to an existing segment; the reverse direction
+    };
+    
+    using MessageCallback = std::function<void(std::string_view topic, std::string_view message)>;
+    
+    ShmTransport(const std::string& name, Role role);
+    ~ShmTransport();
+    
+    ShmTransport(const ShmTransport&) = delete;
+    ShmTransport& operator=(const ShmTransport&) = delete;
+    
+    // Runs callback on an internal polling thread
+    void start(MessageCallback callback);
+    void stop();
+    
+    bool publish(std::string_view topic, std::string_view message);
+    
+    // Drains up to maxMessages inbound frames on the caller's thread, for clients
+    // that spin on their own core instead of using start()
+    template<typename Handler>
+    size_t poll(Handler&& handler, size_t maxMessages = 1024) {
+        size_t processed = 0;
+        while (processed < maxMessages && inbound_->popWith([&](const ShmFrame& frame) {
+                handler(std::string_view(frame.topic, frame.topicSize),
+                        std::string_view(frame.data, frame.dataSize));
+            })) {
+            ++processed;
+        }
+        return processed;
+    }
+    
+    const std::string& getName() const { return name_; }
+    
+private:
+    struct Segment {
+        std::atomic<uint64_t> magic;
+        ShmRing toEngine;
+        ShmRing fromEngine;
+    };
+    
+    static constexpr uint64_t SEGMENT_MAGIC = 0x4f4d45534d454d31ULL; // "OMESMEM1"
+    
+    std::string name_;
+    Role role_;
+    int fd_{-1};
+    Segment* segment_{nullptr};
+    ShmRing* inbound_{nullptr};
+    ShmRing* outbound_{nullptr};
+    
+    std::atomic<bool> running_{false};
+    std::thread pollThread_;
+    MessageCallback callback_;
+    
+    void runPoller();
+};
+
+} // namespace networking
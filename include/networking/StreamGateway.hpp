@@ -0,0 +1,95 @@
+// include/networking/StreamGateway.hpp
+#pragma once
+
+#include "../engine/MatchingEngine.hpp"
+#include "Protocol.hpp"
+#include "ShmTransport.hpp"
+#include "ZmqInterface.hpp"
+#include "../utils/ApiKeys.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace networking {
+
+// Order entry and market data over the stream transports. OrderRequests arrive on
+// the transports' receive threads and are only decoded and queued on the engine
+// there; one publisher thread then sends every ack, fill, cancel and reject as an
+// OrderResponse on "acks.<userId>" of the transport the order came in on, and every
+// top-of-book change as a MarketDataSnapshot on "<symbol>.book" of both, every
+// level a modify changes as a DepthUpdate on "<symbol>.depth", and every
+// indicative uncross change as an AuctionIndicative on "<symbol>.auction". That
+// thread is the only producer on either transport. MassQuotes (topic "quotes")
+// refresh a registered market maker's quotes; their sides report on the same
+// acks topic, labelled "<symbol>.bid" / "<symbol>.ask". A request acts for the user
+// of its api key; one without a known key, or undecodable, is answered on
+// "rejects" and never reaches the engine.
+class StreamGateway {
+public:
+    enum class Transport {
+        ZMQ,
+        SHM
+    };
+    
+    // shm may be null when shared memory is disabled
+    StreamGateway(std::shared_ptr<engine::MatchingEngine> engine, ZmqInterface& zmq, ShmTransport* shm,
+                  std::shared_ptr<const utils::ApiKeys> apiKeys);
+    ~StreamGateway();
+    
+    void start();
+    void stop();
+    
+    // Any receive thread
+    void onOrderRequest(Transport transport, std::string_view payload);
+    void onMassQuote(Transport transport, std::string_view payload);
+    
+private:
+    std::shared_ptr<engine::MatchingEngine> engine_;
+    ZmqInterface& zmq_;
+    ShmTransport* shm_;
+    std::shared_ptr<const utils::ApiKeys> apiKeys_;
+    
+    std::atomic<bool> running_{false};
+    std::thread publisherThread_;
+    
+    // Engine events carry only the order id; the client's id is kept here until
+    // the order is done. Responses decided on a receive thread (undecodable or
+    // refused requests) wait in pending_, with their topic, for the publisher.
+    // Quote sides re-enter under new ids the engine picks, so they carry a
+    // session order slot instead: one per label, index + 1 into quoteLabels_.
+    struct PendingResponse {
+        Transport transport;
+        std::string topic;
+        OrderResponse response;
+    };
+    
+    std::unordered_map<engine::OrderId, std::string> clientOrderIds_;
+    std::unordered_map<std::string, uint32_t> quoteSlots_;
+    std::vector<std::string> quoteLabels_;
+    std::vector<PendingResponse> pending_;
+    std::atomic<bool> hasPending_{false};
+    std::mutex mutex_;
+    
+    void runPublisher();
+    void publishExecution(const engine::ExecutionEvent& event);
+    void publishTopOfBook(const engine::TopOfBook& top);
+    void publishIndicative(const engine::IndicativeUpdate& update);
+    void publishDepth(const engine::DepthUpdate& update);
+    void publishMarketData(const std::string& topic, const std::string& message);
+    void publishPending();
+    void send(Transport transport, const std::string& topic, const std::string& message);
+    void respond(Transport transport, std::string topic, OrderResponse response);
+    uint32_t quoteSlot(std::string label);
+    
+    static std::string ackTopic(engine::UserId userId);
+    
+    static engine::OrderStatus toOrderStatus(const engine::ExecutionEvent& event);
+};
+
+} // namespace networking
\ No newline at end of file
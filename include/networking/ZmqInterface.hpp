@@ -3,22 +3,42 @@
 
 #include <zmq.hpp>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
-#include <shared_mutex>
+#include <vector>
 #include "../utils/LockFreeQueue.hpp"
 
 namespace networking {
 
+struct ZmqOptions {
+    size_t dispatchWorkers{0};   // 0 = run callbacks on the subscriber thread
+    size_t maxDrainBatch{1024};  // messages drained per poll wakeup
+    
+    int ioThreads{1};            // libzmq background I/O threads
+    size_t publisherShards{1};   // PUB sockets, each with its own queue and thread
+    
+    // Explicit endpoint per shard. When empty, endpoints are derived from the
+    // base publish endpoint (tcp port + shard index, ipc/inproc name + "-<index>").
+    std::vector<std::string> publishEndpoints;
+    
+    // Instrument -> shard pinning; unlisted instruments are spread by hash
+    std::unordered_map<std::string, size_t> instrumentGroups;
+};
+
 class ZmqInterface {
 public:
-    using MessageCallback = std::function<void(const std::string& topic, const std::string& message)>;
+    // Views point into the received frames and are only valid for the duration of the call
+    using MessageCallback = std::function<void(std::string_view topic, std::string_view message)>;
     
     ZmqInterface(const std::string& publishEndpoint, 
                  const std::string& subscribeEndpoint,
-                 size_t queueSize = 100000);
+                 size_t queueSize = 100000,
+                 const ZmqOptions& options = {});
     ~ZmqInterface();
     
     void start();
@@ -33,24 +53,82 @@ public:
     // High-throughput batch publishing
     bool publishBatch(const std::vector<std::pair<std::string, std::string>>& messages);
     
+    // inproc:// endpoints are only reachable through the context that bound them,
+    // so in-process strategies create their sockets from this one
+    zmq::context_t& getContext() { return context_; }
+    
 private:
+    struct Subscription {
+        uint64_t topicHash;
+        std::string topic;
+        MessageCallback callback;
+    };
+    
+    // Immutable once published, sorted by topicHash. Writers copy, modify and republish.
+    using SubscriptionTable = std::vector<Subscription>;
+    
+    // Reader-side cache of the published table, reloaded only when the version moves
+    struct SubscriptionSnapshot {
+        std::shared_ptr<const SubscriptionTable> table;
+        uint64_t version{0};
+    };
+    
+    struct InboundMessage {
+        uint64_t topicHash{0};
+        zmq::message_t topic;
+        zmq::message_t data;
+    };
+    
+    struct DispatchWorker {
+        utils::LockFreeQueue<InboundMessage, 16384> queue;
+        std::thread thread;
+    };
+    
+    struct PublisherShard {
+        PublisherShard(zmq::context_t& context, std::string shardEndpoint)
+            : socket(context, ZMQ_PUB), endpoint(std::move(shardEndpoint)) {}
+        
+        zmq::socket_t socket;
+        std::string endpoint;
+        utils::LockFreeQueue<std::pair<std::string, std::string>, 100000> queue;
+        std::thread thread;
+    };
+    
     zmq::context_t context_;
-    zmq::socket_t publisher_;
     zmq::socket_t subscriber_;
     
     std::string publishEndpoint_;
     std::string subscribeEndpoint_;
+    ZmqOptions options_;
+    
+    std::vector<std::unique_ptr<PublisherShard>> publishers_;
+    
+    std::atomic<std::shared_ptr<const SubscriptionTable>> subscriptions_;
+    std::atomic<uint64_t> subscriptionsVersion_{1};
+    std::mutex subscriptionsWriteMutex_;
     
-    utils::LockFreeQueue<std::pair<std::string, std::string>, 100000> publishQueue_;
-    std::unordered_map<std::string, MessageCallback> subscriptions_;
-    mutable std::shared_mutex subscriptionsMutex_;
+    std::vector<std::unique_ptr<DispatchWorker>> dispatchWorkers_;
     
     std::atomic<bool> running_{false};
-    std::thread publisherThread_;
     std::thread subscriberThread_;
     
-    void runPublisher();
+    void runPublisher(PublisherShard& shard);
     void runSubscriber();
+    void runDispatchWorker(DispatchWorker& worker);
+    
+    void dispatch(SubscriptionSnapshot& snapshot, uint64_t topicHash,
+                  const zmq::message_t& topic, const zmq::message_t& data) const;
+    void refreshSnapshot(SubscriptionSnapshot& snapshot) const;
+    void publishSubscriptions(std::shared_ptr<const SubscriptionTable> table);
+    
+    size_t shardFor(std::string_view topic) const;
+    std::string shardEndpoint(size_t shardIndex) const;
+    
+    // Applies transport-specific socket options and prepares ipc:// paths before bind
+    static void bindSocket(zmq::socket_t& socket, const std::string& endpoint);
+    
+    static const Subscription* findSubscription(const SubscriptionTable& table,
+                                                uint64_t topicHash, std::string_view topic);
     
     // Zero-copy message building
     zmq::message_t buildMessage(const std::string& topic, const std::string& data) const;
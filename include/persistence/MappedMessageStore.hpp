@@ -0,0 +1,91 @@
+// include/persistence/MappedMessageStore.hpp
+#pragma once
+
+#include "MappedSegment.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace persistence {
+
+// Outbound FIX message store for session recovery, kept in one preallocated
+// mapped file:
+//
+//   [Header][IndexEntry x indexCapacity][data ring, dataCapacity bytes]
+//
+// set() copies the message into the data ring and records its position in the
+// index slot seqNum % indexCapacity, so storing is a memcpy and get() returns a
+// view straight into the mapping. Messages older than one ring's worth of bytes
+// (or one index's worth of sequence numbers) are overwritten and read back as
+// missing, which the session layer answers with a gap fill.
+//
+// Not thread-safe: the owning session serializes access.
+class MappedMessageStore {
+public:
+    static constexpr uint32_t DEFAULT_INDEX_CAPACITY = 1u << 18;
+    static constexpr size_t DEFAULT_DATA_CAPACITY = 64ull << 20;
+    
+    explicit MappedMessageStore(const std::string& path,
+                                uint32_t indexCapacity = DEFAULT_INDEX_CAPACITY,
+                                size_t dataCapacity = DEFAULT_DATA_CAPACITY);
+    
+    bool set(uint64_t seqNum, std::string_view message);
+    
+    // Empty if the message was never stored or has been overwritten
+    std::string_view get(uint64_t seqNum) const;
+    
+    template<typename Fn>
+    void forEach(uint64_t beginSeqNum, uint64_t endSeqNum, Fn&& fn) const {
+        for (uint64_t seqNum = beginSeqNum; seqNum <= endSeqNum; ++seqNum) {
+            fn(seqNum, get(seqNum));
+        }
+    }
+    
+    uint64_t getNextSenderMsgSeqNum() const { return header_->nextSenderSeqNum; }
+    uint64_t getNextTargetMsgSeqNum() const { return header_->nextTargetSeqNum; }
+    void setNextSenderMsgSeqNum(uint64_t seqNum) { header_->nextSenderSeqNum = seqNum; }
+    void setNextTargetMsgSeqNum(uint64_t seqNum) { header_->nextTargetSeqNum = seqNum; }
+    void incrNextSenderMsgSeqNum() { ++header_->nextSenderSeqNum; }
+    void incrNextTargetMsgSeqNum() { ++header_->nextTargetSeqNum; }
+    
+    std::chrono::system_clock::time_point getCreationTime() const;
+    
+    // Starts a new session: forgets all messages and resets both sequence numbers to 1
+    void reset();
+    
+    void sync(bool blocking = false) { segment_.sync(blocking); }
+    
+private:
+    static constexpr uint64_t STORE_MAGIC = 0x4F4D45464958534Dull; // "OMEFIXSM"
+    static constexpr uint32_t STORE_VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 64;
+    
+    struct Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t indexCapacity;
+        uint64_t dataCapacity;
+        uint64_t nextSenderSeqNum;
+        uint64_t nextTargetSeqNum;
+        int64_t creationTimeNs;
+        uint64_t dataTail; // logical write position, only ever grows
+    };
+    static_assert(sizeof(Header) <= HEADER_SIZE);
+    
+    struct IndexEntry {
+        uint64_t seqNum;
+        uint64_t position; // logical position in the data ring
+        uint32_t length;
+        uint32_t reserved;
+    };
+    
+    MappedSegment segment_;
+    Header* header_;
+    IndexEntry* index_;
+    char* data_;
+    uint32_t indexCapacity_;
+    uint64_t dataCapacity_;
+};
+
+} // namespace persistence
\ No newline at end of file
@@ -0,0 +1,38 @@
+// include/persistence/MappedSegment.hpp
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace persistence {
+
+// A file of fixed size, preallocated on disk and mapped shared into memory.
+// Writes are plain stores into the mapping; the kernel writes pages back, and
+// sync() forces it when durability matters.
+class MappedSegment {
+public:
+    MappedSegment(const std::string& path, size_t size);
+    ~MappedSegment();
+    
+    MappedSegment(const MappedSegment&) = delete;
+    MappedSegment& operator=(const MappedSegment&) = delete;
+    
+    char* data() { return data_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    const std::string& path() const { return path_; }
+    
+    // True if the file did not exist (or was empty) and is therefore zero-filled
+    bool isNew() const { return isNew_; }
+    
+    void sync(bool blocking = false);
+    
+private:
+    std::string path_;
+    size_t size_;
+    int fd_{-1};
+    char* data_{nullptr};
+    bool isNew_{false};
+};
+
+} // namespace persistence
\ No newline at end of file
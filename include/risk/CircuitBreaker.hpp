@@ -2,27 +2,38 @@
 #pragma once
 
 #include "../engine/Types.hpp"
+#include "../utils/Config.hpp"
+#include "StreamingStats.hpp"
 #include <unordered_map>
 #include <string>
 #include <chrono>
 #include <atomic>
-#include <deque>
+#include <memory>
+#include <mutex>
 
 namespace risk {
 
+// Per-instrument windows are fixed time-sliced counters, so a check is a few
+// arithmetic ops and never allocates or locks. Each instrument's checks must
+// come from one thread at a time (its book's lock holder); the halt state is
+// atomic and readable from anywhere. A trip halts the symbol for
+// risk.circuit_breaker.halt_seconds, after which it trades again with its first
+// print as the new price reference. Symbols are registered before trading
+// starts (engine.symbols); checks on an unregistered symbol pass.
 class CircuitBreaker {
 public:
     CircuitBreaker(const utils::Config& config);
     
+    void registerSymbol(const std::string& symbol);
+    
     // Price movement checks
     bool checkPriceMove(const std::string& symbol, double newPrice);
-    bool checkVolatility(const std::string& symbol, double currentVolatility);
     
     // Volume checks
     bool checkVolumeSpike(const std::string& symbol, int64_t volume);
     
-    // Order rate checks
-    bool checkOrderRate(const std::string& symbol, int ordersPerSecond);
+    // Order rate checks: counts one order per call over the last second
+    bool checkOrderRate(const std::string& symbol);
     
     // Market-wide controls
     void triggerMarketWideHalt(const std::string& reason);
@@ -34,36 +45,30 @@ public:
     void resumeSymbol(const std::string& symbol);
     bool isSymbolHalted(const std::string& symbol) const;
     
-    // Statistics
-    struct MarketStats {
-        double priceChangePercent{0.0};
-        double volatility{0.0};
-        int64_t volume{0};
-        int orderRate{0};
-        std::chrono::system_clock::time_point lastUpdate;
-    };
-    
-    MarketStats getMarketStats(const std::string& symbol) const;
-    
 private:
-    struct SymbolData {
-        std::deque<double> priceHistory;
-        std::deque<int64_t> volumeHistory;
-        std::deque<std::chrono::system_clock::time_point> orderTimestamps;
+    struct alignas(64) SymbolData {
+        // Written by the instrument's checking thread only
         double referencePrice{0.0};
-        bool halted{false};
-        std::string haltReason;
+        SlicedCounter volume; // traded volume per slice over the volume window
+        SlicedCounter orders; // orders per slice over the last second
+        
+        std::atomic<bool> halted{false};
+        std::atomic<int64_t> resumeAtNs{0};        // steady clock; the halt lifts itself then
+        std::atomic<bool> rebaseReference{false};  // set by a halt, cleared by the next print after it
+        std::string haltReason; // under haltMutex_
         std::chrono::system_clock::time_point haltTime;
         
         // Limits
         double maxPriceMovePercent{0.10}; // 10%
-        double maxVolatility{0.50}; // 50%
         int64_t maxVolumeSpike{1000000}; // 1M shares
         int maxOrderRate{1000}; // 1000 orders/second
     };
     
-    std::unordered_map<std::string, SymbolData> symbolData_;
-    mutable std::shared_mutex dataMutex_;
+    size_t maxSymbols_;
+    int64_t haltDurationNs_;
+    std::unique_ptr<SymbolData[]> symbolData_;
+    std::unordered_map<std::string, size_t> symbolIndex_; // fixed once trading starts
+    mutable std::mutex haltMutex_; // halt reasons and times; halts are rare
     
     std::atomic<bool> marketWideHalt_{false};
     std::string marketHaltReason_;
@@ -71,11 +76,12 @@ private:
     
     utils::Config config_;
     
+    SymbolData* findSymbol(const std::string& symbol) const;
+    static bool isHalted(const SymbolData& data);
+    
     // Calculation methods
-    double calculatePriceChange(const std::string& symbol, double newPrice);
-    double calculateVolatility(const std::string& symbol);
-    int64_t calculateVolumeSpike(const std::string& symbol, int64_t currentVolume);
-    int calculateOrderRate(const std::string& symbol);
+    double calculatePriceChange(const SymbolData& data, double newPrice) const;
+    int64_t calculateVolumeSpike(const SymbolData& data) const;
     
     // Configuration
     void loadConfiguration();
@@ -2,14 +2,24 @@
 #pragma once
 
 #include "../engine/Types.hpp"
+#include "../engine/Events.hpp"
 #include "../utils/Config.hpp"
+#include "../utils/LockFreeQueue.hpp"
+#include "StreamingStats.hpp"
 #include <unordered_map>
-#include <shared_mutex>
 #include <atomic>
+#include <chrono>
 #include <limits>
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace risk {
 
+// Dense per-engine instrument index, assigned by registerInstrument
+using InstrumentId = uint32_t;
+constexpr InstrumentId INVALID_INSTRUMENT = std::numeric_limits<InstrumentId>::max();
+
 struct RiskCheckResult {
     bool approved;
     std::string reason;
@@ -34,13 +44,77 @@ struct RiskLimits {
     double maxDrawdown{0.10}; // 10%
 };
 
+// Per instrument: print-to-print return statistics and the sampled history VaR replays
+struct ReturnStatistics {
+    uint64_t ticks{0};
+    double meanReturn{0.0};
+    double volatility{0.0}; // stdev of tick returns since start
+    double ewmaVolatility{0.0}; // recent tick returns weighted by decay
+    size_t varSamples{0};
+};
+
+// Per-user state lives in flat arrays indexed by user id and split into shards
+// (userId % shardCount). Each engine lane owns one shard, so the hot path never
+// locks; fields are relaxed atomics only so admin reads and setters stay safe.
+//
+// Positions keep net quantity and cost basis; unrealised PnL is net * mark - cost.
+// Post-trade updates are applied only by the shard owning the user, so every
+// position and mark has a single writer. By default equity is marked eagerly: a
+// print walks only the shard's holders of that instrument and adds net * delta.
+// With risk.lazy_mark_to_market equity is recomputed when checked or read.
+//
+// Approved orders reserve their quantity and notional until the book's execution
+// events release it: a fill converts reserved exposure into position, a cancel
+// or expiry frees it. Checks count open exposure as well as filled position.
+//
+// Return statistics are streaming (Welford and EWMA, O(1) per print). VaR is
+// historical simulation over a fixed window of returns sampled for every
+// instrument at once, so scenario t is the same moment across a portfolio.
 class RiskEngine {
 public:
     RiskEngine(const utils::Config& config);
     
-    RiskCheckResult checkOrder(const engine::Order& order);
-    void recordTrade(const engine::Trade& trade);
-    void updateMarketPrice(const std::string& symbol, double price);
+    // Register every tradeable symbol before orders flow; the table is read
+    // without locking afterwards. Returns the existing id for a known symbol.
+    InstrumentId registerInstrument(const std::string& symbol);
+    InstrumentId findInstrument(const std::string& symbol) const;
+    
+    size_t shardCount() const { return shards_.size(); }
+    size_t shardOf(engine::UserId userId) const { return userId % shards_.size(); }
+    
+    // Callers outside the matching lanes pass this as the producer shard
+    static constexpr size_t NO_SHARD = std::numeric_limits<size_t>::max();
+    
+    // All pre-trade checks in one pass over the user's record; if approved, the
+    // order's exposure is reserved and its price recorded on the order. Call from
+    // the lane that owns shardOf(order.getUserId()).
+    RiskCheckResult checkOrder(engine::Order& order);
+    
+    // A bulk submission from one user, checked against one snapshot of that user's
+    // limits and open exposure: either every order is approved and the aggregate
+    // reserved, or none is. Same lane rule as checkOrder.
+    RiskCheckResult checkOrders(std::span<const engine::OrderPtr> orders);
+    
+    // A cancel/replace of a resting order: any added quantity or notional is
+    // checked against the same limits as checkOrder, and if approved the
+    // reservation moves to the new remaining quantity and price. Call under the
+    // book lock, before the book applies it, from the same lane as checkOrder.
+    RiskCheckResult checkModify(engine::Order& order, int64_t newQuantity, double newPrice);
+    
+    // Post-trade, for the trades of one order; call from the producing lane under
+    // the book lock so an instrument's prints arrive in order. Sides owned by
+    // producerShard apply at once, the rest go through an SPSC ring per
+    // (producer, owner) pair.
+    void recordTrades(std::span<const engine::Trade> trades, size_t producerShard);
+    
+    // Owner lane: apply the fills and marks other lanes queued for this shard
+    void applyPostTradeUpdates(size_t shard);
+    
+    // Release reservations for the fills and cancels among one book's events.
+    // Fills are released by the owning shard after their position lands (call
+    // after recordTrades); cancels are released at once with atomic fetch_sub.
+    void releaseExposure(const std::string& symbol, std::span<const engine::ExecutionEvent> events,
+                         size_t producerShard);
     
     Position getPosition(engine::UserId userId, const std::string& symbol) const;
     std::unordered_map<std::string, Position> getAllPositions(engine::UserId userId) const;
@@ -51,41 +125,114 @@ public:
     void setMaxOrderSize(engine::UserId userId, int64_t size);
     
     void resetDailyCounters();
+    
+    // Take one return sample per instrument from the last prints if
+    // risk.var_sample_interval_ms has passed since the previous one. Single caller.
+    bool sampleReturns(std::chrono::steady_clock::time_point now);
+    ReturnStatistics getReturnStatistics(const std::string& symbol) const;
+    
+    // Historical-simulation VaR of the user's current positions over the sampled window
     double calculateVar(engine::UserId userId, double confidenceLevel = 0.95) const;
     
 private:
-    struct UserRiskData {
-        std::unordered_map<std::string, Position> positions;
-        RiskLimits limits;
-        int64_t dailyVolume{0};
-        double dailyNotional{0.0};
-        double startingEquity{1000000.0};
-        double currentEquity{1000000.0};
-        mutable std::shared_mutex mutex;
+    // Limits and daily counters packed into one cache line per user. currentEquity
+    // includes unrealised PnL when marking eagerly, realised PnL only when lazy.
+    struct alignas(64) UserRiskState {
+        std::atomic<int64_t> maxOrderSize{0};
+        std::atomic<int64_t> dailyVolumeLimit{0};
+        std::atomic<double> maxNotional{0.0};
+        std::atomic<double> maxDrawdown{0.0};
+        std::atomic<int64_t> dailyVolume{0};
+        std::atomic<double> dailyNotional{0.0};
+        std::atomic<double> startingEquity{1000000.0};
+        std::atomic<double> currentEquity{1000000.0};
+        std::atomic<double> openNotional{0.0}; // reserved by open orders
+    };
+    
+    // One per (user, instrument); a user's row is contiguous
+    struct PositionState {
+        std::atomic<int64_t> netPosition{0};
+        std::atomic<int64_t> maxPosition{0};
+        std::atomic<int64_t> buyQuantity{0};
+        std::atomic<int64_t> sellQuantity{0};
+        std::atomic<double> costBasis{0.0}; // signed cost of the open position
+        std::atomic<double> realizedPnl{0.0};
+        std::atomic<int64_t> openBuyQuantity{0}; // reserved by open orders
+        std::atomic<int64_t> openSellQuantity{0};
+        bool listed{false}; // in the shard's holders index for this instrument
+    };
+    
+    struct RiskShard {
+        size_t userCount{0};
+        std::unique_ptr<UserRiskState[]> users;
+        std::unique_ptr<PositionState[]> positions; // userCount x maxInstruments_
+        std::vector<std::vector<uint32_t>> holders; // per instrument: local indexes that ever held it
+        std::unique_ptr<double[]> marks; // this shard's mark per instrument
+        std::unique_ptr<engine::TradeId[]> markSequence; // trade id of that mark
+    };
+    
+    static constexpr size_t VAR_WINDOW = 256;
+    
+    // Tick fields are written by recordTrades under the instrument's book lock and
+    // published through the atomics; the sampled ring has the sampler as its writer
+    struct InstrumentStats {
+        WelfordStats tickReturns;
+        EwmaStats recentTickReturns;
+        double lastPrint{0.0};
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<double> meanReturn{0.0};
+        std::atomic<double> variance{0.0};
+        std::atomic<double> ewmaVariance{0.0};
         
-        std::vector<double> portfolioReturns; // For VaR calculation
+        SampleRing<VAR_WINDOW> sampledReturns;
+        double lastSampledPrice{0.0};
     };
     
-    std::unordered_map<engine::UserId, UserRiskData> userRiskData_;
-    std::unordered_map<std::string, double> marketPrices_;
-    mutable std::shared_mutex riskDataMutex_;
-    mutable std::shared_mutex pricesMutex_;
+    struct PostTradeUpdate {
+        enum class Kind : uint8_t { FILL, MARK, RELEASE };
+        
+        Kind kind{Kind::FILL};
+        engine::UserId userId{0};
+        InstrumentId instrument{0};
+        int64_t quantity{0}; // signed: buys positive
+        double price{0.0};
+        engine::TradeId sequence{0};
+    };
+    
+    using PostTradeRing = utils::LockFreeQueue<PostTradeUpdate, 4096>;
+    
+    std::vector<RiskShard> shards_;
+    std::vector<std::unique_ptr<PostTradeRing>> postTradeRings_; // [producer * shards + owner]
+    size_t maxUsers_;
+    size_t maxInstruments_;
+    RiskLimits defaultLimits_;
+    bool lazyMarkToMarket_;
+    
+    std::unordered_map<std::string, InstrumentId> instrumentIds_;
+    std::vector<std::string> instrumentSymbols_;
+    std::unique_ptr<std::atomic<double>[]> marketPrices_; // last print, for readers and market orders
+    
+    std::unique_ptr<InstrumentStats[]> instrumentStats_;
+    std::chrono::steady_clock::duration varSampleInterval_;
+    std::chrono::steady_clock::time_point nextVarSample_{};
+    std::atomic<uint64_t> varSamples_{0}; // every instrument's ring holds this many
     
     utils::Config config_;
     
-    RiskCheckResult checkPositionLimit(engine::UserId userId, const std::string& symbol, 
-                                      engine::OrderSide side, int64_t quantity);
-    RiskCheckResult checkNotionalLimit(engine::UserId userId, double notionalValue);
-    RiskCheckResult checkDailyVolumeLimit(engine::UserId userId, int64_t volume);
-    RiskCheckResult checkOrderSizeLimit(engine::UserId userId, int64_t orderSize);
-    RiskCheckResult checkDrawdownLimit(engine::UserId userId);
-    RiskCheckResult checkPriceDeviation(const std::string& symbol, engine::Price price);
+    UserRiskState* findUser(engine::UserId userId) const;
+    UserRiskState& userState(engine::UserId userId) const;
+    PositionState& positionState(engine::UserId userId, InstrumentId instrument) const;
+    double reservationPrice(const engine::Order& order, InstrumentId instrument) const;
     
-    void updatePosition(engine::UserId userId, const std::string& symbol, 
-                       engine::OrderSide side, int64_t quantity, double price);
-    void updateEquity(engine::UserId userId, const std::string& symbol, double newPrice);
+    void postUpdate(size_t producerShard, size_t ownerShard, const PostTradeUpdate& update);
+    void applyUpdate(RiskShard& shard, const PostTradeUpdate& update);
+    void updatePosition(RiskShard& shard, engine::UserId userId, InstrumentId instrument,
+                       int64_t signedQuantity, double price);
+    void updateMark(RiskShard& shard, InstrumentId instrument, double price, engine::TradeId sequence);
+    void release(engine::UserId userId, InstrumentId instrument, int64_t signedQuantity, double price);
     
-    double calculatePortfolioVaR(const UserRiskData& userData, double confidenceLevel) const;
+    double markedEquity(engine::UserId userId, const UserRiskState& user) const;
+    void updateReturnStatistics(InstrumentId instrument, std::span<const engine::Trade> trades);
 };
 
 } // namespace risk
\ No newline at end of file
@@ -0,0 +1,172 @@
+// include/risk/StreamingStats.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+namespace risk {
+
+// Welford's online mean and variance: O(1) per sample, numerically stable,
+// no history kept
+class WelfordStats {
+public:
+    void add(double sample) {
+        ++count_;
+        double delta = sample - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (sample - mean_);
+    }
+    
+    void reset() {
+        count_ = 0;
+        mean_ = 0.0;
+        m2_ = 0.0;
+    }
+    
+    uint64_t count() const { return count_; }
+    double mean() const { return mean_; }
+    double variance() const { return count_ > 1 ? m2_ / static_cast<double>(count_ - 1) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+    
+private:
+    uint64_t count_{0};
+    double mean_{0.0};
+    double m2_{0.0};
+};
+
+// Exponentially weighted mean and variance (RiskMetrics style): recent samples
+// dominate, older ones decay by lambda per sample
+class EwmaStats {
+public:
+    explicit EwmaStats(double lambda = 0.94) : lambda_(lambda) {}
+    
+    void add(double sample) {
+        if (count_++ == 0) {
+            mean_ = sample;
+            return;
+        }
+        double delta = sample - mean_;
+        mean_ += (1.0 - lambda_) * delta;
+        variance_ = lambda_ * (variance_ + (1.0 - lambda_) * delta * delta);
+    }
+    
+    void reset() {
+        count_ = 0;
+        mean_ = 0.0;
+        variance_ = 0.0;
+    }
+    
+    uint64_t count() const { return count_; }
+    double mean() const { return mean_; }
+    double variance() const { return variance_; }
+    double stddev() const { return std::sqrt(variance_); }
+    
+private:
+    double lambda_;
+    uint64_t count_{0};
+    double mean_{0.0};
+    double variance_{0.0};
+};
+
+// The latest N samples by absolute sample number. Single writer; readers copy
+// out with copyRange while pushes continue (a copied range may then include
+// one sample newer than the rest, which is fine for risk estimates).
+template<size_t N>
+class SampleRing {
+public:
+    static constexpr size_t CAPACITY = N;
+    
+    void push(double sample) {
+        uint64_t count = count_.load(std::memory_order_relaxed);
+        samples_[count % N].store(sample, std::memory_order_relaxed);
+        count_.store(count + 1, std::memory_order_release);
+    }
+    
+    uint64_t count() const { return count_.load(std::memory_order_acquire); }
+    size_t size() const { return static_cast<size_t>(std::min<uint64_t>(count(), N)); }
+    
+    // Samples [end - n, end) oldest first; n must not exceed min(end, N)
+    void copyRange(uint64_t end, size_t n, double* out) const {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = samples_[(end - n + i) % N].load(std::memory_order_relaxed);
+        }
+    }
+    
+private:
+    std::array<std::atomic<double>, N> samples_{};
+    std::atomic<uint64_t> count_{0};
+};
+
+// Amounts summed in fixed time slices over a sliding window of up to
+// MAX_SLICES slices. add and the totals are O(1) amortised and never allocate;
+// expired slices are cleared as time advances. Single writer.
+class SlicedCounter {
+public:
+    static constexpr size_t MAX_SLICES = 64;
+    
+    void configure(int64_t sliceNs, size_t slices) {
+        sliceNs_ = std::max<int64_t>(1, sliceNs);
+        slices_ = std::clamp<size_t>(slices, 1, MAX_SLICES);
+        counts_.fill(0);
+        lastSlice_ = -1;
+        total_ = 0;
+    }
+    
+    void add(int64_t nowNs, int64_t amount) {
+        advance(nowNs / sliceNs_);
+        counts_[static_cast<size_t>(lastSlice_) % slices_] += amount;
+        total_ += amount;
+    }
+    
+    // Over the whole window / the slice being filled, as of the last add
+    int64_t total() const { return total_; }
+    int64_t current() const { return lastSlice_ < 0 ? 0 : counts_[static_cast<size_t>(lastSlice_) % slices_]; }
+    size_t slices() const { return slices_; }
+    
+private:
+    void advance(int64_t slice) {
+        if (lastSlice_ < 0 || slice - lastSlice_ >= static_cast<int64_t>(slices_)) {
+            counts_.fill(0);
+            total_ = 0;
+        } else {
+            for (int64_t next = lastSlice_ + 1; next <= slice; ++next) {
+                auto& expired = counts_[static_cast<size_t>(next) % slices_];
+                total_ -= expired;
+                expired = 0;
+            }
+        }
+        lastSlice_ = std::max(lastSlice_, slice);
+    }
+    
+    std::array<int64_t, MAX_SLICES> counts_{};
+    int64_t sliceNs_{1000000000};
+    size_t slices_{1};
+    int64_t lastSlice_{-1};
+    int64_t total_{0};
+};
+
+// y += a * x over n doubles
+inline void axpy(double a, const double* x, double* y, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+    const __m256d scale = _mm256_set1_pd(a);
+    for (; i + 4 <= n; i += 4) {
+        __m256d acc = _mm256_loadu_pd(y + i);
+        acc = _mm256_fmadd_pd(scale, _mm256_loadu_pd(x + i), acc);
+        _mm256_storeu_pd(y + i, acc);
+    }
+#endif
+    for (; i < n; ++i) {
+        y[i] += a * x[i];
+    }
+}
+
+} // namespace risk
\ No newline at end of file
@@ -0,0 +1,29 @@
+// include/utils/ApiKeys.hpp
+#pragma once
+
+#include "../engine/Types.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace utils {
+
+// Client credentials for the REST and stream entry points: the "key:userId"
+// entries of api.keys. A request acts for the user its key maps to, whatever
+// user it names itself.
+class ApiKeys {
+public:
+    // Malformed entries are skipped with an error logged
+    explicit ApiKeys(const std::vector<std::string>& entries);
+    
+    std::optional<engine::UserId> userOf(std::string_view key) const;
+    
+    size_t size() const { return users_.size(); }
+    
+private:
+    std::unordered_map<std::string, engine::UserId> users_;
+};
+
+} // namespace utils
\ No newline at end of file
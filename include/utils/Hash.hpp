@@ -0,0 +1,24 @@
+// include/utils/Hash.hpp
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace utils {
+
+// 64-bit FNV-1a. constexpr so well-known topics can be hashed at compile time.
+constexpr uint64_t fnv1a(const char* data, size_t size) noexcept {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+constexpr uint64_t fnv1a(std::string_view data) noexcept {
+    return fnv1a(data.data(), data.size());
+}
+
+} // namespace utils
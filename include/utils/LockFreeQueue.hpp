@@ -68,6 +68,45 @@ public:
         return std::nullopt;
     }
     
+    // In-place variants: the callable writes/reads the slot directly, avoiding a
+    // temporary T. Used for large trivially-copyable frames (e.g. in shared memory).
+    template<typename Writer>
+    bool pushWith(Writer&& writer) {
+        size_t current_tail = tail_.load(std::memory_order_relaxed);
+        size_t next_tail = (current_tail + 1) % Capacity;
+        
+        if (next_tail == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        
+        if (!buffer_[current_tail].occupied.load(std::memory_order_acquire)) {
+            writer(buffer_[current_tail].data);
+            buffer_[current_tail].occupied.store(true, std::memory_order_release);
+            tail_.store(next_tail, std::memory_order_release);
+            return true;
+        }
+        
+        return false;
+    }
+    
+    template<typename Reader>
+    bool popWith(Reader&& reader) {
+        size_t current_head = head_.load(std::memory_order_relaxed);
+        
+        if (current_head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        
+        if (buffer_[current_head].occupied.load(std::memory_order_acquire)) {
+            reader(static_cast<const T&>(buffer_[current_head].data));
+            buffer_[current_head].occupied.store(false, std::memory_order_release);
+            head_.store((current_head + 1) % Capacity, std::memory_order_release);
+            return true;
+        }
+        
+        return false;
+    }
+    
     bool empty() const {
         return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
     }
@@ -0,0 +1,187 @@
+// include/utils/TimerWheel.hpp
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace utils {
+
+// Hierarchical timing wheel over integer ticks: LEVELS wheels of SLOTS slots,
+// each level's slot spanning a whole turn of the level below. schedule and
+// cancel are O(1); advance fires due timers in deadline-tick order, cascading a
+// higher slot down as the level below wraps. Nodes come from a pool that only
+// grows, addressed by index, and timers are handed out as index + generation so
+// a stale handle cannot cancel a reused node. Single threaded: the owner
+// schedules, cancels and advances from one thread, and callbacks may do the same.
+template<typename Payload, size_t LEVELS = 5, size_t SLOT_BITS = 6>
+class TimerWheel {
+public:
+    using TimerId = uint64_t;
+    static constexpr TimerId INVALID_TIMER = 0;
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+    
+    explicit TimerWheel(int64_t startTick = 0, size_t initialCapacity = 1024) : currentTick_(startTick) {
+        nodes_.reserve(initialCapacity);
+        heads_.fill(NIL);
+    }
+    
+    // Fires on the first advance reaching deadlineTick; past deadlines fire on the next tick
+    TimerId schedule(int64_t deadlineTick, Payload payload) {
+        uint32_t index = allocate();
+        auto& node = nodes_[index];
+        node.deadline = deadlineTick;
+        node.payload = std::move(payload);
+        link(index, currentTick_ + 1);
+        ++size_;
+        return (static_cast<TimerId>(node.generation) << 32) | (index + 1);
+    }
+    
+    // False if the timer already fired or was cancelled
+    bool cancel(TimerId id) {
+        if (id == INVALID_TIMER) {
+            return false;
+        }
+        uint32_t index = static_cast<uint32_t>(id & 0xffffffffu) - 1;
+        if (index >= nodes_.size()) {
+            return false;
+        }
+        auto& node = nodes_[index];
+        if (node.slot == NIL || node.generation != static_cast<uint32_t>(id >> 32)) {
+            return false;
+        }
+        unlink(index);
+        release(index);
+        --size_;
+        return true;
+    }
+    
+    // Fires every timer due up to and including nowTick, calling fire(payload)
+    template<typename Fire>
+    void advance(int64_t nowTick, Fire&& fire) {
+        while (currentTick_ < nowTick) {
+            if (size_ == 0) {
+                // Nothing can fire on the way: skip the empty ticks
+                currentTick_ = nowTick;
+                return;
+            }
+            
+            const int64_t tick = ++currentTick_;
+            cascade(tick);
+            
+            // One at a time from the head, so a callback may cancel the rest of the slot
+            const size_t slot = static_cast<size_t>(tick) & (SLOTS - 1);
+            while (heads_[slot] != NIL) {
+                uint32_t index = heads_[slot];
+                unlink(index);
+                Payload payload = std::move(nodes_[index].payload);
+                release(index);
+                --size_;
+                fire(payload);
+            }
+        }
+    }
+    
+    int64_t currentTick() const { return currentTick_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+private:
+    static constexpr uint32_t NIL = std::numeric_limits<uint32_t>::max();
+    static constexpr int64_t RANGE = int64_t{1} << (SLOT_BITS * LEVELS);
+    
+    struct Node {
+        int64_t deadline{0};
+        Payload payload{};
+        uint32_t prev{NIL};
+        uint32_t next{NIL}; // also the free list link
+        uint32_t slot{NIL}; // index into heads_, NIL when free
+        uint32_t generation{0};
+    };
+    
+    std::vector<Node> nodes_;
+    std::array<uint32_t, LEVELS * SLOTS> heads_;
+    uint32_t freeList_{NIL};
+    size_t size_{0};
+    int64_t currentTick_;
+    
+    uint32_t allocate() {
+        if (freeList_ != NIL) {
+            uint32_t index = freeList_;
+            freeList_ = nodes_[index].next;
+            return index;
+        }
+        nodes_.emplace_back();
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+    
+    void release(uint32_t index) {
+        auto& node = nodes_[index];
+        node.payload = Payload{};
+        node.slot = NIL;
+        ++node.generation;
+        node.next = freeList_;
+        freeList_ = index;
+    }
+    
+    // Into the slot for the node's deadline, or for earliest if that is later
+    void link(uint32_t index, int64_t earliest) {
+        auto& node = nodes_[index];
+        
+        // Beyond the top level's turn: park in its furthest slot and re-place on cascade
+        int64_t deadline = std::max(node.deadline, earliest);
+        int64_t delta = std::min(deadline - currentTick_, RANGE - 1);
+        deadline = currentTick_ + delta;
+        
+        size_t level = 0;
+        while (level + 1 < LEVELS && delta >= (int64_t{1} << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+        size_t slot = level * SLOTS + (static_cast<size_t>(deadline >> (SLOT_BITS * level)) & (SLOTS - 1));
+        
+        node.slot = static_cast<uint32_t>(slot);
+        node.prev = NIL;
+        node.next = heads_[slot];
+        if (node.next != NIL) {
+            nodes_[node.next].prev = index;
+        }
+        heads_[slot] = index;
+    }
+    
+    void unlink(uint32_t index) {
+        auto& node = nodes_[index];
+        if (node.prev != NIL) {
+            nodes_[node.prev].next = node.next;
+        } else {
+            heads_[node.slot] = node.next;
+        }
+        if (node.next != NIL) {
+            nodes_[node.next].prev = node.prev;
+        }
+        node.prev = NIL;
+        node.next = NIL;
+    }
+    
+    // As each level wraps, the next level's slot for this tick comes due: its
+    // timers are re-placed against the new tick, landing one level down or lower
+    // (those due on this very tick in the level 0 slot about to fire)
+    void cascade(int64_t tick) {
+        for (size_t level = 1; level < LEVELS; ++level) {
+            if ((tick & ((int64_t{1} << (SLOT_BITS * level)) - 1)) != 0) {
+                break;
+            }
+            size_t slot = level * SLOTS + (static_cast<size_t>(tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+            uint32_t index = heads_[slot];
+            heads_[slot] = NIL;
+            while (index != NIL) {
+                uint32_t next = nodes_[index].next;
+                link(index, tick);
+                index = next;
+            }
+        }
+    }
+};
+
+} // namespace utils
\ No newline at end of file
@@ -3,17 +3,37 @@
 #include "../utils/Logger.hpp"
 #include <cpprest/http_listener.h>
 #include <cpprest/json.h>
+#include <chrono>
 
 namespace api {
 
+namespace {
+
+// How long a bulk request waits for its lane before giving up on the outcomes
+constexpr auto BATCH_TIMEOUT = std::chrono::seconds(5);
+
+utility::string_t statusName(engine::OrderStatus status) {
+    switch (status) {
+        case engine::OrderStatus::FILLED: return U("filled");
+        case engine::OrderStatus::PARTIAL: return U("partial");
+        case engine::OrderStatus::CANCELLED: return U("cancelled");
+        case engine::OrderStatus::REJECTED: return U("rejected");
+        default: return U("accepted");
+    }
+}
+
+} // namespace
+
 RestApi::RestApi(const std::string& address, 
                  std::shared_ptr<engine::MatchingEngine> engine,
                  std::shared_ptr<monitoring::Metrics> metrics,
-                 std::shared_ptr<risk::RiskEngine> riskEngine)
+                 std::shared_ptr<risk::RiskEngine> riskEngine,
+                 std::shared_ptr<const utils::ApiKeys> apiKeys)
     : listener_(address)
     , engine_(engine)
     , metrics_(metrics)
     , riskEngine_(riskEngine)
+    , apiKeys_(apiKeys)
 {
     // Setup request handlers
     listener_.support(methods::GET, std::bind(&RestApi::handleGet, this, std::placeholders::_1));
@@ -69,6 +89,8 @@ void RestApi::handleGet(const http_request& request) {
             handleOrderBook(request);
         } else if (path == "/positions") {
             handlePositions(request);
+        } else if (path == "/risk/var") {
+            handleValueAtRisk(request);
         } else if (path == "/system/status") {
             handleSystemStatus(request);
         } else if (path == "/config") {
@@ -88,6 +110,10 @@ void RestApi::handlePost(const http_request& request) {
     try {
         if (path == "/orders") {
             handleSubmitOrder(request);
+        } else if (path == "/orders/bulk") {
+            handleSubmitBulkOrders(request);
+        } else if (path == "/orders/parent") {
+            handleSubmitParentOrder(request);
         } else {
             sendErrorResponse(request, status_codes::NotFound, "Endpoint not found");
         }
@@ -97,6 +123,21 @@ void RestApi::handlePost(const http_request& request) {
     }
 }
 
+void RestApi::handleDelete(const http_request& request) {
+    auto path = request.relative_uri().path();
+    
+    try {
+        if (path.find("/orders/parent/") == 0) {
+            handleCancelParentOrder(request);
+        } else {
+            sendErrorResponse(request, status_codes::NotFound, "Endpoint not found");
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error handling DELETE request: {}", e.what());
+        sendErrorResponse(request, status_codes::InternalError, "Internal server error");
+    }
+}
+
 void RestApi::handleHealth(const http_request& request) {
     json::value response;
     response[U("status")] = json::value::string(U("healthy"));
@@ -166,41 +207,60 @@ void RestApi::handleOrderBook(const http_request& request) {
     request.reply(status_codes::OK, response);
 }
 
+void RestApi::handleValueAtRisk(const http_request& request) {
+    auto userId = authenticate(request);
+    if (!userId) {
+        return;
+    }
+    
+    auto query = uri::split_query(request.relative_uri().query());
+    double confidence = 0.95;
+    if (query.find(U("confidence")) != query.end()) {
+        confidence = std::stod(query[U("confidence")]);
+    }
+    if (!(confidence > 0.0 && confidence < 1.0)) {
+        sendErrorResponse(request, status_codes::BadRequest, "Confidence must be between 0 and 1");
+        return;
+    }
+    
+    // The caller's historical-simulation VaR, with the return statistics of each
+    // instrument it holds so the figure can be read against its sample window
+    json::value response;
+    response[U("confidence")] = json::value::number(confidence);
+    response[U("var")] = json::value::number(riskEngine_->calculateVar(*userId, confidence));
+    
+    json::value instruments = json::value::array();
+    size_t index = 0;
+    for (const auto& [symbol, position] : riskEngine_->getAllPositions(*userId)) {
+        if (position.netPosition == 0) {
+            continue;
+        }
+        auto stats = riskEngine_->getReturnStatistics(symbol);
+        json::value instrument;
+        instrument[U("symbol")] = json::value::string(utility::conversions::to_string_t(symbol));
+        instrument[U("net_position")] = json::value::number(position.netPosition);
+        instrument[U("ticks")] = json::value::number(stats.ticks);
+        instrument[U("mean_return")] = json::value::number(stats.meanReturn);
+        instrument[U("volatility")] = json::value::number(stats.volatility);
+        instrument[U("ewma_volatility")] = json::value::number(stats.ewmaVolatility);
+        instrument[U("var_samples")] = json::value::number(static_cast<uint64_t>(stats.varSamples));
+        instruments[index++] = instrument;
+    }
+    response[U("instruments")] = instruments;
+    
+    request.reply(status_codes::OK, response);
+}
+
 void RestApi::handleSubmitOrder(const http_request& request) {
+    auto userId = authenticate(request);
+    if (!userId) {
+        return;
+    }
+    
     request.extract_json()
-        .then([this, request](json::value body) {
+        .then([this, request, userId](json::value body) {
             try {
-                // Parse order from JSON
-                auto typeStr = body[U("type")].as_string();
-                auto sideStr = body[U("side")].as_string();
-                auto symbol = body[U("symbol")].as_string();
-                auto price = body[U("price")].as_double();
-                auto quantity = body[U("quantity")].as_number().to_int64();
-                
-                // Convert string to enum
-                engine::OrderType type;
-                if (typeStr == U("limit")) type = engine::OrderType::LIMIT;
-                else if (typeStr == U("market")) type = engine::OrderType::MARKET;
-                else if (typeStr == U("fok")) type = engine::OrderType::FOK;
-                else if (typeStr == U("ioc")) type = engine::OrderType::IOC;
-                else throw std::runtime_error("Invalid order type");
-                
-                engine::OrderSide side;
-                if (sideStr == U("buy")) side = engine::OrderSide::BUY;
-                else if (sideStr == U("sell")) side = engine::OrderSide::SELL;
-                else throw std::runtime_error("Invalid order side");
-                
-                // Create and submit order
-                auto order = std::make_shared<engine::Order>(
-                    engine_->generateOrderId(),
-                    1, // User ID from authentication
-                    utility::conversions::to_utf8string(symbol),
-                    type,
-                    side,
-                    price,
-                    quantity
-                );
-                
+                auto order = orderFromJson(body, *userId);
                 auto response = engine_->submitOrder(order);
                 
                 // Build JSON response
@@ -228,6 +288,210 @@ void RestApi::handleSubmitOrder(const http_request& request) {
         .wait();
 }
 
+void RestApi::handleSubmitBulkOrders(const http_request& request) {
+    auto userId = authenticate(request);
+    if (!userId) {
+        return;
+    }
+    
+    request.extract_json()
+        .then([this, request, userId](json::value body) {
+            try {
+                // {"orders": [...]}: all for the authenticated user, risk checked as one batch
+                auto& entries = body[U("orders")].as_array();
+                if (entries.size() == 0) {
+                    throw std::runtime_error("No orders");
+                }
+                
+                std::vector<engine::OrderPtr> orders;
+                orders.reserve(entries.size());
+                for (auto& entry : entries) {
+                    orders.push_back(orderFromJson(entry, *userId));
+                }
+                
+                auto processed = engine_->enqueueOrders(std::move(orders));
+                if (!processed.valid()) {
+                    sendErrorResponse(request, status_codes::ServiceUnavailable, "Engine queue full");
+                    return;
+                }
+                if (processed.wait_for(BATCH_TIMEOUT) != std::future_status::ready) {
+                    sendErrorResponse(request, status_codes::GatewayTimeout, "Batch queued but not yet processed");
+                    return;
+                }
+                
+                // Each order as its batch left the lane: a rejected batch rejects them all
+                json::value results = json::value::array();
+                for (const auto& outcome : processed.get()) {
+                    json::value result;
+                    result[U("order_id")] = json::value::number(outcome.orderId);
+                    result[U("status")] = json::value::string(statusName(outcome.status));
+                    result[U("filled_quantity")] = json::value::number(outcome.filledQuantity);
+                    result[U("average_price")] = json::value::number(outcome.averagePrice);
+                    results[results.size()] = result;
+                }
+                
+                json::value jsonResponse;
+                jsonResponse[U("orders")] = results;
+                request.reply(status_codes::OK, jsonResponse);
+                
+            } catch (const std::exception& e) {
+                LOG_ERROR("Error submitting bulk orders: {}", e.what());
+                sendErrorResponse(request, status_codes::BadRequest, 
+                                std::string("Invalid orders: ") + e.what());
+            }
+        })
+        .wait();
+}
+
+void RestApi::handleSubmitParentOrder(const http_request& request) {
+    auto userId = authenticate(request);
+    if (!userId) {
+        return;
+    }
+    
+    request.extract_json()
+        .then([this, request, userId](json::value body) {
+            try {
+                // A limit or market order plus "strategy": "twap" with "slices", or
+                // "vwap" with a "volume_profile" of slice weights, over "duration_ms"
+                auto parent = orderFromJson(body, *userId);
+                if (parent->getType() != engine::OrderType::LIMIT && parent->getType() != engine::OrderType::MARKET) {
+                    throw std::runtime_error("Parent orders are limit or market");
+                }
+                auto duration = std::chrono::milliseconds(body[U("duration_ms")].as_number().to_int64());
+                auto strategy = body[U("strategy")].as_string();
+                
+                engine::ParentOrderManager::Schedule schedule;
+                if (strategy == U("twap")) {
+                    schedule = engine::ParentOrderManager::Schedule::twap(
+                        duration, static_cast<size_t>(body[U("slices")].as_number().to_int64()));
+                } else if (strategy == U("vwap")) {
+                    std::vector<double> profile;
+                    for (const auto& weight : body[U("volume_profile")].as_array()) {
+                        profile.push_back(weight.as_double());
+                    }
+                    schedule = engine::ParentOrderManager::Schedule::vwap(duration, std::move(profile));
+                } else {
+                    throw std::runtime_error("Invalid strategy");
+                }
+                
+                auto parentId = parent->getId();
+                if (!engine_->enqueueParentOrder(std::move(parent), std::move(schedule))) {
+                    sendErrorResponse(request, status_codes::ServiceUnavailable, "Engine queue full");
+                    return;
+                }
+                
+                // Worked over the schedule; cancel with DELETE /orders/parent/{parent_id}
+                json::value jsonResponse;
+                jsonResponse[U("parent_id")] = json::value::number(parentId);
+                jsonResponse[U("status")] = json::value::string(U("accepted"));
+                request.reply(status_codes::Accepted, jsonResponse);
+                
+            } catch (const std::exception& e) {
+                LOG_ERROR("Error submitting parent order: {}", e.what());
+                sendErrorResponse(request, status_codes::BadRequest,
+                                std::string("Invalid parent order: ") + e.what());
+            }
+        })
+        .wait();
+}
+
+void RestApi::handleCancelParentOrder(const http_request& request) {
+    auto userId = authenticate(request);
+    if (!userId) {
+        return;
+    }
+    
+    auto path = request.relative_uri().path();
+    engine::OrderId parentId = 0;
+    try {
+        parentId = std::stoull(path.substr(std::string("/orders/parent/").length()));
+    } catch (const std::exception&) {
+        sendErrorResponse(request, status_codes::BadRequest, "Invalid parent order id");
+        return;
+    }
+    
+    // Only the owner's cancel takes effect; the parent reports CANCELLED for what it did not fill
+    if (!engine_->cancelParentOrder(parentId, *userId)) {
+        sendErrorResponse(request, status_codes::ServiceUnavailable, "Engine queue full");
+        return;
+    }
+    
+    json::value jsonResponse;
+    jsonResponse[U("parent_id")] = json::value::number(parentId);
+    jsonResponse[U("status")] = json::value::string(U("cancel_requested"));
+    request.reply(status_codes::Accepted, jsonResponse);
+}
+
+std::optional<engine::UserId> RestApi::authenticate(const http_request& request) {
+    std::optional<engine::UserId> userId;
+    auto key = request.headers().find(U("X-Api-Key"));
+    if (key != request.headers().end()) {
+        userId = apiKeys_->userOf(utility::conversions::to_utf8string(key->second));
+    }
+    if (!userId) {
+        sendErrorResponse(request, status_codes::Unauthorized, "Missing or unknown API key");
+    }
+    return userId;
+}
+
+engine::OrderPtr RestApi::orderFromJson(json::value& body, engine::UserId userId) {
+    auto typeStr = body[U("type")].as_string();
+    auto sideStr = body[U("side")].as_string();
+    auto symbol = body[U("symbol")].as_string();
+    auto price = body[U("price")].as_double();
+    auto quantity = body[U("quantity")].as_number().to_int64();
+    
+    // Convert string to enum
+    engine::OrderType type;
+    if (typeStr == U("limit")) type = engine::OrderType::LIMIT;
+    else if (typeStr == U("market")) type = engine::OrderType::MARKET;
+    else if (typeStr == U("fok")) type = engine::OrderType::FOK;
+    else if (typeStr == U("ioc")) type = engine::OrderType::IOC;
+    else if (typeStr == U("stop")) type = engine::OrderType::STOP;
+    else if (typeStr == U("stop_limit")) type = engine::OrderType::STOP_LIMIT;
+    else if (typeStr == U("iceberg")) type = engine::OrderType::ICEBERG;
+    else throw std::runtime_error("Invalid order type");
+    
+    engine::OrderSide side;
+    if (sideStr == U("buy")) side = engine::OrderSide::BUY;
+    else if (sideStr == U("sell")) side = engine::OrderSide::SELL;
+    else throw std::runtime_error("Invalid order side");
+    
+    auto order = std::make_shared<engine::Order>(
+        engine_->generateOrderId(),
+        userId,
+        utility::conversions::to_utf8string(symbol),
+        type,
+        side,
+        price,
+        quantity
+    );
+    
+    if (type == engine::OrderType::STOP || type == engine::OrderType::STOP_LIMIT) {
+        order->setStopPrice(body[U("stop_price")].as_double());
+    }
+    if (type == engine::OrderType::ICEBERG && body.has_field(U("peak_size"))) {
+        order->setPeakSize(body[U("peak_size")].as_number().to_int64());
+    }
+    
+    // Optional; GTD takes expire_time in milliseconds since the epoch
+    if (body.has_field(U("time_in_force"))) {
+        auto tifStr = body[U("time_in_force")].as_string();
+        if (tifStr == U("gtc")) {
+            order->setTimeInForce(engine::TimeInForce::GTC);
+        } else if (tifStr == U("day")) {
+            order->setTimeInForce(engine::TimeInForce::DAY);
+        } else if (tifStr == U("gtd")) {
+            order->setTimeInForce(engine::TimeInForce::GTD, std::chrono::milliseconds(
+                body[U("expire_time")].as_number().to_int64()));
+        } else {
+            throw std::runtime_error("Invalid time in force");
+        }
+    }
+    return order;
+}
+
 void RestApi::sendErrorResponse(const http_request& request, status_code code, const std::string& message) {
     json::value response;
     response[U("error")] = json::value::string(utility::conversions::to_string_t(message));
@@ -5,6 +5,8 @@
 #include "../networking/Protocol.hpp"
 #include <thread>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <numeric>
 
 namespace engine {
@@ -15,6 +17,13 @@ MatchingEngine::MatchingEngine(const utils::Config& config)
 {
     // Initialize risk engine
     riskEngine_ = std::make_unique<risk::RiskEngine>(config_);
+    if (config_.get<bool>("risk.circuit_breaker_enabled", true)) {
+        circuitBreaker_ = std::make_unique<risk::CircuitBreaker>(config_);
+    }
+    for (size_t i = 0; i < riskEngine_->shardCount(); ++i) {
+        lanes_.push_back(std::make_unique<MatchingLane>());
+        lanes_.back()->shard = i;
+    }
     
     // Initialize persistence
     std::string redisHost = config.get<std::string>("persistence.redis_host", "localhost");
@@ -26,26 +35,481 @@ MatchingEngine::MatchingEngine(const utils::Config& config)
         LOG_ERROR("Failed to connect to Redis persistence");
     }
     
+    // "HH:MM" UTC
+    int closeHour = 21, closeMinute = 0;
+    auto sessionClose = config.get<std::string>("engine.session_close_utc", "21:00");
+    if (std::sscanf(sessionClose.c_str(), "%d:%d", &closeHour, &closeMinute) != 2) {
+        LOG_WARNING("Invalid engine.session_close_utc '{}', using 21:00", sessionClose);
+        closeHour = 21;
+        closeMinute = 0;
+    }
+    sessionCloseMs_ = (closeHour * 60 + closeMinute) * 60000LL;
+    
     initializeInstruments();
     LOG_INFO("MatchingEngine initialized with risk management and persistence");
 }
 
-void MatchingEngine::processSingleOrder(OrderPtr order) {
+void MatchingEngine::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    
+    status_ = EngineStatus::STARTING;
+    for (auto& lane : lanes_) {
+        lane->thread = std::thread(&MatchingEngine::processOrders, this, std::ref(*lane));
+    }
+    status_ = EngineStatus::RUNNING;
+    LOG_INFO("MatchingEngine started with {} matching lanes", lanes_.size());
+}
+
+void MatchingEngine::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    
+    status_ = EngineStatus::STOPPING;
+    for (auto& lane : lanes_) {
+        if (lane->thread.joinable()) {
+            lane->thread.join();
+        }
+    }
+    status_ = EngineStatus::STOPPED;
+    LOG_INFO("MatchingEngine stopped");
+}
+
+bool MatchingEngine::enqueueOrder(OrderPtr order) {
+    auto& lane = *lanes_[riskEngine_->shardOf(order->getUserId())];
+    std::lock_guard lock(lane.enqueueMutex);
+    return lane.orders.push(LaneItem{std::move(order), {}, nullptr, nullptr, nullptr, nullptr});
+}
+
+std::future<std::vector<MatchingEngine::BatchOutcome>> MatchingEngine::enqueueOrders(std::vector<OrderPtr> orders) {
+    auto done = std::make_unique<std::promise<std::vector<BatchOutcome>>>();
+    auto outcomes = done->get_future();
+    if (orders.empty()) {
+        done->set_value({});
+        return outcomes;
+    }
+    
+    auto& lane = *lanes_[riskEngine_->shardOf(orders.front()->getUserId())];
+    std::lock_guard lock(lane.enqueueMutex);
+    LaneItem item{nullptr, std::move(orders), nullptr, nullptr, nullptr, nullptr, std::move(done)};
+    if (!lane.orders.push(std::move(item))) {
+        return {};
+    }
+    return outcomes;
+}
+
+bool MatchingEngine::enqueueParentOrder(OrderPtr parent, ParentOrderManager::Schedule schedule) {
+    auto& lane = *lanes_[riskEngine_->shardOf(parent->getUserId())];
+    const UserId userId = parent->getUserId();
+    auto request = std::make_unique<ParentRequest>(ParentRequest{std::move(parent), std::move(schedule), 0, userId});
+    std::lock_guard lock(lane.enqueueMutex);
+    return lane.orders.push(LaneItem{nullptr, {}, std::move(request), nullptr, nullptr, nullptr});
+}
+
+bool MatchingEngine::modifyOrder(OrderId orderId, UserId userId, const std::string& symbol, Quantity newQuantity,
+                                 Price newPrice, uint32_t sessionIndex) {
+    auto instrument = instruments_.find(symbol);
+    if (instrument == instruments_.end()) {
+        return false;
+    }
+    
+    auto& lane = *lanes_[riskEngine_->shardOf(userId)];
+    auto request = std::make_unique<ModifyRequest>(
+        ModifyRequest{orderId, userId, newQuantity, newPrice, &instrument->second, sessionIndex});
+    std::lock_guard lock(lane.enqueueMutex);
+    return lane.orders.push(LaneItem{nullptr, {}, nullptr, std::move(request), nullptr, nullptr});
+}
+
+bool MatchingEngine::cancelParentOrder(OrderId parentId, UserId userId) {
+    auto& lane = *lanes_[riskEngine_->shardOf(userId)];
+    auto request = std::make_unique<ParentRequest>(ParentRequest{nullptr, {}, parentId, userId});
+    std::lock_guard lock(lane.enqueueMutex);
+    return lane.orders.push(LaneItem{nullptr, {}, std::move(request), nullptr, nullptr, nullptr});
+}
+
+void MatchingEngine::registerMarketMaker(UserId userId) {
+    for (auto& [symbol, instrument] : instruments_) {
+        std::unique_lock lock(instrument.mutex);
+        if (instrument.quotes.count(userId)) {
+            continue;
+        }
+        
+        // Empty until the first quote re-arms them
+        OrderBook::Quote quote{
+            std::make_shared<Order>(generateOrderId(), userId, symbol, OrderType::LIMIT, OrderSide::BUY, 0.0, 0),
+            std::make_shared<Order>(generateOrderId(), userId, symbol, OrderType::LIMIT, OrderSide::SELL, 0.0, 0)};
+        instrument.quotes.emplace(userId, std::move(quote));
+    }
+    LOG_INFO("Market maker {} registered on {} instruments", userId, instruments_.size());
+}
+
+bool MatchingEngine::enqueueMassQuote(UserId userId, std::vector<QuoteEntry> quotes, uint32_t sessionIndex) {
+    auto& lane = *lanes_[riskEngine_->shardOf(userId)];
+    auto request = std::make_unique<QuoteRequest>(QuoteRequest{userId, std::move(quotes), sessionIndex});
+    std::lock_guard lock(lane.enqueueMutex);
+    return lane.orders.push(LaneItem{nullptr, {}, nullptr, nullptr, std::move(request), nullptr});
+}
+
+bool MatchingEngine::startAuction(const std::string& symbol) {
+    auto instrument = instruments_.find(symbol);
+    if (instrument == instruments_.end()) {
+        return false;
+    }
+    
+    std::unique_lock lock(instrument->second.mutex);
+    instrument->second.orderBook.startAuction();
+    publishAuctionUpdate(instrument->second);
+    return true;
+}
+
+bool MatchingEngine::uncrossAuction(const std::string& symbol) {
+    auto instrument = instruments_.find(symbol);
+    if (instrument == instruments_.end()) {
+        return false;
+    }
+    
+    // Any lane will do: its thread records the trades as the producer for every user
+    auto& lane = *lanes_.front();
+    std::lock_guard lock(lane.enqueueMutex);
+    return lane.orders.push(LaneItem{nullptr, {}, nullptr, nullptr, nullptr, &instrument->second});
+}
+
+std::optional<ExecutionEvent> MatchingEngine::pollExecutionEvent(Gateway gateway) {
+    return executionQueues_[static_cast<size_t>(gateway)].pop();
+}
+
+std::optional<TopOfBook> MatchingEngine::pollTopOfBook() {
+    return topOfBookQueue_.pop();
+}
+
+std::optional<IndicativeUpdate> MatchingEngine::pollIndicative() {
+    return indicativeQueue_.pop();
+}
+
+std::optional<DepthUpdate> MatchingEngine::pollDepthUpdate() {
+    return depthQueue_.pop();
+}
+
+OrderId MatchingEngine::generateOrderId() {
+    return nextOrderId_.fetch_add(1, std::memory_order_relaxed);
+}
+
+TradeId MatchingEngine::generateTradeId() {
+    return nextTradeId_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MatchingEngine::initializeInstruments() {
+    double bandPercent = config_.get<double>("engine.price_band_percent", 0.0);
+    std::chrono::milliseconds bandPause(config_.get<int>("engine.price_band_pause_ms", 0));
+    
+    Price tickSize = config_.get<double>("engine.tick_size", 0.01);
+    bool openingAuction = config_.get<bool>("engine.opening_auction", false);
+    
+    // Allocation: one default, "SYMBOL:algorithm" overrides and "SYMBOL:userId" lead market makers
+    auto toAlgorithm = [](const std::string& name) {
+        return name == "pro_rata" ? MatchingAlgorithm::PRO_RATA
+             : name == "fifo_lmm" ? MatchingAlgorithm::FIFO_LMM
+                                  : MatchingAlgorithm::FIFO;
+    };
+    OrderBook::AllocationSettings defaultAllocation;
+    defaultAllocation.algorithm = toAlgorithm(config_.get<std::string>("engine.matching_algorithm", "fifo"));
+    defaultAllocation.minimumAllocation = config_.get<int>("engine.pro_rata_min_allocation", 1);
+    defaultAllocation.leadShare = config_.get<double>("engine.lmm_share", 0.0);
+    std::unordered_map<std::string, OrderBook::AllocationSettings> allocations;
+    for (const auto& entry : config_.getVector<std::string>("engine.instrument_algorithms")) {
+        auto colon = entry.find(':');
+        if (colon != std::string::npos) {
+            auto& allocation = allocations.try_emplace(entry.substr(0, colon), defaultAllocation).first->second;
+            allocation.algorithm = toAlgorithm(entry.substr(colon + 1));
+        }
+    }
+    for (const auto& entry : config_.getVector<std::string>("engine.lead_market_makers")) {
+        auto colon = entry.find(':');
+        if (colon != std::string::npos) {
+            auto& allocation = allocations.try_emplace(entry.substr(0, colon), defaultAllocation).first->second;
+            allocation.leadMarketMaker = static_cast<UserId>(std::stoul(entry.substr(colon + 1)));
+        }
+    }
+    
+    for (const auto& symbol : config_.getVector<std::string>("engine.symbols")) {
+        auto& instrument = instruments_.try_emplace(symbol, symbol).first->second;
+        instrument.orderBook.setPriceBand(bandPercent, bandPause);
+        instrument.orderBook.setTickSize(tickSize);
+        auto allocation = allocations.find(symbol);
+        instrument.orderBook.setAllocation(allocation != allocations.end() ? allocation->second : defaultAllocation);
+        if (openingAuction) {
+            instrument.orderBook.startAuction();
+        }
+        riskEngine_->registerInstrument(symbol);
+    }
+    LOG_INFO("Initialized {} instruments", instruments_.size());
+    
+    for (auto userId : config_.getVector<int>("engine.market_makers")) {
+        registerMarketMaker(static_cast<UserId>(userId));
+    }
+}
+
+void MatchingEngine::processOrders(MatchingLane& lane) {
+    while (running_.load(std::memory_order_relaxed)) {
+        // Fills and marks other lanes produced for this lane's users
+        riskEngine_->applyPostTradeUpdates(lane.shard);
+        foldChildFills(lane);
+        while (auto timer = lane.doneTimers.pop()) {
+            lane.timers.cancel(*timer);
+        }
+        if (lane.shard == 0) {
+            // One lane drives the VaR return samples on the risk interval
+            riskEngine_->sampleReturns(std::chrono::steady_clock::now());
+        }
+        
+        lane.timers.advance(timerTick(std::chrono::system_clock::now()),
+                            [&](const TimerEvent& event) { fireTimer(lane, event); });
+        
+        auto item = lane.orders.pop();
+        if (!item) {
+            std::this_thread::yield();
+            continue;
+        }
+        
+        if (item->parent) {
+            processParentRequest(lane, *item->parent);
+            continue;
+        }
+        
+        if (item->modify) {
+            try {
+                processModify(lane, *item->modify);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Error modifying order {}: {}", item->modify->orderId, e.what());
+            }
+            continue;
+        }
+        
+        if (item->quotes) {
+            try {
+                processMassQuote(lane, *item->quotes);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Error processing mass quote from user {}: {}", item->quotes->userId, e.what());
+            }
+            continue;
+        }
+        
+        if (item->uncross) {
+            try {
+                processUncross(lane, *item->uncross);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Error uncrossing {}: {}", item->uncross->symbol, e.what());
+            }
+            continue;
+        }
+        
+        if (!item->order) {
+            processBatch(lane, item->batch, *item->batchDone);
+            continue;
+        }
+        
+        try {
+            processSingleOrder(lane, item->order);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error processing order {}: {}", item->order->getId(), e.what());
+        }
+    }
+}
+
+void MatchingEngine::publishExecutions(std::vector<ExecutionEvent>& events) {
+    std::lock_guard lock(executionPublishMutex_);
+    for (auto& event : events) {
+        event.execId = nextExecId_.fetch_add(1, std::memory_order_relaxed);
+        if (event.expiryTimer != 0 &&
+            (event.execType == ExecType::FILL || event.execType == ExecType::CANCELLED)) {
+            // Done early: a full ring leaves the timer to fire and find nothing
+            lanes_[riskEngine_->shardOf(event.userId)]->doneTimers.push(event.expiryTimer);
+        }
+        if (event.sessionIndex == 0) {
+            // No gateway to report to; a child's fills go to its parent's lane. A
+            // full ring drops them there, and the parent's next slice folds them.
+            if (event.parentId != 0 &&
+                (event.execType == ExecType::FILL || event.execType == ExecType::PARTIAL_FILL)) {
+                lanes_[riskEngine_->shardOf(event.userId)]->childFills.push(event);
+            }
+            continue;
+        }
+        auto& queue = executionQueues_[static_cast<size_t>(gatewayOf(event.sessionIndex))];
+        while (!queue.push(event)) {
+            // The gateway is behind; back-pressure matching rather than drop a fill
+            std::this_thread::yield();
+        }
+    }
+    events.clear();
+}
+
+bool MatchingEngine::cancelOrder(OrderId orderId, UserId userId, uint32_t sessionIndex) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
+    for (auto& [symbol, instrument] : instruments_) {
+        std::unique_lock lock(instrument.mutex);
+        if (instrument.orderBook.cancelOrder(orderId, userId, sessionIndex)) {
+            instrument.orderBook.drainExecutionEvents(executions);
+            riskEngine_->releaseExposure(symbol, executions, risk::RiskEngine::NO_SHARD);
+            publishExecutions(executions);
+            publishMarketData(instrument);
+            LOG_DEBUG("Order {} cancelled by user {}", orderId, userId);
+            return true;
+        }
+    }
+    
+    LOG_DEBUG("Cancel of order {} by user {} refused: unknown or not theirs", orderId, userId);
+    return false;
+}
+
+size_t MatchingEngine::cancelUserOrders(UserId userId, const std::string& symbol) {
+    size_t cancelled = 0;
+    for (auto& [name, instrument] : instruments_) {
+        if (symbol.empty() || name == symbol) {
+            std::unique_lock lock(instrument.mutex);
+            cancelled += instrument.orderBook.cancelUserOrders(userId);
+            publishCancels(instrument);
+        }
+    }
+    
+    LOG_INFO("Mass cancel for user {}{}{}: {} orders", userId, symbol.empty() ? "" : " on ", symbol, cancelled);
+    return cancelled;
+}
+
+size_t MatchingEngine::cancelSessionOrders(uint32_t sessionIndex) {
+    size_t cancelled = 0;
+    for (auto& [symbol, instrument] : instruments_) {
+        std::unique_lock lock(instrument.mutex);
+        cancelled += instrument.orderBook.cancelSessionOrders(sessionIndex);
+        publishCancels(instrument);
+    }
+    
+    LOG_INFO("Mass cancel for session {}: {} orders", sessionIndex, cancelled);
+    return cancelled;
+}
+
+void MatchingEngine::publishCancels(InstrumentData& instrument) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
+    // Cancels never trade, so they release exposure from any thread, as cancelOrder does
+    instrument.orderBook.drainExecutionEvents(executions);
+    if (!executions.empty()) {
+        riskEngine_->releaseExposure(instrument.symbol, executions, risk::RiskEngine::NO_SHARD);
+        publishExecutions(executions);
+        publishMarketData(instrument);
+    }
+}
+
+void MatchingEngine::processSingleOrder(MatchingLane& lane, OrderPtr order) {
     // Risk check
     auto riskCheck = riskEngine_->checkOrder(*order);
     if (!riskCheck.approved) {
-        OrderResponse response{order->getId(), OrderStatus::REJECTED, 
-                              riskCheck.reason, 0, 0};
-        sendResponse(response);
+        rejectOrder(order, riskCheck.reason);
         return;
     }
     
+    matchOrder(lane, std::move(order));
+}
+
+void MatchingEngine::processBatch(MatchingLane& lane, std::vector<OrderPtr>& batch,
+                                  std::promise<std::vector<BatchOutcome>>& done) {
+    // One check and one reservation for the whole batch
+    auto riskCheck = riskEngine_->checkOrders(batch);
+    for (auto& order : batch) {
+        try {
+            if (riskCheck.approved) {
+                matchOrder(lane, order);
+            } else {
+                rejectOrder(order, riskCheck.reason);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error processing order {}: {}", order->getId(), e.what());
+        }
+    }
+    
+    // A resting order may already be trading with other lanes; read it under its book lock
+    std::vector<BatchOutcome> outcomes;
+    outcomes.reserve(batch.size());
+    for (const auto& order : batch) {
+        auto instrument = instruments_.find(order->getSymbol());
+        std::shared_lock<std::shared_mutex> lock;
+        if (instrument != instruments_.end()) {
+            lock = std::shared_lock(instrument->second.mutex);
+        }
+        outcomes.push_back(BatchOutcome{order->getId(), order->getStatus(), order->getFilledQuantity(),
+                                        order->getAveragePrice()});
+    }
+    done.set_value(std::move(outcomes));
+}
+
+void MatchingEngine::rejectOrder(const OrderPtr& order, const std::string& reason) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
+    OrderResponse response{order->getId(), OrderStatus::REJECTED, reason, 0, 0};
+    sendResponse(response);
+    
+    order->setStatus(OrderStatus::REJECTED);
+    executions.push_back(ExecutionEvent::fromOrder(*order, ExecType::REJECTED));
+    publishExecutions(executions);
+}
+
+void MatchingEngine::matchOrder(MatchingLane& lane, OrderPtr order) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
     auto& instrument = instruments_.at(order->getSymbol());
+    const auto& symbol = order->getSymbol();
+    const size_t shard = riskEngine_->shardOf(order->getUserId());
     
     std::vector<Trade> trades;
     {
         std::unique_lock lock(instrument.mutex);
+        
+        // A halted instrument rejects the order and hands back what the risk check reserved
+        if (tradingHalted(symbol, true)) {
+            order->setStatus(OrderStatus::REJECTED);
+            auto release = ExecutionEvent::fromOrder(*order, ExecType::CANCELLED);
+            riskEngine_->releaseExposure(symbol, std::span(&release, 1), shard);
+            executions.push_back(ExecutionEvent::fromOrder(*order, ExecType::REJECTED));
+            publishExecutions(executions);
+            lock.unlock();
+            
+            OrderResponse response{order->getId(), OrderStatus::REJECTED, "Trading halted", 0, 0};
+            sendResponse(response);
+            return;
+        }
+        
+        // Acknowledge before any fills so reports reach the client in FIX order
+        executions.push_back(ExecutionEvent::fromOrder(*order, ExecType::NEW));
         trades = instrument.orderBook.addOrder(order);
+        instrument.orderBook.drainExecutionEvents(executions);
+        
+        // Whatever a market/IOC/FOK order could not fill is not resting: report it cancelled
+        // (unless the book already did, when a price band stopped the order)
+        const auto type = order->getType();
+        const bool immediate = type == OrderType::MARKET || type == OrderType::IOC || type == OrderType::FOK;
+        if (immediate && order->getRemainingQuantity() > 0 && order->getStatus() != OrderStatus::CANCELLED) {
+            executions.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+        }
+        
+        // Resting with a time limit: expire it from this lane, which cancels the
+        // timer once the order fills or is cancelled first (publishExecutions)
+        if (!immediate && order->isActive() && order->getTimeInForce() != TimeInForce::GTC) {
+            order->setExpiryTimer(lane.timers.schedule(
+                expiryTick(*order), TimerEvent{TimerEvent::Kind::ORDER_EXPIRY, order->getId(), &instrument}));
+        }
+        
+        // Update risk engine in one batch, under the book lock so this instrument's
+        // prints reach the risk shards in order; then release what the fills and
+        // cancels no longer need reserved
+        riskEngine_->recordTrades(trades, shard);
+        riskEngine_->releaseExposure(symbol, executions, shard);
+        checkPrints(symbol, trades);
+        
+        // Published under the book lock so a concurrent cancel cannot overtake these fills
+        publishExecutions(executions);
+        publishMarketData(instrument);
         
         // Persist the order
         if (persistence_->isConnected()) {
@@ -65,13 +529,10 @@ void MatchingEngine::processSingleOrder(OrderPtr order) {
             if (persistence_->isConnected()) {
                 persistence_->saveTrade(trade);
             }
-            
-            // Update risk engine
-            riskEngine_->recordTrade(trade);
         }
         
         // Save order book snapshot periodically
-        static size_t orderCount = 0;
+        thread_local size_t orderCount = 0;
         if (++orderCount % 1000 == 0) { // Every 1000 orders
             if (persistence_->isConnected()) {
                 persistence_->saveOrderBookSnapshot(order->getSymbol(), instrument.orderBook);
@@ -83,13 +544,350 @@ void MatchingEngine::processSingleOrder(OrderPtr order) {
     // Build and send response
     OrderResponse response = buildOrderResponse(order, trades);
     sendResponse(response);
+}
+
+void MatchingEngine::processModify(MatchingLane& lane, const ModifyRequest& request) {
+    thread_local std::vector<ExecutionEvent> executions;
+    thread_local std::vector<BookUpdate> updates;
     
-    // Publish market data if needed
-    if (!trades.empty()) {
-        publishMarketData(order->getSymbol(), instrument.orderBook);
+    auto& instrument = *request.instrument;
+    std::unique_lock lock(instrument.mutex);
+    auto order = instrument.orderBook.findOrder(request.orderId);
+    const bool owned = order && order->getUserId() == request.userId &&
+                       (request.sessionIndex == 0 || order->getSessionIndex() == request.sessionIndex);
+    
+    // Validated first so an approved reservation move is always applied
+    std::string refused;
+    if (!owned) {
+        refused = "unknown order";
+    } else if (tradingHalted(instrument.symbol, true)) {
+        refused = "trading halted";
+    } else if (!instrument.orderBook.canModify(request.orderId, request.quantity, request.price)) {
+        refused = "not applicable to the book";
+    } else if (auto riskCheck = riskEngine_->checkModify(*order, request.quantity, request.price);
+               !riskCheck.approved) {
+        refused = riskCheck.reason;
+    }
+    
+    if (!refused.empty()) {
+        LOG_DEBUG("Modify of order {} by user {} rejected: {}", request.orderId, request.userId, refused);
+        
+        // To the requesting session, with nothing of an order that is not the requester's
+        auto rejected = owned ? ExecutionEvent::fromOrder(*order, ExecType::MODIFY_REJECTED) : ExecutionEvent{};
+        rejected.orderId = request.orderId;
+        rejected.userId = request.userId;
+        rejected.execType = ExecType::MODIFY_REJECTED;
+        rejected.sessionIndex = request.sessionIndex;
+        executions.push_back(rejected);
+        publishExecutions(executions);
+        return;
+    }
+    
+    std::vector<Trade> trades;
+    instrument.orderBook.modifyOrder(request.orderId, request.quantity, request.price, trades);
+    instrument.orderBook.drainExecutionEvents(executions);
+    instrument.orderBook.drainBookUpdates(updates);
+    
+    // As for a new order: positions, then reservations, then reports, all under the book lock
+    riskEngine_->recordTrades(trades, lane.shard);
+    riskEngine_->releaseExposure(instrument.symbol, executions, lane.shard);
+    checkPrints(instrument.symbol, trades);
+    publishExecutions(executions);
+    publishBookUpdates(instrument, updates);
+    publishMarketData(instrument);
+    
+    keepTrades(instrument, trades);
+    if (persistence_->isConnected()) {
+        persistence_->saveOrder(*order);
     }
 }
 
+void MatchingEngine::processMassQuote(MatchingLane& lane, const QuoteRequest& request) {
+    thread_local std::vector<ExecutionEvent> executions;
+    thread_local std::vector<BookUpdate> updates;
+    
+    for (const auto& entry : request.entries) {
+        auto instrument = instruments_.find(entry.symbol);
+        if (instrument == instruments_.end()) {
+            LOG_DEBUG("Quote from user {} for unknown symbol {}", request.userId, entry.symbol);
+            continue;
+        }
+        if (entry.bidQuantity > 0 && entry.askQuantity > 0 && entry.bidPrice >= entry.askPrice) {
+            LOG_DEBUG("Crossed quote from user {} on {} skipped", request.userId, entry.symbol);
+            continue;
+        }
+        
+        auto& data = instrument->second;
+        std::unique_lock lock(data.mutex);
+        auto slot = data.quotes.find(request.userId);
+        if (slot == data.quotes.end()) {
+            LOG_DEBUG("Quote from user {} who is not a registered market maker", request.userId);
+            return;
+        }
+        if (tradingHalted(entry.symbol, true)) {
+            LOG_DEBUG("Quote from user {} on halted {} skipped", request.userId, entry.symbol);
+            continue;
+        }
+        
+        // Re-entering sides are checked before either is applied, resting ones as
+        // the book applies them (so a side it pulls never moved its reservation),
+        // all under the book lock
+        auto& quote = slot->second;
+        auto bid = checkQuoteSide(data, *quote.bid, {entry.bidPrice, entry.bidQuantity}, request.sessionIndex,
+                                  entry.bidSlot, executions);
+        auto ask = checkQuoteSide(data, *quote.ask, {entry.askPrice, entry.askQuantity}, request.sessionIndex,
+                                  entry.askSlot, executions);
+        auto approveModify = [this](Order& order, Quantity newQuantity, Price newPrice) -> bool {
+            auto riskCheck = riskEngine_->checkModify(order, newQuantity, newPrice);
+            if (!riskCheck.approved) {
+                LOG_DEBUG("Quote side {} pulled by risk: {}", order.getId(), riskCheck.reason);
+            }
+            return riskCheck.approved;
+        };
+        auto trades = data.orderBook.updateQuote(quote, bid, ask, approveModify);
+        data.orderBook.drainExecutionEvents(executions);
+        data.orderBook.drainBookUpdates(updates);
+        
+        riskEngine_->recordTrades(trades, lane.shard);
+        riskEngine_->releaseExposure(entry.symbol, executions, lane.shard);
+        checkPrints(entry.symbol, trades);
+        publishExecutions(executions);
+        publishBookUpdates(data, updates);
+        publishMarketData(data);
+        keepTrades(data, trades);
+    }
+}
+
+OrderBook::QuoteSide MatchingEngine::checkQuoteSide(InstrumentData& instrument, Order& order,
+                                                    OrderBook::QuoteSide target, uint32_t sessionIndex,
+                                                    uint32_t slot,
+                                                    std::vector<ExecutionEvent>& executions) {
+    if (target.quantity <= 0) {
+        return {};
+    }
+    
+    // Resting: risk moves its reservation in updateQuote, as the book applies it
+    if (instrument.orderBook.findOrder(order.getId())) {
+        return target;
+    }
+    
+    // Otherwise a new order on the slot's object, acknowledged like one to the quoting session
+    order.rearm(generateOrderId(), target.price, target.quantity);
+    order.setSessionRoute(sessionIndex, slot);
+    auto riskCheck = riskEngine_->checkOrder(order);
+    if (!riskCheck.approved) {
+        LOG_DEBUG("Quote side {} rejected by risk: {}", order.getId(), riskCheck.reason);
+        order.setStatus(OrderStatus::REJECTED);
+        executions.push_back(ExecutionEvent::fromOrder(order, ExecType::REJECTED));
+        return {};
+    }
+    executions.push_back(ExecutionEvent::fromOrder(order, ExecType::NEW));
+    return target;
+}
+
+void MatchingEngine::processUncross(MatchingLane& lane, InstrumentData& instrument) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
+    std::unique_lock lock(instrument.mutex);
+    if (tradingHalted(instrument.symbol, false)) {
+        LOG_WARNING("Uncross of halted {} refused; it stays in its auction", instrument.symbol);
+        return;
+    }
+    auto trades = instrument.orderBook.uncross();
+    instrument.orderBook.drainExecutionEvents(executions);
+    
+    // The batch spans users of every shard; this lane produces all their updates
+    riskEngine_->recordTrades(trades, lane.shard);
+    riskEngine_->releaseExposure(instrument.symbol, executions, lane.shard);
+    checkPrints(instrument.symbol, trades);
+    publishExecutions(executions);
+    publishMarketData(instrument);
+    keepTrades(instrument, trades);
+}
+
+bool MatchingEngine::tradingHalted(const std::string& symbol, bool countOrder) {
+    if (!circuitBreaker_) {
+        return false;
+    }
+    
+    // An order counts towards the rate whether or not it trades
+    const bool rateOk = !countOrder || circuitBreaker_->checkOrderRate(symbol);
+    return !rateOk || circuitBreaker_->isMarketHalted() || circuitBreaker_->isSymbolHalted(symbol);
+}
+
+void MatchingEngine::checkPrints(const std::string& symbol, const std::vector<Trade>& trades) {
+    if (!circuitBreaker_) {
+        return;
+    }
+    
+    // Prints feed the breaker in book order; a trip halts the next order
+    for (const auto& trade : trades) {
+        circuitBreaker_->checkPriceMove(symbol, trade.getPrice());
+        circuitBreaker_->checkVolumeSpike(symbol, trade.getQuantity());
+    }
+}
+
+void MatchingEngine::publishAuctionUpdate(InstrumentData& instrument) {
+    // Under the book lock, like publishMarketData
+    IndicativeUpdate update;
+    if (instrument.orderBook.drainAuctionUpdate(update.auction)) {
+        std::memcpy(update.symbol, instrument.lastTop.symbol, sizeof(update.symbol));
+        std::lock_guard lock(executionPublishMutex_);
+        indicativeQueue_.push(update);
+    }
+}
+
+void MatchingEngine::publishMarketData(InstrumentData& instrument) {
+    // Under the book lock, so each instrument's changes are queued in order
+    TopOfBook top = instrument.lastTop;
+    instrument.orderBook.getTopOfBook(top);
+    if (!top.sameQuote(instrument.lastTop)) {
+        instrument.lastTop = top;
+        std::lock_guard lock(executionPublishMutex_);
+        topOfBookQueue_.push(top);
+    }
+    publishAuctionUpdate(instrument);
+}
+
+void MatchingEngine::keepTrades(InstrumentData& instrument, const std::vector<Trade>& trades) {
+    for (const auto& trade : trades) {
+        instrument.recentTrades.push_back(trade);
+        if (persistence_->isConnected()) {
+            persistence_->saveTrade(trade);
+        }
+    }
+    if (instrument.recentTrades.size() > 1000) {
+        instrument.recentTrades.erase(instrument.recentTrades.begin(),
+                                      instrument.recentTrades.end() - 1000);
+    }
+}
+
+void MatchingEngine::publishBookUpdates(InstrumentData& instrument, std::vector<BookUpdate>& updates) {
+    // Under the book lock, like publishMarketData
+    if (!updates.empty()) {
+        DepthUpdate depth;
+        std::memcpy(depth.symbol, instrument.lastTop.symbol, sizeof(depth.symbol));
+        std::lock_guard lock(executionPublishMutex_);
+        for (const auto& update : updates) {
+            depth.book = update;
+            depthQueue_.push(depth);
+        }
+    }
+    updates.clear();
+}
+
+void MatchingEngine::fireTimer(MatchingLane& lane, const TimerEvent& event) {
+    try {
+        if (event.kind == TimerEvent::Kind::PARENT_SLICE) {
+            releaseParentSlice(lane, event.orderId, *event.instrument);
+        } else if (cancelOnLane(lane, *event.instrument, event.orderId)) {
+            LOG_DEBUG("Order {} expired", event.orderId);
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error firing timer for order {}: {}", event.orderId, e.what());
+    }
+}
+
+bool MatchingEngine::cancelOnLane(MatchingLane& lane, InstrumentData& instrument, OrderId orderId) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
+    std::unique_lock lock(instrument.mutex);
+    if (!instrument.orderBook.cancelOrder(orderId)) {
+        return false;
+    }
+    
+    // Reported and released exactly like a client cancel
+    instrument.orderBook.drainExecutionEvents(executions);
+    riskEngine_->releaseExposure(instrument.symbol, executions, lane.shard);
+    publishExecutions(executions);
+    publishMarketData(instrument);
+    return true;
+}
+
+void MatchingEngine::processParentRequest(MatchingLane& lane, ParentRequest& request) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
+    if (!request.parent) {
+        // A child is its parent's user's, so another user's cancel leaves both working
+        auto child = lane.parents.workingChild(request.cancelId);
+        if (child && child->getUserId() == request.userId) {
+            cancelOnLane(lane, instruments_.at(child->getSymbol()), child->getId());
+            foldChildFills(lane);
+        }
+        if (lane.parents.cancel(request.cancelId, request.userId, executions)) {
+            publishExecutions(executions);
+        } else {
+            LOG_DEBUG("Cancel of parent order {} by user {} refused: unknown or not theirs",
+                      request.cancelId, request.userId);
+        }
+        return;
+    }
+    
+    auto& parent = request.parent;
+    auto instrument = instruments_.find(parent->getSymbol());
+    const int64_t now = timerTick(std::chrono::system_clock::now());
+    if (instrument == instruments_.end() || !lane.parents.add(parent, request.schedule, now)) {
+        rejectOrder(parent, "Invalid parent order");
+        return;
+    }
+    
+    executions.push_back(ExecutionEvent::fromOrder(*parent, ExecType::NEW));
+    publishExecutions(executions);
+    
+    // The first slice goes out on the lane's next pass
+    lane.timers.schedule(now, TimerEvent{TimerEvent::Kind::PARENT_SLICE, parent->getId(), &instrument->second});
+}
+
+void MatchingEngine::releaseParentSlice(MatchingLane& lane, OrderId parentId, InstrumentData& instrument) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
+    // Cancel and replace: what the last child left unfilled rolls into this slice.
+    // Its fills were all published before the cancel, so they are reported first.
+    if (auto child = lane.parents.workingChild(parentId)) {
+        cancelOnLane(lane, instrument, child->getId());
+        foldChildFills(lane);
+    }
+    
+    auto slice = lane.parents.releaseSlice(parentId, generateOrderId(), executions);
+    publishExecutions(executions);
+    
+    // Children are entered on this lane directly: risk checked and matched now,
+    // with no gateway round trip, so no child is ever queued behind its own slice
+    if (slice.child) {
+        processSingleOrder(lane, slice.child);
+    }
+    if (slice.nextTick >= 0) {
+        lane.timers.schedule(slice.nextTick, TimerEvent{TimerEvent::Kind::PARENT_SLICE, parentId, &instrument});
+    }
+}
+
+void MatchingEngine::foldChildFills(MatchingLane& lane) {
+    thread_local std::vector<ExecutionEvent> executions;
+    
+    while (auto fill = lane.childFills.pop()) {
+        lane.parents.onChildFill(*fill, executions);
+    }
+    if (!executions.empty()) {
+        publishExecutions(executions);
+    }
+}
+
+int64_t MatchingEngine::expiryTick(const Order& order) const {
+    if (order.getTimeInForce() == TimeInForce::GTD) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(order.getExpireTime()).count();
+    }
+    
+    // DAY: the next session close
+    constexpr int64_t DAY_MS = 24 * 60 * 60 * 1000LL;
+    int64_t now = timerTick(std::chrono::system_clock::now());
+    int64_t close = now - now % DAY_MS + sessionCloseMs_;
+    return close > now ? close : close + DAY_MS;
+}
+
+int64_t MatchingEngine::timerTick(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
 OrderResponse MatchingEngine::buildOrderResponse(OrderPtr order, 
                                                 const std::vector<Trade>& trades) {
     if (!trades.empty()) {
@@ -118,20 +916,4 @@ OrderResponse MatchingEngine::buildOrderResponse(OrderPtr order,
     }
 }
 
-void MatchingEngine::publishMarketData(const std::string& symbol, 
-                                      const OrderBook& orderBook) {
-    // This would publish market data via ZeroMQ
-    // For now, we'll just log it
-    auto depth = orderBook.getDepth(5);
-    
-    LOG_DEBUG("Market data - {}: Best Bid={}, Best Ask={}, Spread={}", 
-             symbol, orderBook.getBestBid(), orderBook.getBestAsk(), 
-             orderBook.getSpread());
-    
-    // Update risk engine with latest prices
-    if (!depth.bids.empty()) {
-        riskEngine_->updateMarketPrice(symbol, depth.bids[0].price);
-    }
-}
-
 } // namespace engine
\ No newline at end of file
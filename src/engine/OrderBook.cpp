@@ -2,124 +2,579 @@
 #include "OrderBook.hpp"
 #include "../utils/Logger.hpp"
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 
 namespace engine {
 
+namespace {
+
+// A limit in whole ticks, rounded so the tick's price never breaches it: down
+// for a bid, up for an ask
+double bidTick(Price limit, Price tickSize) {
+    return std::floor(limit / tickSize + 1e-9);
+}
+
+double askTick(Price limit, Price tickSize) {
+    return std::ceil(limit / tickSize - 1e-9);
+}
+
+} // namespace
+
 OrderBook::OrderBook(std::string symbol) : symbol_(std::move(symbol)) {}
 
 std::vector<Trade> OrderBook::addOrder(std::shared_ptr<Order> order) {
     std::unique_lock lock(mutex_);
     
-    if (orders_.find(order->orderId) != orders_.end()) {
+    if (orders_.find(order->orderId) != orders_.end() || stopOrders_.count(order->orderId)) {
         LOG_WARNING("Order {} already exists in order book", order->orderId);
         return {};
     }
     
     totalOrders_++;
     
+    // A band pause cancels whatever arrives until it expires
+    if (inPause()) {
+        updateOrderStatus(order, OrderStatus::CANCELLED);
+        executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+        return {};
+    }
+    
+    // A call only collects resting interest: an immediate order has nothing to meet
+    const bool immediate = order->type == OrderType::MARKET || order->type == OrderType::FOK ||
+                           order->type == OrderType::IOC;
+    if (immediate && phase_ == TradingPhase::CALL_AUCTION) {
+        updateOrderStatus(order, OrderStatus::CANCELLED);
+        executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+        return {};
+    }
+    
+    std::vector<Trade> trades;
     switch (order->type) {
         case OrderType::LIMIT:
-            return matchLimitOrder(order);
+        case OrderType::ICEBERG:
+            trades = matchLimitOrder(order);
+            break;
         case OrderType::MARKET:
-            return matchMarketOrder(order);
+            trades = matchMarketOrder(order);
+            break;
         case OrderType::FOK:
-            return matchFOKOrder(order);
+            trades = matchFOKOrder(order);
+            break;
         case OrderType::IOC:
-            return matchIOCOrder(order);
+            trades = matchIOCOrder(order);
+            break;
+        case OrderType::STOP:
+        case OrderType::STOP_LIMIT:
+            trades = parkStopOrder(order);
+            break;
         default:
             LOG_ERROR("Unknown order type: {}", static_cast<int>(order->type));
             return {};
     }
+    
+    afterMatch(trades);
+    refreshIndicative();
+    return trades;
 }
 
-std::vector<Trade> OrderBook::matchLimitOrder(std::shared_ptr<Order> order) {
+bool OrderBook::modifyOrder(OrderId orderId, Quantity newQuantity, Price newPrice, std::vector<Trade>& trades) {
+    std::unique_lock lock(mutex_);
+    
+    if (!canModifyLocked(orderId, newQuantity, newPrice)) {
+        return false;
+    }
+    
+    modifyLocked(orders_.find(orderId), newQuantity, newPrice, trades);
+    refreshIndicative();
+    return true;
+}
+
+void OrderBook::modifyLocked(std::unordered_map<OrderId, OrderEntry>::iterator it, Quantity newQuantity,
+                             Price newPrice, std::vector<Trade>& trades) {
+    auto order = it->second.order;
+    
+    if (newPrice == order->price && newQuantity <= order->quantity) {
+        // Reduce in place through the order's handle: it keeps its queue position
+        auto& level = *it->second.level;
+        const Quantity displayedBefore = displayedQuantity(*order);
+        level.totalQuantity -= order->quantity - newQuantity;
+        order->quantity = newQuantity;
+        if (order->type == OrderType::ICEBERG) {
+            order->visibleQuantity = std::min(order->visibleQuantity, order->getRemainingQuantity());
+        }
+        level.visibleQuantity -= displayedBefore - displayedQuantity(*order);
+        
+        executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::REPLACED));
+        bookUpdates_.push_back(BookUpdate{order->side, order->price, level.visibleQuantity,
+                                          static_cast<uint32_t>(level.orders.size()), 0.0, 0, 0});
+        return;
+    }
+    
+    // A new price or more quantity loses priority: re-entered as an arrival,
+    // which may trade if the new price crosses
+    const Price oldPrice = order->price;
+    unlinkOrder(it->second);
+    removeOrder(order->orderId);
+    order->price = newPrice;
+    order->quantity = newQuantity;
+    executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::REPLACED));
+    
+    auto matched = matchLimitOrder(order);
+    afterMatch(matched);
+    trades.insert(trades.end(), matched.begin(), matched.end());
+    
+    BookUpdate update;
+    update.side = order->side;
+    update.price = newPrice;
+    update.previousPrice = oldPrice;
+    levelState(order->side, newPrice, update.quantity, update.orderCount);
+    levelState(order->side, oldPrice, update.previousQuantity, update.previousOrderCount);
+    bookUpdates_.push_back(update);
+}
+
+std::vector<Trade> OrderBook::updateQuote(Quote& quote, QuoteSide bid, QuoteSide ask,
+                                          const ApproveModify& approveModify) {
+    std::unique_lock lock(mutex_);
+    
+    // A bid raised to the old ask (or an ask cut to the old bid) waits for the
+    // other side to move out of its way
+    auto resting = [this](const OrderPtr& order) { return orders_.count(order->orderId) != 0; };
+    const bool askFirst = bid.quantity > 0 && resting(quote.ask) && bid.price >= quote.ask->price;
+    
     std::vector<Trade> trades;
+    if (askFirst) {
+        updateQuoteSide(quote.ask, ask, approveModify, trades);
+        updateQuoteSide(quote.bid, bid, approveModify, trades);
+    } else {
+        updateQuoteSide(quote.bid, bid, approveModify, trades);
+        updateQuoteSide(quote.ask, ask, approveModify, trades);
+    }
+    refreshIndicative();
+    return trades;
+}
+
+void OrderBook::updateQuoteSide(const OrderPtr& order, QuoteSide target, const ApproveModify& approveModify,
+                                std::vector<Trade>& trades) {
+    auto it = orders_.find(order->orderId);
+    if (it != orders_.end()) {
+        const Quantity newQuantity = order->filledQuantity + target.quantity;
+        if (target.quantity > 0 && canModifyLocked(order->orderId, newQuantity, target.price) &&
+            (!approveModify || approveModify(*order, newQuantity, target.price))) {
+            modifyLocked(it, newQuantity, target.price, trades);
+        } else {
+            cancelEntry(it->second);
+        }
+        return;
+    }
     
-    if (order->side == OrderSide::BUY) {
-        // Match against asks (sell orders)
-        while (!asks_.empty() && order->getRemainingQuantity() > 0) {
-            auto bestAsk = asks_.begin();
-            if (bestAsk->first > order->price) {
-                break; // No more matches possible
-            }
-            
-            auto& ordersAtPrice = bestAsk->second;
-            while (!ordersAtPrice.empty() && order->getRemainingQuantity() > 0) {
-                auto matchingOrder = ordersAtPrice.front();
-                
-                Quantity tradeQuantity = std::min(
-                    order->getRemainingQuantity(),
-                    matchingOrder->getRemainingQuantity()
-                );
-                
-                Price tradePrice = matchingOrder->price; // Price is set by existing order
-                
-                executeTrade(order, matchingOrder, tradeQuantity, tradePrice);
-                trades.emplace_back(order->orderId, matchingOrder->orderId, 
-                                  tradeQuantity, tradePrice, std::chrono::system_clock::now());
-                
-                if (matchingOrder->isFilled()) {
-                    ordersAtPrice.pop_front();
-                    removeOrder(matchingOrder->orderId);
-                }
-                
-                if (ordersAtPrice.empty()) {
-                    asks_.erase(bestAsk);
-                    break;
-                }
-            }
+    if (target.quantity <= 0) {
+        return;
+    }
+    
+    // Filled or pulled since the last update: in again as an arrival
+    totalOrders_++;
+    if (inPause()) {
+        updateOrderStatus(order, OrderStatus::CANCELLED);
+        executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+        return;
+    }
+    auto matched = matchLimitOrder(order);
+    afterMatch(matched);
+    trades.insert(trades.end(), matched.begin(), matched.end());
+}
+
+bool OrderBook::canModify(OrderId orderId, Quantity newQuantity, Price newPrice) const {
+    std::shared_lock lock(mutex_);
+    return canModifyLocked(orderId, newQuantity, newPrice);
+}
+
+bool OrderBook::canModifyLocked(OrderId orderId, Quantity newQuantity, Price newPrice) const {
+    auto it = orders_.find(orderId);
+    if (it == orders_.end()) {
+        return false;
+    }
+    
+    // Reducing to what has filled is a cancel, not a modify; and a band pause
+    // turns away re-entries as it does arrivals
+    const auto& order = *it->second.order;
+    const bool reentry = newPrice != order.price || newQuantity > order.quantity;
+    return newQuantity > order.filledQuantity &&
+           !(reentry && paused_ && std::chrono::steady_clock::now() < resumeAt_);
+}
+
+OrderPtr OrderBook::findOrder(OrderId orderId) const {
+    std::shared_lock lock(mutex_);
+    auto it = orders_.find(orderId);
+    return it != orders_.end() ? it->second.order : nullptr;
+}
+
+void OrderBook::drainBookUpdates(std::vector<BookUpdate>& out) {
+    out.insert(out.end(), bookUpdates_.begin(), bookUpdates_.end());
+    bookUpdates_.clear();
+}
+
+void OrderBook::afterMatch(std::vector<Trade>& trades) {
+    // Once per order, not per fill
+    if (!trades.empty()) {
+        recentreBand(trades.back().getPrice());
+        lastTradePrice_ = trades.back().getPrice();
+        electStops(trades);
+    }
+}
+
+bool OrderBook::inPause() {
+    if (!paused_) {
+        return false;
+    }
+    if (std::chrono::steady_clock::now() < resumeAt_) {
+        return true;
+    }
+    paused_ = false;
+    LOG_INFO("{}: price band pause over", symbol_);
+    return false;
+}
+
+void OrderBook::levelState(OrderSide side, Price price, Quantity& quantity, uint32_t& orderCount) const {
+    const PriceLevelQueue* level = nullptr;
+    if (side == OrderSide::BUY) {
+        auto it = bids_.find(price);
+        level = it != bids_.end() ? &it->second : nullptr;
+    } else {
+        auto it = asks_.find(price);
+        level = it != asks_.end() ? &it->second : nullptr;
+    }
+    quantity = level ? level->visibleQuantity : 0;
+    orderCount = level ? static_cast<uint32_t>(level->orders.size()) : 0;
+}
+
+std::vector<Trade> OrderBook::parkStopOrder(OrderPtr order) {
+    // Already through its stop price: elect at once (not during a call, which
+    // prints nothing until the uncross)
+    if (phase_ == TradingPhase::CONTINUOUS && lastTradePrice_ > 0.0 && (order->side == OrderSide::BUY ? lastTradePrice_ >= order->stopPrice
+                                                               : lastTradePrice_ <= order->stopPrice)) {
+        return matchElectedStop(order);
+    }
+    
+    auto& level = order->side == OrderSide::BUY ? buyStops_[order->stopPrice] : sellStops_[order->stopPrice];
+    level.push_back(order);
+    auto& entry = stopOrders_[order->orderId];
+    entry.order = order;
+    entry.iterator = --level.end();
+    chainEntry(entry);
+    updateOrderStatus(order, OrderStatus::NEW);
+    return {};
+}
+
+std::vector<Trade> OrderBook::matchElectedStop(OrderPtr order) {
+    if (order->type == OrderType::STOP_LIMIT) {
+        order->type = OrderType::LIMIT;
+        return matchLimitOrder(order);
+    }
+    
+    order->type = OrderType::MARKET;
+    auto trades = matchMarketOrder(order);
+    
+    // Elected market orders never rest
+    if (order->getRemainingQuantity() > 0 && order->status != OrderStatus::CANCELLED) {
+        updateOrderStatus(order, OrderStatus::CANCELLED);
+        executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+    }
+    return trades;
+}
+
+OrderPtr OrderBook::popElectedStop() {
+    // A print can only have crossed stops on one side: entry elects any stop
+    // already through the last price, so parked buy stops sit above it and sells below
+    OrderPtr elected;
+    if (!buyStops_.empty() && buyStops_.begin()->first <= lastTradePrice_) {
+        elected = buyStops_.begin()->second.front();
+    } else if (!sellStops_.empty() && sellStops_.begin()->first >= lastTradePrice_) {
+        elected = sellStops_.begin()->second.front();
+    }
+    
+    if (elected) {
+        removeStop(elected->orderId);
+    }
+    return elected;
+}
+
+void OrderBook::removeStop(OrderId orderId) {
+    auto it = stopOrders_.find(orderId);
+    const auto& order = *it->second.order;
+    if (order.side == OrderSide::BUY) {
+        auto level = buyStops_.find(order.stopPrice);
+        level->second.erase(it->second.iterator);
+        if (level->second.empty()) {
+            buyStops_.erase(level);
+        }
+    } else {
+        auto level = sellStops_.find(order.stopPrice);
+        level->second.erase(it->second.iterator);
+        if (level->second.empty()) {
+            sellStops_.erase(level);
+        }
+    }
+    unchainEntry(it->second);
+    stopOrders_.erase(it);
+}
+
+void OrderBook::electStops(std::vector<Trade>& trades) {
+    // One elected stop at a time, each against the latest print, so a cascade
+    // resolves in this call and in the same order on every replay. A band pause
+    // leaves the rest parked.
+    while (!paused_) {
+        auto stop = popElectedStop();
+        if (!stop) {
+            break;
         }
         
-        // If there's remaining quantity, add to order book
-        if (order->getRemainingQuantity() > 0) {
-            auto& priceLevel = bids_[order->price];
-            priceLevel.push_back(order);
-            orders_[order->orderId] = {order, --priceLevel.end()};
-            updateOrderStatus(order, OrderStatus::NEW);
+        auto elected = matchElectedStop(stop);
+        if (!elected.empty()) {
+            recentreBand(elected.back().getPrice());
+            lastTradePrice_ = elected.back().getPrice();
+            trades.insert(trades.end(), elected.begin(), elected.end());
         }
+    }
+}
+
+size_t OrderBook::getStopOrderCount() const {
+    std::shared_lock lock(mutex_);
+    return stopOrders_.size();
+}
+
+void OrderBook::setPriceBand(double percent, std::chrono::milliseconds pause) {
+    std::unique_lock lock(mutex_);
+    bandPercent_ = percent;
+    bandPause_ = pause;
+    if (percent <= 0.0) {
+        bandLower_ = 0.0;
+        bandUpper_ = std::numeric_limits<Price>::max();
+    }
+}
+
+bool OrderBook::isPaused() const {
+    std::shared_lock lock(mutex_);
+    return paused_ && std::chrono::steady_clock::now() < resumeAt_;
+}
+
+void OrderBook::startAuction() {
+    std::unique_lock lock(mutex_);
+    phase_ = TradingPhase::CALL_AUCTION;
+    indicative_ = AuctionUpdate{};
+    indicativeChanged_ = true;
+    LOG_INFO("{}: call auction started", symbol_);
+}
+
+std::vector<Trade> OrderBook::uncross() {
+    std::unique_lock lock(mutex_);
+    
+    std::vector<Trade> trades;
+    if (phase_ != TradingPhase::CALL_AUCTION) {
+        return trades;
+    }
+    
+    // One batch at one price, in price-time priority on both sides; hidden
+    // iceberg quantity takes part in full
+    const auto auction = equilibrium();
+    const double priceTick = std::round(auction.indicativePrice / tickSize_);
+    Quantity volume = auction.indicativeVolume;
+    while (volume > 0 && !bids_.empty() && !asks_.empty()) {
+        auto bestBid = bids_.begin();
+        auto bestAsk = asks_.begin();
+        if (bidTick(bestBid->first, tickSize_) < priceTick || askTick(bestAsk->first, tickSize_) > priceTick) {
+            LOG_ERROR("{}: uncross at {} stopped {} short, at bid {} / ask {}", symbol_, auction.indicativePrice,
+                      volume, bestBid->first, bestAsk->first);
+            break; // never beyond either order's limit
+        }
+        auto buy = bestBid->second.orders.front();
+        auto sell = bestAsk->second.orders.front();
         
-    } else { // SELL
-        // Match against bids (buy orders)
-        while (!bids_.empty() && order->getRemainingQuantity() > 0) {
-            auto bestBid = bids_.begin();
-            if (bestBid->first < order->price) {
-                break; // No more matches possible
-            }
-            
-            auto& ordersAtPrice = bestBid->second;
-            while (!ordersAtPrice.empty() && order->getRemainingQuantity() > 0) {
-                auto matchingOrder = ordersAtPrice.front();
-                
-                Quantity tradeQuantity = std::min(
-                    order->getRemainingQuantity(),
-                    matchingOrder->getRemainingQuantity()
-                );
-                
-                Price tradePrice = matchingOrder->price; // Price is set by existing order
-                
-                executeTrade(matchingOrder, order, tradeQuantity, tradePrice);
-                trades.emplace_back(matchingOrder->orderId, order->orderId, 
-                                  tradeQuantity, tradePrice, std::chrono::system_clock::now());
-                
-                if (matchingOrder->isFilled()) {
-                    ordersAtPrice.pop_front();
-                    removeOrder(matchingOrder->orderId);
-                }
-                
-                if (ordersAtPrice.empty()) {
-                    bids_.erase(bestBid);
-                    break;
-                }
+        Quantity quantity = std::min({volume, buy->getRemainingQuantity(), sell->getRemainingQuantity()});
+        trades.push_back(executeTrade(buy, sell, quantity, auction.indicativePrice));
+        volume -= quantity;
+        takeAuctionFill(bids_, bestBid, buy, quantity);
+        takeAuctionFill(asks_, bestAsk, sell, quantity);
+    }
+    
+    phase_ = TradingPhase::CONTINUOUS;
+    LOG_INFO("{}: uncrossed {} at {} in {} trades", symbol_, auction.indicativeVolume,
+             auction.indicativePrice, trades.size());
+    afterMatch(trades);
+    return trades;
+}
+
+template<typename Tree>
+void OrderBook::takeAuctionFill(Tree& tree, typename Tree::iterator level, const OrderPtr& order,
+                                Quantity quantity) {
+    auto& queue = level->second;
+    queue.totalQuantity -= quantity;
+    if (order->type == OrderType::ICEBERG) {
+        // Past the shown peak: show a fresh one, keeping its place
+        const Quantity shown = order->visibleQuantity;
+        order->visibleQuantity = shown > quantity ? shown - quantity
+                                                  : std::min(order->peakSize, order->getRemainingQuantity());
+        queue.visibleQuantity += order->visibleQuantity - shown;
+    } else {
+        queue.visibleQuantity -= quantity;
+    }
+    
+    if (order->isFilled()) {
+        queue.orders.pop_front();
+        removeOrder(order->orderId);
+        if (queue.orders.empty()) {
+            tree.erase(level);
+        }
+    }
+}
+
+AuctionUpdate OrderBook::equilibrium() {
+    AuctionUpdate result;
+    if (bids_.empty() || asks_.empty() || bids_.begin()->first < asks_.begin()->first) {
+        return result; // nothing crosses
+    }
+    
+    // Only prices from the lowest ask to the highest bid can execute anything;
+    // just the levels in that range are walked, whatever its width in ticks
+    const Price low = asks_.begin()->first;
+    const Price high = bids_.begin()->first;
+    auctionBids_.clear();
+    auctionAsks_.clear();
+    auctionTicks_.clear();
+    Quantity demand = 0;
+    for (auto it = bids_.begin(); it != bids_.end() && it->first >= low; ++it) {
+        auctionBids_.push_back({bidTick(it->first, tickSize_), it->second.totalQuantity});
+        demand += it->second.totalQuantity;
+    }
+    std::reverse(auctionBids_.begin(), auctionBids_.end());
+    for (auto it = asks_.begin(); it != asks_.end() && it->first <= high; ++it) {
+        auctionAsks_.push_back({askTick(it->first, tickSize_), it->second.totalQuantity});
+    }
+    
+    const double lowTick = auctionAsks_.front().tick;
+    const double highTick = auctionBids_.back().tick;
+    if (lowTick > highTick) {
+        return result; // crossed only within a tick
+    }
+    for (const auto* levels : {&auctionBids_, &auctionAsks_}) {
+        for (const auto& level : *levels) {
+            if (level.tick >= lowTick && level.tick <= highTick) {
+                auctionTicks_.push_back(level.tick);
             }
         }
+    }
+    std::sort(auctionTicks_.begin(), auctionTicks_.end());
+    auctionTicks_.erase(std::unique(auctionTicks_.begin(), auctionTicks_.end()), auctionTicks_.end());
+    
+    // Executable volume only changes at a level's tick, so each one stands for
+    // the run of ticks up to the next, priced at the run's tick nearest the
+    // reference. Going up, supply (asks at or below) accumulates while demand
+    // (bids at or above) sheds the bids below.
+    const Price reference = lastTradePrice_ > 0.0 ? lastTradePrice_ : (low + high) / 2.0;
+    const double referenceTick = std::round(reference / tickSize_);
+    Quantity supply = 0;
+    size_t nextBid = 0;
+    size_t nextAsk = 0;
+    for (size_t i = 0; i < auctionTicks_.size(); ++i) {
+        const double tick = auctionTicks_[i];
+        while (nextAsk < auctionAsks_.size() && auctionAsks_[nextAsk].tick <= tick) {
+            supply += auctionAsks_[nextAsk++].quantity;
+        }
+        while (nextBid < auctionBids_.size() && auctionBids_[nextBid].tick < tick) {
+            demand -= auctionBids_[nextBid++].quantity;
+        }
+        
+        const double runEnd = i + 1 < auctionTicks_.size() ? auctionTicks_[i + 1] - 1 : tick;
+        const Price price = std::clamp(referenceTick, tick, runEnd) * tickSize_;
+        const Quantity volume = std::min(demand, supply);
+        const Quantity surplus = std::abs(demand - supply);
         
-        // If there's remaining quantity, add to order book
-        if (order->getRemainingQuantity() > 0) {
-            auto& priceLevel = asks_[order->price];
-            priceLevel.push_back(order);
-            orders_[order->orderId] = {order, --priceLevel.end()};
-            updateOrderStatus(order, OrderStatus::NEW);
+        const bool better = volume > result.indicativeVolume ||
+            (volume == result.indicativeVolume &&
+             (surplus < result.surplus ||
+              (surplus == result.surplus && std::abs(price - reference) < std::abs(result.indicativePrice - reference))));
+        if (better) {
+            result.indicativePrice = price;
+            result.indicativeVolume = volume;
+            result.surplus = surplus;
+            result.surplusSide = demand >= supply ? OrderSide::BUY : OrderSide::SELL;
+        }
+    }
+    return result;
+}
+
+void OrderBook::refreshIndicative() {
+    if (phase_ != TradingPhase::CALL_AUCTION) {
+        return;
+    }
+    auto update = equilibrium();
+    if (update != indicative_) {
+        indicative_ = update;
+        indicativeChanged_ = true;
+    }
+}
+
+bool OrderBook::drainAuctionUpdate(AuctionUpdate& out) {
+    if (!indicativeChanged_) {
+        return false;
+    }
+    out = indicative_;
+    indicativeChanged_ = false;
+    return true;
+}
+
+TradingPhase OrderBook::getPhase() const {
+    std::shared_lock lock(mutex_);
+    return phase_;
+}
+
+void OrderBook::setAllocation(const AllocationSettings& settings) {
+    std::unique_lock lock(mutex_);
+    allocation_ = settings;
+}
+
+void OrderBook::setTickSize(Price tickSize) {
+    std::unique_lock lock(mutex_);
+    tickSize_ = tickSize;
+}
+
+void OrderBook::recentreBand(Price lastPrice) {
+    if (bandPercent_ > 0.0) {
+        bandLower_ = lastPrice * (1.0 - bandPercent_);
+        bandUpper_ = lastPrice * (1.0 + bandPercent_);
+    }
+}
+
+void OrderBook::stopSweep(const OrderPtr& order) {
+    LOG_WARNING("{}: order {} stopped at price band [{}, {}] with {} left", symbol_, order->orderId,
+                bandLower_, bandUpper_, order->getRemainingQuantity());
+    
+    updateOrderStatus(order, OrderStatus::CANCELLED);
+    executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+    if (bandPause_.count() > 0) {
+        paused_ = true;
+        resumeAt_ = std::chrono::steady_clock::now() + bandPause_;
+    }
+}
+
+std::vector<Trade> OrderBook::matchLimitOrder(std::shared_ptr<Order> order) {
+    // A call collects orders, crossed or not, for the uncross
+    if (phase_ == TradingPhase::CALL_AUCTION) {
+        restOrder(order, order->side == OrderSide::BUY ? bids_[order->price] : asks_[order->price]);
+        return {};
+    }
+    
+    std::vector<Trade> trades;
+    sweep(order, bandedLimit(*order), trades);
+    
+    if (order->getRemainingQuantity() > 0) {
+        // Resting here would cross levels the band kept it from taking
+        if (crossesBook(*order)) {
+            stopSweep(order);
+        } else if (order->side == OrderSide::BUY) {
+            restOrder(order, bids_[order->price]);
+        } else {
+            restOrder(order, asks_[order->price]);
         }
     }
     
@@ -128,93 +583,290 @@ std::vector<Trade> OrderBook::matchLimitOrder(std::shared_ptr<Order> order) {
 
 std::vector<Trade> OrderBook::matchMarketOrder(std::shared_ptr<Order> order) {
     std::vector<Trade> trades;
+    sweep(order, bandedLimit(*order), trades);
     
-    if (order->side == OrderSide::BUY) {
-        // Match against asks (sell orders)
-        while (!asks_.empty() && order->getRemainingQuantity() > 0) {
-            auto bestAsk = asks_.begin();
-            auto& ordersAtPrice = bestAsk->second;
-            
-            while (!ordersAtPrice.empty() && order->getRemainingQuantity() > 0) {
-                auto matchingOrder = ordersAtPrice.front();
-                
-                Quantity tradeQuantity = std::min(
-                    order->getRemainingQuantity(),
-                    matchingOrder->getRemainingQuantity()
-                );
-                
-                Price tradePrice = matchingOrder->price;
-                
-                executeTrade(order, matchingOrder, tradeQuantity, tradePrice);
-                trades.emplace_back(order->orderId, matchingOrder->orderId, 
-                                  tradeQuantity, tradePrice, std::chrono::system_clock::now());
-                
-                if (matchingOrder->isFilled()) {
-                    ordersAtPrice.pop_front();
-                    removeOrder(matchingOrder->orderId);
-                }
-                
-                if (ordersAtPrice.empty()) {
-                    asks_.erase(bestAsk);
-                    break;
-                }
-            }
+    if (order->getRemainingQuantity() > 0 && crossesBook(*order)) {
+        stopSweep(order);
+        return trades;
+    }
+    
+    // Market orders are never added to the book
+    if (order->getRemainingQuantity() > 0) {
+        updateOrderStatus(order, OrderStatus::PARTIAL);
+    } else {
+        updateOrderStatus(order, OrderStatus::FILLED);
+    }
+    
+    return trades;
+}
+
+std::vector<Trade> OrderBook::matchFOKOrder(std::shared_ptr<Order> order) {
+    // Decided from level totals before any order is touched, so a kill costs
+    // O(levels crossed) and leaves the book exactly as it was. Only liquidity
+    // inside the band counts: a fill-or-kill is never stopped part way.
+    if (!canFill(*order, bandedLimit(*order))) {
+        updateOrderStatus(order, OrderStatus::CANCELLED);
+        executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+        return {};
+    }
+    
+    std::vector<Trade> trades;
+    sweep(order, bandedLimit(*order), trades);
+    return trades;
+}
+
+std::vector<Trade> OrderBook::matchIOCOrder(std::shared_ptr<Order> order) {
+    std::vector<Trade> trades;
+    sweep(order, bandedLimit(*order), trades);
+    
+    if (order->getRemainingQuantity() > 0) {
+        if (crossesBook(*order)) {
+            stopSweep(order);
+        } else {
+            updateOrderStatus(order, OrderStatus::CANCELLED);
+            executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+        }
+    }
+    
+    return trades;
+}
+
+// Price-time: the level's queue in order, the continuous loop itself
+struct OrderBook::FifoAllocation {
+    static void fill(OrderBook& book, const OrderPtr& order, PriceLevelQueue& level, std::vector<Trade>& trades) {
+        book.fillAtLevel(order, level, trades);
+    }
+};
+
+// In proportion to displayed size, rounded down; shares under the minimum
+// drop to nothing and what rounding and the minimum leave goes in time priority
+struct OrderBook::ProRataAllocation {
+    static void fill(OrderBook& book, const OrderPtr& order, PriceLevelQueue& level, std::vector<Trade>& trades) {
+        const Quantity incoming = order->getRemainingQuantity();
+        if (incoming >= level.visibleQuantity) {
+            book.fillAtLevel(order, level, trades); // takes the whole level: nothing to share
+            return;
         }
         
-        // Market orders are never added to the book
-        if (order->getRemainingQuantity() > 0) {
-            updateOrderStatus(order, OrderStatus::PARTIAL);
-        } else {
-            updateOrderStatus(order, OrderStatus::FILLED);
+        auto& shares = book.shares_;
+        shares.clear();
+        Quantity left = incoming;
+        for (const auto& resting : level.orders) {
+            auto share = static_cast<Quantity>(static_cast<double>(incoming) * displayedQuantity(*resting) /
+                                               static_cast<double>(level.visibleQuantity));
+            share = share >= book.allocation_.minimumAllocation ? std::min(share, left) : 0;
+            shares.push_back(share);
+            left -= share;
+        }
+        size_t index = 0;
+        for (auto it = level.orders.begin(); left > 0 && it != level.orders.end(); ++it, ++index) {
+            Quantity extra = std::min(displayedQuantity(**it) - shares[index], left);
+            shares[index] += extra;
+            left -= extra;
         }
         
-    } else { // SELL
-        // Match against bids (buy orders)
-        while (!bids_.empty() && order->getRemainingQuantity() > 0) {
-            auto bestBid = bids_.begin();
-            auto& ordersAtPrice = bestBid->second;
-            
-            while (!ordersAtPrice.empty() && order->getRemainingQuantity() > 0) {
-                auto matchingOrder = ordersAtPrice.front();
-                
-                Quantity tradeQuantity = std::min(
-                    order->getRemainingQuantity(),
-                    matchingOrder->getRemainingQuantity()
-                );
-                
-                Price tradePrice = matchingOrder->price;
-                
-                executeTrade(matchingOrder, order, tradeQuantity, tradePrice);
-                trades.emplace_back(matchingOrder->orderId, order->orderId, 
-                                  tradeQuantity, tradePrice, std::chrono::system_clock::now());
-                
-                if (matchingOrder->isFilled()) {
-                    ordersAtPrice.pop_front();
-                    removeOrder(matchingOrder->orderId);
-                }
-                
-                if (ordersAtPrice.empty()) {
-                    bids_.erase(bestBid);
-                    break;
-                }
+        // In queue order: a fill only ever moves the order it fills, to the back
+        auto it = level.orders.begin();
+        for (size_t i = 0, n = shares.size(); i < n; ++i) {
+            auto position = it++;
+            if (shares[i] > 0) {
+                book.fillResting(order, level, position, shares[i], trades);
             }
         }
+    }
+};
+
+// The lead market maker's orders take its share of what reaches the level,
+// in time order among themselves, then the level fills price-time as usual
+struct OrderBook::LeadMarketMakerAllocation {
+    static void fill(OrderBook& book, const OrderPtr& order, PriceLevelQueue& level, std::vector<Trade>& trades) {
+        const auto& settings = book.allocation_;
+        auto lead = static_cast<Quantity>(static_cast<double>(order->getRemainingQuantity()) * settings.leadShare);
+        for (auto it = level.orders.begin(); lead > 0 && it != level.orders.end();) {
+            auto position = it++;
+            if ((*position)->userId == settings.leadMarketMaker) {
+                Quantity quantity = std::min(lead, displayedQuantity(**position));
+                lead -= quantity;
+                book.fillResting(order, level, position, quantity, trades);
+            }
+        }
+        book.fillAtLevel(order, level, trades);
+    }
+};
+
+void OrderBook::sweep(const OrderPtr& order, Price limit, std::vector<Trade>& trades) {
+    // Resolved once per order, not per fill
+    switch (allocation_.algorithm) {
+        case MatchingAlgorithm::PRO_RATA:
+            sweepWith<ProRataAllocation>(order, limit, trades);
+            break;
+        case MatchingAlgorithm::FIFO_LMM:
+            sweepWith<LeadMarketMakerAllocation>(order, limit, trades);
+            break;
+        default:
+            sweepWith<FifoAllocation>(order, limit, trades);
+            break;
+    }
+}
+
+template<typename Allocation>
+void OrderBook::sweepWith(const OrderPtr& order, Price limit, std::vector<Trade>& trades) {
+    if (order->side == OrderSide::BUY) {
+        sweepLevels<Allocation>(asks_, order, [limit](Price ask) { return ask <= limit; }, trades);
+    } else {
+        sweepLevels<Allocation>(bids_, order, [limit](Price bid) { return bid >= limit; }, trades);
+    }
+}
+
+template<typename Allocation, typename Tree, typename Crosses>
+void OrderBook::sweepLevels(Tree& tree, const OrderPtr& order, Crosses crosses, std::vector<Trade>& trades) {
+    // Each tree iterates best price first
+    while (!tree.empty() && order->getRemainingQuantity() > 0) {
+        auto best = tree.begin();
+        if (!crosses(best->first)) {
+            break; // No more matches possible
+        }
         
-        // Market orders are never added to the book
-        if (order->getRemainingQuantity() > 0) {
-            updateOrderStatus(order, OrderStatus::PARTIAL);
-        } else {
-            updateOrderStatus(order, OrderStatus::FILLED);
+        Allocation::fill(*this, order, best->second, trades);
+        if (best->second.orders.empty()) {
+            tree.erase(best);
+        }
+    }
+}
+
+bool OrderBook::canFill(const Order& order, Price limit) const {
+    Quantity available = 0;
+    const Quantity needed = order.getRemainingQuantity();
+    if (order.side == OrderSide::BUY) {
+        for (auto it = asks_.begin(); it != asks_.end() && it->first <= limit && available < needed; ++it) {
+            available += it->second.totalQuantity;
+        }
+    } else {
+        for (auto it = bids_.begin(); it != bids_.end() && it->first >= limit && available < needed; ++it) {
+            available += it->second.totalQuantity;
         }
     }
+    return available >= needed;
+}
+
+Price OrderBook::bandedLimit(const Order& order) const {
+    // The band caps a sweep like a tighter limit price
+    return order.side == OrderSide::BUY ? std::min(order.price, bandUpper_) : std::max(order.price, bandLower_);
+}
+
+bool OrderBook::crossesBook(const Order& order) const {
+    return order.side == OrderSide::BUY ? !asks_.empty() && asks_.begin()->first <= order.price
+                                        : !bids_.empty() && bids_.begin()->first >= order.price;
+}
+
+void OrderBook::fillAtLevel(const OrderPtr& order, PriceLevelQueue& level, std::vector<Trade>& trades) {
+    const bool buy = order->side == OrderSide::BUY;
     
-    return trades;
+    while (!level.orders.empty() && order->getRemainingQuantity() > 0) {
+        const auto& matchingOrder = level.orders.front();
+        
+        // Against an iceberg only its displayed peak is available
+        Quantity tradeQuantity = std::min(order->getRemainingQuantity(), displayedQuantity(*matchingOrder));
+        Price tradePrice = matchingOrder->price; // Price is set by existing order
+        
+        trades.push_back(buy ? executeTrade(order, matchingOrder, tradeQuantity, tradePrice)
+                             : executeTrade(matchingOrder, order, tradeQuantity, tradePrice));
+        level.visibleQuantity -= tradeQuantity;
+        level.totalQuantity -= tradeQuantity;
+        
+        if (matchingOrder->isFilled()) {
+            OrderId filledId = matchingOrder->orderId;
+            level.orders.pop_front();
+            removeOrder(filledId);
+        } else if (matchingOrder->type == OrderType::ICEBERG) {
+            matchingOrder->visibleQuantity -= tradeQuantity;
+            if (matchingOrder->visibleQuantity == 0) {
+                // Peak consumed: show the next one at the back of the level. splice
+                // relinks the node, so the order's stored iterator stays valid.
+                matchingOrder->visibleQuantity = std::min(matchingOrder->peakSize, matchingOrder->getRemainingQuantity());
+                level.visibleQuantity += matchingOrder->visibleQuantity;
+                level.orders.splice(level.orders.end(), level.orders, level.orders.begin());
+            }
+        }
+    }
+}
+
+void OrderBook::fillResting(const OrderPtr& order, PriceLevelQueue& level, std::list<OrderPtr>::iterator position,
+                            Quantity quantity, std::vector<Trade>& trades) {
+    // One fill of no more than the resting order displays, out of queue order
+    const auto& resting = *position;
+    trades.push_back(order->side == OrderSide::BUY ? executeTrade(order, resting, quantity, resting->price)
+                                                   : executeTrade(resting, order, quantity, resting->price));
+    level.visibleQuantity -= quantity;
+    level.totalQuantity -= quantity;
+    
+    if (resting->isFilled()) {
+        OrderId filledId = resting->orderId;
+        level.orders.erase(position);
+        removeOrder(filledId);
+    } else if (resting->type == OrderType::ICEBERG) {
+        resting->visibleQuantity -= quantity;
+        if (resting->visibleQuantity == 0) {
+            resting->visibleQuantity = std::min(resting->peakSize, resting->getRemainingQuantity());
+            level.visibleQuantity += resting->visibleQuantity;
+            level.orders.splice(level.orders.end(), level.orders, position);
+        }
+    }
+}
+
+void OrderBook::restOrder(const OrderPtr& order, PriceLevelQueue& level) {
+    if (order->type == OrderType::ICEBERG) {
+        if (order->peakSize <= 0) {
+            order->peakSize = order->quantity;
+        }
+        order->visibleQuantity = std::min(order->peakSize, order->getRemainingQuantity());
+    }
+    
+    level.orders.push_back(order);
+    level.visibleQuantity += displayedQuantity(*order);
+    level.totalQuantity += order->getRemainingQuantity();
+    auto& entry = orders_[order->orderId];
+    entry.order = order;
+    entry.iterator = --level.orders.end();
+    entry.level = &level;
+    chainEntry(entry);
+    updateOrderStatus(order, OrderStatus::NEW);
+}
+
+Quantity OrderBook::displayedQuantity(const Order& order) {
+    return order.type == OrderType::ICEBERG ? order.visibleQuantity : order.getRemainingQuantity();
+}
+
+OrderBook::Depth OrderBook::getDepth(uint8_t levels) const {
+    std::shared_lock lock(mutex_);
+    
+    // Level quantities are maintained as visible only: iceberg reserves never show
+    Depth depth;
+    for (auto it = bids_.begin(); it != bids_.end() && depth.bids.size() < levels; ++it) {
+        depth.bids.push_back(PriceLevel{it->first, it->second.visibleQuantity, it->second.orders.size()});
+    }
+    for (auto it = asks_.begin(); it != asks_.end() && depth.asks.size() < levels; ++it) {
+        depth.asks.push_back(PriceLevel{it->first, it->second.visibleQuantity, it->second.orders.size()});
+    }
+    return depth;
 }
 
-void OrderBook::executeTrade(std::shared_ptr<Order> buyOrder, std::shared_ptr<Order> sellOrder, 
-                            Quantity quantity, Price price) {
+void OrderBook::getTopOfBook(TopOfBook& out) const {
+    std::shared_lock lock(mutex_);
+    
+    out.bidPrice = bids_.empty() ? 0.0 : bids_.begin()->first;
+    out.bidQuantity = bids_.empty() ? 0 : bids_.begin()->second.visibleQuantity;
+    out.askPrice = asks_.empty() ? 0.0 : asks_.begin()->first;
+    out.askQuantity = asks_.empty() ? 0 : asks_.begin()->second.visibleQuantity;
+    out.lastPrice = lastTradePrice_;
+}
+
+Trade OrderBook::executeTrade(std::shared_ptr<Order> buyOrder, std::shared_ptr<Order> sellOrder, 
+                             Quantity quantity, Price price) {
     buyOrder->filledQuantity += quantity;
     sellOrder->filledQuantity += quantity;
+    buyOrder->filledNotional += price * static_cast<double>(quantity);
+    sellOrder->filledNotional += price * static_cast<double>(quantity);
     
     totalVolume_ += quantity;
     
@@ -229,6 +881,166 @@ void OrderBook::executeTrade(std::shared_ptr<Order> buyOrder, std::shared_ptr<Or
     } else {
         updateOrderStatus(sellOrder, OrderStatus::PARTIAL);
     }
+    
+    // One report per side per trade, carrying the actual execution price
+    executionEvents_.push_back(ExecutionEvent::fromOrder(
+        *buyOrder, buyOrder->isFilled() ? ExecType::FILL : ExecType::PARTIAL_FILL, quantity, price));
+    executionEvents_.push_back(ExecutionEvent::fromOrder(
+        *sellOrder, sellOrder->isFilled() ? ExecType::FILL : ExecType::PARTIAL_FILL, quantity, price));
+    
+    return Trade(++lastTradeId_, symbol_, buyOrder->orderId, sellOrder->orderId,
+                 buyOrder->userId, sellOrder->userId, quantity, price,
+                 std::chrono::duration_cast<Timestamp>(std::chrono::system_clock::now().time_since_epoch()));
+}
+
+bool OrderBook::cancelOrder(OrderId orderId) {
+    std::unique_lock lock(mutex_);
+    
+    if (auto stop = stopOrders_.find(orderId); stop != stopOrders_.end()) {
+        cancelEntry(stop->second);
+        return true;
+    }
+    
+    auto it = orders_.find(orderId);
+    if (it == orders_.end()) {
+        return false;
+    }
+    
+    cancelEntry(it->second);
+    refreshIndicative();
+    return true;
+}
+
+bool OrderBook::cancelOrder(OrderId orderId, UserId userId, uint32_t sessionIndex) {
+    std::unique_lock lock(mutex_);
+    
+    auto owned = [&](const OrderEntry& entry) {
+        return entry.order->getUserId() == userId &&
+               (sessionIndex == 0 || entry.order->getSessionIndex() == sessionIndex);
+    };
+    
+    if (auto stop = stopOrders_.find(orderId); stop != stopOrders_.end()) {
+        if (!owned(stop->second)) {
+            return false;
+        }
+        cancelEntry(stop->second);
+        return true;
+    }
+    
+    auto it = orders_.find(orderId);
+    if (it == orders_.end() || !owned(it->second)) {
+        return false;
+    }
+    
+    cancelEntry(it->second);
+    refreshIndicative();
+    return true;
+}
+
+size_t OrderBook::cancelUserOrders(UserId userId) {
+    std::unique_lock lock(mutex_);
+    auto head = userOrders_.find(userId);
+    return head != userOrders_.end() ? cancelChain(head->second, &OrderEntry::byUser) : 0;
+}
+
+size_t OrderBook::cancelSessionOrders(uint32_t sessionIndex) {
+    std::unique_lock lock(mutex_);
+    auto head = sessionOrders_.find(sessionIndex);
+    return head != sessionOrders_.end() ? cancelChain(head->second, &OrderEntry::bySession) : 0;
+}
+
+size_t OrderBook::cancelChain(OrderEntry* head, OwnerLink OrderEntry::*link) {
+    // A cancel unchains and frees only its own entry, so the next link read
+    // before it stays valid
+    size_t cancelled = 0;
+    for (OrderEntry* entry = head; entry != nullptr; ++cancelled) {
+        OrderEntry* next = (entry->*link).next;
+        cancelEntry(*entry);
+        entry = next;
+    }
+    refreshIndicative();
+    return cancelled;
+}
+
+void OrderBook::cancelEntry(OrderEntry& entry) {
+    auto order = entry.order; // the entry goes with its map node
+    if (entry.level) {
+        unlinkOrder(entry);
+        removeOrder(order->orderId);
+    } else {
+        removeStop(order->orderId);
+    }
+    
+    updateOrderStatus(order, OrderStatus::CANCELLED);
+    executionEvents_.push_back(ExecutionEvent::fromOrder(*order, ExecType::CANCELLED));
+}
+
+void OrderBook::removeOrder(OrderId orderId) {
+    // Off the id index and the owner chains; the caller has taken it off its level
+    auto it = orders_.find(orderId);
+    if (it != orders_.end()) {
+        unchainEntry(it->second);
+        orders_.erase(it);
+    }
+}
+
+void OrderBook::chainEntry(OrderEntry& entry) {
+    // At the head, so a mass cancel reports the newest orders first
+    auto push = [&entry](OrderEntry*& head, OwnerLink OrderEntry::*link) {
+        (entry.*link).prev = nullptr;
+        (entry.*link).next = head;
+        if (head) {
+            (head->*link).prev = &entry;
+        }
+        head = &entry;
+    };
+    
+    push(userOrders_[entry.order->userId], &OrderEntry::byUser);
+    if (entry.order->sessionIndex != 0) {
+        push(sessionOrders_[entry.order->sessionIndex], &OrderEntry::bySession);
+    }
+}
+
+void OrderBook::unchainEntry(OrderEntry& entry) {
+    // Heads stay in their maps when a chain empties: owners come back
+    auto pop = [&entry](auto& heads, auto key, OwnerLink OrderEntry::*link) {
+        auto& own = entry.*link;
+        if (own.prev) {
+            (own.prev->*link).next = own.next;
+        } else {
+            heads.find(key)->second = own.next;
+        }
+        if (own.next) {
+            (own.next->*link).prev = own.prev;
+        }
+    };
+    
+    pop(userOrders_, entry.order->userId, &OrderEntry::byUser);
+    if (entry.order->sessionIndex != 0) {
+        pop(sessionOrders_, entry.order->sessionIndex, &OrderEntry::bySession);
+    }
+}
+
+void OrderBook::unlinkOrder(const OrderEntry& entry) {
+    // Off its level through the entry's handle; only a level that empties is
+    // looked up, to take it off the book
+    const Order& order = *entry.order;
+    auto& level = *entry.level;
+    level.visibleQuantity -= displayedQuantity(order);
+    level.totalQuantity -= order.getRemainingQuantity();
+    level.orders.erase(entry.iterator);
+    if (level.orders.empty()) {
+        if (order.side == OrderSide::BUY) {
+            bids_.erase(order.price);
+        } else {
+            asks_.erase(order.price);
+        }
+    }
+}
+
+void OrderBook::drainExecutionEvents(std::vector<ExecutionEvent>& out) {
+    out.insert(out.end(), executionEvents_.begin(), executionEvents_.end());
+    executionEvents_.clear();
 }
 
 // Implementation of other methods...
@@ -0,0 +1,137 @@
+// src/engine/ParentOrderManager.cpp
+#include "ParentOrderManager.hpp"
+#include "../utils/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace engine {
+
+bool ParentOrderManager::add(OrderPtr parent, const Schedule& schedule, int64_t startTick) {
+    const double totalWeight = std::accumulate(schedule.weights.begin(), schedule.weights.end(), 0.0);
+    if (schedule.weights.empty() || totalWeight <= 0.0 || parent->quantity <= 0 ||
+        (parent->type != OrderType::LIMIT && parent->type != OrderType::MARKET)) {
+        return false;
+    }
+    
+    ParentState state;
+    state.parent = parent;
+    state.startTick = startTick;
+    state.intervalMs = std::max<int64_t>(1, schedule.duration.count() / static_cast<int64_t>(schedule.weights.size()));
+    state.cumulativeWeights.reserve(schedule.weights.size());
+    double cumulative = 0.0;
+    for (double weight : schedule.weights) {
+        cumulative += std::max(0.0, weight);
+        state.cumulativeWeights.push_back(cumulative / totalWeight);
+    }
+    state.cumulativeWeights.back() = 1.0;
+    
+    return parents_.try_emplace(parent->orderId, std::move(state)).second;
+}
+
+OrderPtr ParentOrderManager::workingChild(OrderId parentId) const {
+    auto it = parents_.find(parentId);
+    return it != parents_.end() ? it->second.child : nullptr;
+}
+
+ParentOrderManager::Slice ParentOrderManager::releaseSlice(OrderId parentId, OrderId childId,
+                                                          std::vector<ExecutionEvent>& events) {
+    auto it = parents_.find(parentId);
+    if (it == parents_.end()) {
+        return {}; // cancelled since the slice was scheduled
+    }
+    
+    auto& state = it->second;
+    foldChild(state, events);
+    
+    const auto& parent = *state.parent;
+    if (parent.isFilled() || state.nextSlice == state.cumulativeWeights.size()) {
+        finish(state, events);
+        parents_.erase(it);
+        return {};
+    }
+    
+    // Catch up to the cumulative target, so an unfilled slice rolls forward
+    const Quantity target = state.nextSlice + 1 == state.cumulativeWeights.size()
+        ? parent.quantity
+        : static_cast<Quantity>(std::llround(state.cumulativeWeights[state.nextSlice] * parent.quantity));
+    const Quantity childQuantity = target - parent.filledQuantity;
+    ++state.nextSlice;
+    
+    Slice slice;
+    slice.nextTick = state.startTick + state.intervalMs * static_cast<int64_t>(state.nextSlice);
+    if (childQuantity > 0) {
+        slice.child = std::make_shared<Order>(childId, parent.userId, parent.symbol, parent.type,
+                                              parent.side, parent.price, childQuantity);
+        slice.child->parentId = parentId;
+        state.child = slice.child;
+    }
+    return slice;
+}
+
+bool ParentOrderManager::cancel(OrderId parentId, UserId userId, std::vector<ExecutionEvent>& events) {
+    auto it = parents_.find(parentId);
+    if (it == parents_.end() || it->second.parent->getUserId() != userId) {
+        return false;
+    }
+    
+    foldChild(it->second, events);
+    finish(it->second, events);
+    parents_.erase(it);
+    return true;
+}
+
+void ParentOrderManager::onChildFill(const ExecutionEvent& fill, std::vector<ExecutionEvent>& events) {
+    if (fill.execType != ExecType::FILL && fill.execType != ExecType::PARTIAL_FILL) {
+        return;
+    }
+    auto it = parents_.find(fill.parentId);
+    if (it == parents_.end() || !it->second.child || it->second.child->orderId != fill.orderId) {
+        return; // folded with its slice already
+    }
+    
+    auto& state = it->second;
+    const double notional = fill.lastPx * static_cast<double>(fill.lastQty);
+    state.childReported += fill.lastQty;
+    state.childReportedNotional += notional;
+    fold(state, fill.lastQty, notional, events);
+}
+
+void ParentOrderManager::fold(ParentState& state, Quantity quantity, double notional,
+                              std::vector<ExecutionEvent>& events) {
+    auto& parent = *state.parent;
+    parent.filledQuantity += quantity;
+    parent.filledNotional += notional;
+    parent.status = parent.isFilled() ? OrderStatus::FILLED : OrderStatus::PARTIAL;
+    events.push_back(ExecutionEvent::fromOrder(
+        parent, parent.isFilled() ? ExecType::FILL : ExecType::PARTIAL_FILL, quantity,
+        notional / static_cast<double>(quantity)));
+}
+
+void ParentOrderManager::foldChild(ParentState& state, std::vector<ExecutionEvent>& events) {
+    if (!state.child) {
+        return;
+    }
+    
+    // Whatever onChildFill did not see, in one report at its average price
+    const auto& child = *state.child;
+    const Quantity unreported = child.filledQuantity - state.childReported;
+    if (unreported > 0) {
+        fold(state, unreported, child.filledNotional - state.childReportedNotional, events);
+    }
+    state.child.reset();
+    state.childReported = 0;
+    state.childReportedNotional = 0.0;
+}
+
+void ParentOrderManager::finish(ParentState& state, std::vector<ExecutionEvent>& events) {
+    auto& parent = *state.parent;
+    if (!parent.isFilled()) {
+        parent.status = OrderStatus::CANCELLED;
+        events.push_back(ExecutionEvent::fromOrder(parent, ExecType::CANCELLED));
+    }
+    LOG_DEBUG("Parent order {} done: {} of {} filled over {} slices", parent.orderId, parent.filledQuantity,
+              parent.quantity, state.nextSlice);
+}
+
+} // namespace engine
\ No newline at end of file
@@ -1,10 +1,12 @@
 // src/engine/main.cpp (Enhanced)
 #include "MatchingEngine.hpp"
 #include "../networking/ZmqInterface.hpp"
+#include "../networking/ShmTransport.hpp"
 #include "../networking/FixAdapter.hpp"
+#include "../networking/StreamGateway.hpp"
 #include "../api/RestApi.hpp"
-#include "../risk/CircuitBreaker.hpp"
 #include "../feeds/WebSocketFeed.hpp"
+#include "../utils/ApiKeys.hpp"
 #include "../utils/Logger.hpp"
 #include "../utils/Config.hpp"
 #include <iostream>
@@ -36,21 +38,73 @@ int main(int argc, char* argv[]) {
         
         // Initialize core components
         auto matchingEngine = std::make_shared<engine::MatchingEngine>(config);
+        
+        networking::ZmqOptions zmqOptions;
+        zmqOptions.dispatchWorkers = config.get<int>("network.dispatch_workers", 0);
+        zmqOptions.maxDrainBatch = config.get<int>("network.max_drain_batch", 1024);
+        zmqOptions.ioThreads = config.get<int>("network.io_threads", 1);
+        zmqOptions.publisherShards = config.get<int>("network.publisher_shards", 1);
+        zmqOptions.publishEndpoints = config.getVector<std::string>("network.publish_endpoints");
+        
+        // "SYMBOL:shard" entries pin an instrument to a publisher shard
+        for (const auto& group : config.getVector<std::string>("network.instrument_groups")) {
+            auto colon = group.find(':');
+            if (colon != std::string::npos) {
+                zmqOptions.instrumentGroups[group.substr(0, colon)] = std::stoul(group.substr(colon + 1));
+            }
+        }
+        
         auto zmqInterface = std::make_shared<networking::ZmqInterface>(
             config.get<std::string>("network.publish_endpoint", "tcp://*:5555"),
-            config.get<std::string>("network.subscribe_endpoint", "tcp://*:5556")
+            config.get<std::string>("network.subscribe_endpoint", "tcp://*:5556"),
+            config.get<int>("engine.queue_size", 100000),
+            zmqOptions
         );
         
+        // Shared-memory rings for co-located strategies; bypasses the socket stack entirely
+        std::unique_ptr<networking::ShmTransport> shmTransport;
+        if (config.has("network.shm_enabled") && config.get<bool>("network.shm_enabled")) {
+            shmTransport = std::make_unique<networking::ShmTransport>(
+                config.get<std::string>("network.shm_name", "/order-matching-engine"),
+                networking::ShmTransport::Role::ENGINE
+            );
+        }
+        
+        // Client credentials of the REST API and stream order entry
+        auto apiKeys = std::make_shared<const utils::ApiKeys>(config.getVector<std::string>("api.keys"));
+        
+        // Order entry is identical for every transport (tcp, ipc, inproc, shm): the
+        // receive threads only decode and queue; acks, fills and book updates go
+        // out from the gateway's publisher thread
+        auto streamGateway = std::make_shared<networking::StreamGateway>(
+            matchingEngine, *zmqInterface, shmTransport.get(), apiKeys);
+        
+        zmqInterface->subscribe("orders", [streamGateway](std::string_view, std::string_view message) {
+            streamGateway->onOrderRequest(networking::StreamGateway::Transport::ZMQ, message);
+        });
+        zmqInterface->subscribe("quotes", [streamGateway](std::string_view, std::string_view message) {
+            streamGateway->onMassQuote(networking::StreamGateway::Transport::ZMQ, message);
+        });
+        
         auto riskEngine = std::make_shared<risk::RiskEngine>(config);
-        auto circuitBreaker = std::make_shared<risk::CircuitBreaker>(config);
         auto metrics = std::make_shared<monitoring::Metrics>(config);
         
         // Initialize FIX adapter if configured
         std::unique_ptr<networking::FixAdapter> fixAdapter;
         if (config.has("fix.enabled") && config.get<bool>("fix.enabled")) {
+            networking::FixAdapterOptions fixOptions;
+            fixOptions.nativeSession = config.get<bool>("fix.native_enabled", false);
+            fixOptions.nativePort = config.get<int>("fix.native_port", 9878);
+            fixOptions.senderCompId = config.get<std::string>("fix.sender_comp_id", "EXCHANGE");
+            fixOptions.logMessages = config.get<bool>("fix.log_messages", false);
+            fixOptions.mappedStore = config.get<std::string>("fix.message_store", "mapped") == "mapped";
+            fixOptions.storePath = config.get<std::string>("fix.store_path", "store");
+            fixOptions.cancelOnDisconnect = config.get<bool>("fix.cancel_on_disconnect", true);
+            
             fixAdapter = std::make_unique<networking::FixAdapter>(
                 matchingEngine, 
-                config.get<std::string>("fix.config_file", "config/fix.cfg")
+                config.get<std::string>("fix.config_file", "config/fix.cfg"),
+                fixOptions
             );
         }
         
@@ -59,7 +113,8 @@ int main(int argc, char* argv[]) {
             config.get<std::string>("api.address", "http://0.0.0.0:8080"),
             matchingEngine,
             metrics,
-            riskEngine
+            riskEngine,
+            apiKeys
         );
         
         // Initialize market data feed if configured
@@ -73,6 +128,18 @@ int main(int argc, char* argv[]) {
         LOG_INFO("Starting core components...");
         matchingEngine->start();
         zmqInterface->start();
+        
+        if (shmTransport) {
+            shmTransport->start([streamGateway](std::string_view topic, std::string_view message) {
+                if (topic == "quotes") {
+                    streamGateway->onMassQuote(networking::StreamGateway::Transport::SHM, message);
+                } else {
+                    streamGateway->onOrderRequest(networking::StreamGateway::Transport::SHM, message);
+                }
+            });
+        }
+        streamGateway->start();
+        
         metrics->startExposer(config.get<std::string>("monitoring.endpoint", "0.0.0.0:9090"));
         restApi->start();
         
@@ -126,6 +193,12 @@ int main(int argc, char* argv[]) {
         }
         
         restApi->stop();
+        streamGateway->stop();
+        
+        if (shmTransport) {
+            shmTransport->stop();
+        }
+        
         zmqInterface->stop();
         matchingEngine->stop();
         
@@ -1,18 +1,28 @@
 // src/networking/FixAdapter.cpp
 #include "FixAdapter.hpp"
+#include "MappedFixStore.hpp"
 #include "../utils/Logger.hpp"
 #include <quickfix/FileStore.h>
 #include <quickfix/SocketInitiator.h>
 #include <quickfix/SessionSettings.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
 
 namespace networking {
 
 FixAdapter::FixAdapter(std::shared_ptr<engine::MatchingEngine> engine, 
-                       const std::string& configFile)
+                       const std::string& configFile,
+                       FixAdapterOptions options)
     : engine_(engine)
     , configFile_(configFile)
+    , options_(std::move(options))
 {
-    LOG_INFO("FIX Adapter initialized with config: {}", configFile);
+    LOG_INFO("FIX Adapter initialized with config: {} ({} session layer)", configFile,
+             options_.nativeSession ? "native" : "QuickFIX");
 }
 
 FixAdapter::~FixAdapter() {
@@ -24,12 +34,24 @@ void FixAdapter::start() {
         return;
     }
     
+    executionReportThread_ = std::thread(&FixAdapter::runExecutionReports, this);
+    
     try {
-        FIX::SessionSettings settings(configFile_);
-        FIX::FileStoreFactory storeFactory(settings);
-        FIX::ScreenLogFactory logFactory(settings);
+        if (options_.nativeSession) {
+            startNative();
+            LOG_INFO("FIX Adapter started natively on port {}", options_.nativePort);
+            return;
+        }
+        
+        settings_ = std::make_unique<FIX::SessionSettings>(configFile_);
+        if (options_.mappedStore) {
+            storeFactory_ = std::make_unique<MappedFixStoreFactory>(*settings_);
+        } else {
+            storeFactory_ = std::make_unique<FIX::FileStoreFactory>(*settings_);
+        }
+        logFactory_ = std::make_unique<FIX::ScreenLogFactory>(*settings_);
         
-        initiator_ = std::make_unique<FIX::SocketInitiator>(*this, storeFactory, settings, logFactory);
+        initiator_ = std::make_unique<FIX::SocketInitiator>(*this, *storeFactory_, *settings_, *logFactory_);
         initiator_->start();
         
         LOG_INFO("FIX Adapter started successfully");
@@ -48,6 +70,24 @@ void FixAdapter::stop() {
         initiator_->stop();
     }
     
+    stopNative();
+    
+    if (executionReportThread_.joinable()) {
+        executionReportThread_.join();
+    }
+    
+    {
+        std::lock_guard lock(sessionsMutex_);
+        for (auto& slot : sessions_) {
+            if (slot && slot->sender.joinable()) {
+                slot->sender.join();
+            }
+            slot.reset();
+        }
+        quickfixSessions_.clear();
+        sessionCount_ = 1;
+    }
+    
     LOG_INFO("FIX Adapter stopped");
 }
 
@@ -57,10 +97,38 @@ void FixAdapter::onCreate(const FIX::SessionID& sessionID) {
 
 void FixAdapter::onLogon(const FIX::SessionID& sessionID) {
     LOG_INFO("FIX Session logon: {}", sessionID.toString());
+    
+    // A QuickFIX session keeps its index across reconnects so resting orders still route
+    std::lock_guard lock(sessionsMutex_);
+    auto it = quickfixSessions_.find(sessionID);
+    uint32_t index = it != quickfixSessions_.end() ? it->second : acquireSessionSlot(false);
+    if (index == 0) {
+        LOG_ERROR("FIX session table full, orders from {} will be rejected", sessionID.toString());
+        return;
+    }
+    
+    sessions_[index]->sessionID = sessionID;
+    sessions_[index]->active = true;
+    quickfixSessions_[sessionID] = index;
 }
 
 void FixAdapter::onLogout(const FIX::SessionID& sessionID) {
     LOG_INFO("FIX Session logout: {}", sessionID.toString());
+    
+    uint32_t index = 0;
+    {
+        std::lock_guard lock(sessionsMutex_);
+        auto it = quickfixSessions_.find(sessionID);
+        if (it != quickfixSessions_.end()) {
+            index = it->second;
+            sessions_[index]->active = false;
+        }
+    }
+    
+    // Outside the table lock: the cancels report back through this session's index
+    if (index != 0 && options_.cancelOnDisconnect) {
+        engine_->cancelSessionOrders(index);
+    }
 }
 
 void FixAdapter::toAdmin(FIX::Message& message, const FIX::SessionID& sessionID) {
@@ -83,14 +151,13 @@ void FixAdapter::fromApp(const FIX::Message& message, const FIX::SessionID& sess
 
 void FixAdapter::onMessage(const FIX42::NewOrderSingle& message, const FIX::SessionID& sessionID) {
     try {
-        LOG_INFO("Received NewOrderSingle: {}", message.toString());
-        
         // Extract FIX fields
         FIX::ClOrdID clOrdID;
         FIX::Symbol symbol;
         FIX::Side side;
         FIX::OrdType ordType;
         FIX::Price price;
+        FIX::StopPx stopPx;
         FIX::OrderQty orderQty;
         
         message.get(clOrdID);
@@ -102,58 +169,401 @@ void FixAdapter::onMessage(const FIX42::NewOrderSingle& message, const FIX::Sess
         if (ordType == FIX::OrdType_LIMIT || ordType == FIX::OrdType_STOP_LIMIT) {
             message.get(price);
         }
+        if (ordType == FIX::OrdType_STOP || ordType == FIX::OrdType_STOP_LIMIT) {
+            message.get(stopPx);
+        }
         
-        // Convert to internal order
-        auto order = std::make_shared<engine::Order>(
-            engine_->generateOrderId(),
-            1, // User ID from FIX session
+        uint32_t sessionIndex = findQuickfixSession(sessionID);
+        if (sessionIndex == 0) {
+            LOG_WARNING("NewOrderSingle from unregistered session {}", sessionID.toString());
+            return;
+        }
+        
+        OrderContext context{
+            clOrdID.getValue(),
             symbol.getValue(),
-            fixToOrderType(ordType),
-            fixToOrderSide(side),
+            side,
+            static_cast<engine::Quantity>(orderQty.getValue())
+        };
+        
+        submitNewOrder(
+            sessionIndex,
+            std::move(context),
+            ordType,
             (ordType == FIX::OrdType_LIMIT || ordType == FIX::OrdType_STOP_LIMIT) ? price.getValue() : 0.0,
-            orderQty.getValue()
+            (ordType == FIX::OrdType_STOP || ordType == FIX::OrdType_STOP_LIMIT) ? stopPx.getValue() : 0.0
         );
         
-        // Store session for this order
-        {
-            std::unique_lock lock(sessionsMutex_);
-            orderSessions_[order->getId()] = sessionID;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error processing NewOrderSingle: {}", e.what());
+    }
+}
+
+void FixAdapter::onMessage(const FIX42::OrderCancelRequest& message, const FIX::SessionID& sessionID) {
+    try {
+        FIX::OrderID orderID;
+        message.get(orderID);
+        
+        // Only this session's orders; the confirmation arrives through the execution event stream
+        uint32_t sessionIndex = findQuickfixSession(sessionID);
+        auto orderId = static_cast<engine::OrderId>(std::stoull(orderID.getValue()));
+        if (sessionIndex == 0 || !engine_->cancelOrder(orderId, FIX_USER_ID, sessionIndex)) {
+            sendOrderCancelReject(message, sessionID, "Unknown order");
         }
         
-        // Submit to matching engine
-        auto response = engine_->submitOrder(order);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error processing OrderCancelRequest: {}", e.what());
+    }
+}
+
+void FixAdapter::sendOrderCancelReject(const FIX42::OrderCancelRequest& request,
+                                       const FIX::SessionID& sessionID, const std::string& reason) {
+    FIX::OrderID orderID;
+    FIX::ClOrdID clOrdID;
+    FIX::OrigClOrdID origClOrdID;
+    request.get(orderID);
+    request.get(clOrdID);
+    request.get(origClOrdID);
+    
+    FIX42::OrderCancelReject reject(orderID, clOrdID, origClOrdID, FIX::OrdStatus(FIX::OrdStatus_REJECTED),
+                                    FIX::CxlRejResponseTo(FIX::CxlRejResponseTo_ORDER_CANCEL_REQUEST));
+    reject.set(FIX::Text(reason));
+    FIX::Session::sendToTarget(reject, sessionID);
+}
+
+void FixAdapter::onMessage(const FIX42::OrderCancelReplaceRequest& message, const FIX::SessionID& sessionID) {
+    try {
+        FIX::OrderID orderID;
+        FIX::ClOrdID clOrdID;
+        FIX::OrigClOrdID origClOrdID;
+        FIX::Symbol symbol;
+        FIX::OrderQty orderQty;
+        FIX::Price price;
         
-        // Send execution report
-        sendExecutionReport(*order, sessionID);
+        message.get(orderID);
+        message.get(clOrdID);
+        message.get(origClOrdID);
+        message.get(symbol);
+        message.get(orderQty);
+        message.get(price);
+        
+        uint32_t sessionIndex = findQuickfixSession(sessionID);
+        if (sessionIndex == 0) {
+            sendOrderCancelReject(message, sessionID, "Unknown order");
+            return;
+        }
+        
+        auto reason = submitReplace(sessionIndex, static_cast<engine::OrderId>(std::stoull(orderID.getValue())),
+                                    PendingReplace{clOrdID.getValue(), origClOrdID.getValue()}, symbol.getValue(),
+                                    static_cast<engine::Quantity>(orderQty.getValue()), price.getValue());
+        if (!reason.empty()) {
+            sendOrderCancelReject(message, sessionID, reason);
+        }
         
     } catch (const std::exception& e) {
-        LOG_ERROR("Error processing NewOrderSingle: {}", e.what());
+        LOG_ERROR("Error processing OrderCancelReplaceRequest: {}", e.what());
     }
 }
 
-void FixAdapter::sendExecutionReport(const engine::Order& order, const FIX::SessionID& sessionID) {
+void FixAdapter::sendOrderCancelReject(const FIX42::OrderCancelReplaceRequest& request,
+                                       const FIX::SessionID& sessionID, const std::string& reason) {
+    FIX::OrderID orderID;
+    FIX::ClOrdID clOrdID;
+    FIX::OrigClOrdID origClOrdID;
+    request.getFieldIfSet(orderID);
+    request.get(clOrdID);
+    request.get(origClOrdID);
+    
+    FIX42::OrderCancelReject reject(orderID, clOrdID, origClOrdID, FIX::OrdStatus(FIX::OrdStatus_REJECTED),
+                                    FIX::CxlRejResponseTo(FIX::CxlRejResponseTo_ORDER_CANCEL_REPLACE_REQUEST));
+    reject.set(FIX::Text(reason));
+    FIX::Session::sendToTarget(reject, sessionID);
+}
+
+void FixAdapter::sendOrderCancelReject(SessionSlot& slot, engine::OrderId orderId, std::string_view clOrdId,
+                                       std::string_view origClOrdId, char ordStatus, char responseTo,
+                                       std::string_view reason) {
+    if (slot.native) {
+        if (auto session = slot.nativeSession.load()) {
+            session->sendMessage("9", [&](FixMessageBuilder& builder) {
+                builder.add(37, static_cast<int64_t>(orderId))
+                       .add(11, clOrdId)
+                       .add(41, origClOrdId)
+                       .add(39, ordStatus)
+                       .add(434, responseTo)
+                       .add(58, reason);
+            });
+        }
+        return;
+    }
+    
     try {
+        FIX42::OrderCancelReject reject(FIX::OrderID(std::to_string(orderId)), FIX::ClOrdID(std::string(clOrdId)),
+                                        FIX::OrigClOrdID(std::string(origClOrdId)), FIX::OrdStatus(ordStatus),
+                                        FIX::CxlRejResponseTo(responseTo));
+        reject.set(FIX::Text(std::string(reason)));
+        FIX::Session::sendToTarget(reject, slot.sessionID);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error sending order cancel reject: {}", e.what());
+    }
+}
+
+uint32_t FixAdapter::acquireSessionSlot(bool native) {
+    if (native) {
+        for (uint32_t i = 1; i < sessionCount_; ++i) {
+            auto& slot = sessions_[i];
+            if (slot->native && !slot->active && slot->openOrders.load() == 0) {
+                std::lock_guard lock(slot->replacesMutex);
+                slot->replaces.clear(); // left over from the last connection
+                nativeSlots_.erase(slot->counterparty);
+                slot->counterparty.clear();
+                return i;
+            }
+        }
+    }
+    
+    if (sessionCount_ == MAX_SESSIONS) {
+        return 0;
+    }
+    
+    uint32_t index = sessionCount_++;
+    auto slot = std::make_unique<SessionSlot>();
+    slot->native = native;
+    slot->orders.resize(MAX_OPEN_ORDERS_PER_SESSION);
+    for (uint32_t i = 0; i < MAX_OPEN_ORDERS_PER_SESSION; ++i) {
+        slot->freeOrders.push(i);
+    }
+    slot->sender = std::thread(&FixAdapter::runSessionSender, this, std::ref(*slot));
+    sessions_[index] = std::move(slot);
+    return index;
+}
+
+uint32_t FixAdapter::findQuickfixSession(const FIX::SessionID& sessionID) {
+    std::lock_guard lock(sessionsMutex_);
+    auto it = quickfixSessions_.find(sessionID);
+    return it != quickfixSessions_.end() ? it->second : 0;
+}
+
+void FixAdapter::submitNewOrder(uint32_t sessionIndex, OrderContext context, char fixOrdType, double price,
+                                double stopPrice) {
+    auto& slot = *sessions_[sessionIndex];
+    
+    // Convert to internal order
+    auto order = std::make_shared<engine::Order>(
+        engine_->generateOrderId(),
+        FIX_USER_ID,
+        context.symbol,
+        fixToOrderType(fixOrdType),
+        fixToOrderSide(context.side),
+        price,
+        context.orderQty
+    );
+    order->setStopPrice(stopPrice);
+    
+    uint32_t orderSlot = slot.spareOrder;
+    if (orderSlot != NO_ORDER_SLOT) {
+        slot.spareOrder = NO_ORDER_SLOT;
+    } else if (auto freeSlot = slot.freeOrders.pop()) {
+        orderSlot = *freeSlot;
+    } else {
+        LOG_WARNING("Session {} has {} open orders, rejecting order {}",
+                   sessionIndex, MAX_OPEN_ORDERS_PER_SESSION, order->getId());
+        order->setStatus(engine::OrderStatus::REJECTED);
+        sendExecutionReport(engine::ExecutionEvent::fromOrder(*order, engine::ExecType::REJECTED), slot, context);
+        return;
+    }
+    
+    // The context must be in place before the engine can emit the first event for this order
+    order->setSessionRoute(sessionIndex, orderSlot);
+    slot.orders[orderSlot] = std::move(context);
+    slot.openOrders.fetch_add(1);
+    
+    if (!engine_->enqueueOrder(order)) {
+        LOG_WARNING("Order queue full, rejecting order {}", order->getId());
+        
+        order->setStatus(engine::OrderStatus::REJECTED);
+        sendExecutionReport(engine::ExecutionEvent::fromOrder(*order, engine::ExecType::REJECTED),
+                            slot, slot.orders[orderSlot]);
+        
+        // Never reached the engine, so the sender will not return it; keep it for the next order
+        slot.spareOrder = orderSlot;
+        slot.openOrders.fetch_sub(1);
+    }
+}
+
+std::string FixAdapter::submitReplace(uint32_t sessionIndex, engine::OrderId orderId, PendingReplace replace,
+                                      const std::string& symbol, engine::Quantity orderQty, double price) {
+    auto& slot = *sessions_[sessionIndex];
+    {
+        std::lock_guard lock(slot.replacesMutex);
+        if (!slot.replaces.try_emplace(orderId, std::move(replace)).second) {
+            return "Replace already pending";
+        }
+    }
+    
+    // Only this session's orders; the outcome arrives through the execution event stream
+    if (!engine_->modifyOrder(orderId, FIX_USER_ID, symbol, orderQty, price, sessionIndex)) {
+        std::lock_guard lock(slot.replacesMutex);
+        slot.replaces.erase(orderId);
+        return "Unknown symbol or order queue full";
+    }
+    return {};
+}
+
+void FixAdapter::runExecutionReports() {
+    while (running_.load()) {
+        auto event = engine_->pollExecutionEvent();
+        if (!event) {
+            std::this_thread::yield();
+            continue;
+        }
+        
+        if (event->sessionIndex == 0) {
+            continue; // Not entered through FIX
+        }
+        
+        // Once spilling, every later event spills too, until the sender has caught up
+        auto& slot = *sessions_[event->sessionIndex];
+        if (slot.spilling.load(std::memory_order_acquire) || !slot.outbound.push(*event)) {
+            std::lock_guard lock(slot.spillMutex);
+            if (slot.spill.empty()) {
+                LOG_WARNING("FIX session {} is behind, spilling execution reports", event->sessionIndex);
+            }
+            slot.spill.push_back(*event);
+            ++slot.spilledReports;
+            slot.spilling.store(true, std::memory_order_release);
+        }
+    }
+}
+
+void FixAdapter::runSessionSender(SessionSlot& slot) {
+    std::deque<engine::ExecutionEvent> spilled;
+    
+    while (running_.load()) {
+        auto event = slot.outbound.pop();
+        if (event) {
+            deliverReport(slot, *event);
+            continue;
+        }
+        
+        // The ring is drained, so everything spilled comes next; the dispatcher
+        // does not use the ring again until the spill is empty
+        if (slot.spilling.load(std::memory_order_acquire)) {
+            uint64_t count = 0;
+            {
+                std::lock_guard lock(slot.spillMutex);
+                spilled.swap(slot.spill);
+                slot.spilling.store(false, std::memory_order_release);
+                count = std::exchange(slot.spilledReports, 0);
+            }
+            for (const auto& report : spilled) {
+                deliverReport(slot, report);
+            }
+            spilled.clear();
+            LOG_INFO("FIX session caught up after {} spilled execution reports", count);
+            continue;
+        }
+        
+        std::this_thread::yield();
+    }
+}
+
+void FixAdapter::deliverReport(SessionSlot& slot, const engine::ExecutionEvent& event) {
+    // The outcome of a cancel/replace answers the request in flight for the order
+    if (event.execType == engine::ExecType::REPLACED || event.execType == engine::ExecType::MODIFY_REJECTED) {
+        PendingReplace replace;
+        bool pending = false;
+        {
+            std::lock_guard lock(slot.replacesMutex);
+            if (auto it = slot.replaces.find(event.orderId); it != slot.replaces.end()) {
+                replace = std::move(it->second);
+                slot.replaces.erase(it);
+                pending = true;
+            }
+        }
+        
+        if (event.execType == engine::ExecType::MODIFY_REJECTED) {
+            // Nothing of the order is reported unless it is working and this session's
+            const bool working = event.leavesQty > 0;
+            const char ordStatus = !working ? FIX::OrdStatus_REJECTED
+                : event.cumQty > 0 ? FIX::OrdStatus_PARTIALLY_FILLED : FIX::OrdStatus_NEW;
+            if (pending) {
+                sendOrderCancelReject(slot, event.orderId, replace.clOrdId, replace.origClOrdId, ordStatus,
+                                      FIX::CxlRejResponseTo_ORDER_CANCEL_REPLACE_REQUEST,
+                                      working ? "Replace rejected" : "Unknown order");
+            }
+            return;
+        }
+        
+        if (pending) {
+            auto& context = slot.orders[event.sessionOrderSlot];
+            context.clOrdId = std::move(replace.clOrdId);
+            context.orderQty = event.orderQty;
+            sendExecutionReport(event, slot, context, replace.origClOrdId);
+            return;
+        }
+    }
+    
+    sendExecutionReport(event, slot, slot.orders[event.sessionOrderSlot]);
+    
+    if (event.execType == engine::ExecType::FILL ||
+        event.execType == engine::ExecType::CANCELLED ||
+        event.execType == engine::ExecType::REJECTED) {
+        slot.freeOrders.push(event.sessionOrderSlot);
+        slot.openOrders.fetch_sub(1);
+    }
+}
+
+void FixAdapter::sendExecutionReport(const engine::ExecutionEvent& event, SessionSlot& slot,
+                                     const OrderContext& context, std::string_view origClOrdId) {
+    try {
+        char execType = execTypeToFix(event.execType);
+        
+        if (slot.native) {
+            auto session = slot.nativeSession.load();
+            if (!session) {
+                return; // Connection already gone
+            }
+            
+            networking::ExecutionReportFields fields{};
+            fields.execId = event.execId;
+            fields.execType = execType;
+            fields.ordStatus = execType;
+            fields.lastQty = event.lastQty;
+            fields.lastPx = event.lastPx;
+            fields.leavesQty = event.leavesQty;
+            fields.cumQty = event.cumQty;
+            fields.avgPx = event.avgPx;
+            
+            session->sendExecutionReport(event.orderId, context.clOrdId, context.symbol,
+                                         context.side, context.orderQty, fields, origClOrdId);
+            return;
+        }
+        
         FIX42::ExecutionReport executionReport;
         
-        executionReport.set(FIX::OrderID(std::to_string(order.getId())));
-        executionReport.set(FIX::ExecID(std::to_string(engine_->generateTradeId())));
+        executionReport.set(FIX::OrderID(std::to_string(event.orderId)));
+        executionReport.set(FIX::ExecID(std::to_string(event.execId)));
         executionReport.set(FIX::ExecTransType(FIX::ExecTransType_NEW));
-        executionReport.set(FIX::ExecType(orderStatusToFix(order.getStatus())));
-        executionReport.set(FIX::OrdStatus(orderStatusToFix(order.getStatus())));
-        executionReport.set(FIX::Symbol(order.getSymbol()));
-        executionReport.set(FIX::Side(orderSideToFix(order.getSide())));
-        executionReport.set(FIX::OrderQty(order.getQuantity()));
-        executionReport.set(FIX::LastQty(order.getFilledQuantity()));
-        executionReport.set(FIX::LastPx(0.0)); // Would be actual fill price
-        executionReport.set(FIX::LeavesQty(order.getRemainingQuantity()));
-        executionReport.set(FIX::CumQty(order.getFilledQuantity()));
-        executionReport.set(FIX::AvgPx(0.0)); // Would be average fill price
-        
-        executionReport.set(FIX::ClOrdID(std::to_string(order.getId())));
+        executionReport.set(FIX::ExecType(execType));
+        executionReport.set(FIX::OrdStatus(execType));
+        executionReport.set(FIX::Symbol(context.symbol));
+        executionReport.set(FIX::Side(context.side));
+        executionReport.set(FIX::OrderQty(context.orderQty));
+        executionReport.set(FIX::LastQty(event.lastQty));
+        executionReport.set(FIX::LastPx(event.lastPx));
+        executionReport.set(FIX::LeavesQty(event.leavesQty));
+        executionReport.set(FIX::CumQty(event.cumQty));
+        executionReport.set(FIX::AvgPx(event.avgPx));
+        
+        executionReport.set(FIX::ClOrdID(context.clOrdId));
+        if (!origClOrdId.empty()) {
+            executionReport.set(FIX::OrigClOrdID(std::string(origClOrdId)));
+        }
         executionReport.set(FIX::TransactTime(FIX::TransactTime()));
         
-        FIX::Session::sendToTarget(executionReport, sessionID);
-        logFIXMessage("OUT", executionReport);
+        // toApp() logs the outgoing message
+        FIX::Session::sendToTarget(executionReport, slot.sessionID);
         
     } catch (const std::exception& e) {
         LOG_ERROR("Error sending execution report: {}", e.what());
@@ -184,6 +594,8 @@ char FixAdapter::orderTypeToFix(engine::OrderType type) {
         case engine::OrderType::LIMIT: return FIX::OrdType_LIMIT;
         case engine::OrderType::FOK: return FIX::OrdType_LIMIT; // FIX doesn't have FOK directly
         case engine::OrderType::IOC: return FIX::OrdType_LIMIT; // FIX doesn't have IOC directly
+        case engine::OrderType::STOP: return FIX::OrdType_STOP;
+        case engine::OrderType::STOP_LIMIT: return FIX::OrdType_STOP_LIMIT;
         default: return FIX::OrdType_LIMIT;
     }
 }
@@ -192,6 +604,20 @@ char FixAdapter::orderSideToFix(engine::OrderSide side) {
     return (side == engine::OrderSide::BUY) ? FIX::Side_BUY : FIX::Side_SELL;
 }
 
+char FixAdapter::execTypeToFix(engine::ExecType type) {
+    // FIX 4.2 ExecType and OrdStatus share these values; NativeFixSession maps
+    // fills to 4.4's Trade itself
+    switch (type) {
+        case engine::ExecType::NEW: return FIX::ExecType_NEW;
+        case engine::ExecType::PARTIAL_FILL: return FIX::ExecType_PARTIAL_FILL;
+        case engine::ExecType::FILL: return FIX::ExecType_FILL;
+        case engine::ExecType::CANCELLED: return FIX::ExecType_CANCELED;
+        case engine::ExecType::REJECTED: return FIX::ExecType_REJECTED;
+        case engine::ExecType::REPLACED: return FIX::ExecType_REPLACE;
+        default: return FIX::ExecType_NEW;
+    }
+}
+
 char FixAdapter::orderStatusToFix(engine::OrderStatus status) {
     switch (status) {
         case engine::OrderStatus::NEW: return FIX::OrdStatus_NEW;
@@ -204,7 +630,214 @@ char FixAdapter::orderStatusToFix(engine::OrderStatus status) {
 }
 
 void FixAdapter::logFIXMessage(const std::string& direction, const FIX::Message& message) {
+    // toString() re-serializes the whole message; only pay for it when asked to
+    if (!options_.logMessages) {
+        return;
+    }
     LOG_DEBUG("FIX {}: {}", direction, message.toString());
 }
 
+void FixAdapter::startNative() {
+    nativeListenSocket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (nativeListenSocket_ < 0) {
+        throw std::runtime_error("Failed to create native FIX listen socket");
+    }
+    
+    int reuse = 1;
+    setsockopt(nativeListenSocket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(static_cast<uint16_t>(options_.nativePort));
+    
+    if (::bind(nativeListenSocket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(nativeListenSocket_, 16) < 0) {
+        ::close(nativeListenSocket_);
+        nativeListenSocket_ = -1;
+        throw std::runtime_error("Failed to listen on native FIX port " + std::to_string(options_.nativePort));
+    }
+    
+    nativeAcceptorThread_ = std::thread(&FixAdapter::runNativeAcceptor, this);
+}
+
+void FixAdapter::stopNative() {
+    if (nativeAcceptorThread_.joinable()) {
+        nativeAcceptorThread_.join();
+    }
+    
+    {
+        std::lock_guard lock(nativeConnectionsMutex_);
+        for (auto& connection : nativeConnections_) {
+            connection.session->stop();
+        }
+        for (auto& connection : nativeConnections_) {
+            if (connection.thread.joinable()) {
+                connection.thread.join();
+            }
+        }
+        nativeConnections_.clear();
+    }
+    
+    if (nativeListenSocket_ >= 0) {
+        ::close(nativeListenSocket_);
+        nativeListenSocket_ = -1;
+    }
+}
+
+void FixAdapter::runNativeAcceptor() {
+    pollfd item{nativeListenSocket_, POLLIN, 0};
+    
+    while (running_.load()) {
+        if (::poll(&item, 1, 100) <= 0) {
+            continue;
+        }
+        
+        int socket = ::accept(nativeListenSocket_, nullptr, nullptr);
+        if (socket < 0) {
+            continue;
+        }
+        
+        int noDelay = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        
+        std::lock_guard lock(nativeConnectionsMutex_);
+        
+        // Reap connections whose peer has gone away; their reader threads have
+        // already given up their slots
+        std::erase_if(nativeConnections_, [](NativeConnection& c) {
+            if (c.session->isRunning()) {
+                return false;
+            }
+            c.thread.join();
+            return true;
+        });
+        
+        // Messages are handed on only after Logon, which binds the slot first
+        auto binding = std::make_shared<NativeBinding>();
+        auto session = std::make_shared<NativeFixSession>(
+            socket, options_.senderCompId,
+            [this, binding](NativeFixSession& s, const FixMessageView& message) {
+                onNativeMessage(binding->sessionIndex, s, message);
+            },
+            options_.storePath,
+            [this, binding](NativeFixSession&) { return bindNativeSession(*binding); });
+        binding->session = session;
+        
+        auto& connection = nativeConnections_.emplace_back();
+        connection.session = std::move(session);
+        connection.binding = binding;
+        connection.thread = std::thread([this, binding, session = connection.session.get()] {
+            session->run();
+            unbindNativeSession(*binding);
+            if (binding->sessionIndex != 0 && options_.cancelOnDisconnect) {
+                engine_->cancelSessionOrders(binding->sessionIndex);
+            }
+        });
+    }
+}
+
+bool FixAdapter::bindNativeSession(NativeBinding& binding) {
+    auto session = binding.session.lock();
+    const auto& counterparty = session->getTargetCompId();
+    
+    std::lock_guard lock(sessionsMutex_);
+    uint32_t index = 0;
+    auto it = nativeSlots_.find(counterparty);
+    if (it != nativeSlots_.end()) {
+        index = it->second;
+        if (sessions_[index]->active) {
+            LOG_ERROR("Native FIX session {} is already logged on, refusing a second", counterparty);
+            return false;
+        }
+    } else {
+        index = acquireSessionSlot(true);
+        if (index == 0) {
+            LOG_ERROR("FIX session table full, refusing native session {}", counterparty);
+            return false;
+        }
+        nativeSlots_[counterparty] = index;
+        sessions_[index]->counterparty = counterparty;
+    }
+    
+    sessions_[index]->nativeSession.store(std::move(session));
+    sessions_[index]->active = true;
+    binding.sessionIndex = index;
+    return true;
+}
+
+void FixAdapter::unbindNativeSession(const NativeBinding& binding) {
+    if (binding.sessionIndex == 0) {
+        return; // never logged on
+    }
+    
+    // The slot stays bound to its counterparty, inactive, until it logs on again
+    std::lock_guard lock(sessionsMutex_);
+    auto& slot = *sessions_[binding.sessionIndex];
+    slot.active = false;
+    slot.nativeSession.store(nullptr);
+}
+
+void FixAdapter::onNativeMessage(uint32_t sessionIndex, NativeFixSession& session,
+                                 const FixMessageView& message) {
+    try {
+        if (options_.logMessages) {
+            LOG_DEBUG("FIX IN: {}", message.raw());
+        }
+        
+        auto msgType = message.getMsgType();
+        
+        if (msgType == "D") {
+            char ordType = message.getChar(40, FIX::OrdType_LIMIT);
+            bool hasPrice = ordType == FIX::OrdType_LIMIT || ordType == FIX::OrdType_STOP_LIMIT;
+            bool hasStop = ordType == FIX::OrdType_STOP || ordType == FIX::OrdType_STOP_LIMIT;
+            
+            OrderContext context{
+                std::string(message.get(11)),
+                std::string(message.get(55)),
+                message.getChar(54),
+                static_cast<engine::Quantity>(message.getDouble(38))
+            };
+            
+            submitNewOrder(sessionIndex, std::move(context), ordType, hasPrice ? message.getDouble(44) : 0.0,
+                           hasStop ? message.getDouble(99) : 0.0);
+            return;
+        }
+        
+        if (msgType == "F") {
+            auto orderId = static_cast<engine::OrderId>(message.getInt(37));
+            
+            // Only this session's orders; the confirmation arrives through the execution event stream
+            if (!engine_->cancelOrder(orderId, FIX_USER_ID, sessionIndex)) {
+                sendOrderCancelReject(*sessions_[sessionIndex], orderId, message.get(11), message.get(41),
+                                      FIX::OrdStatus_REJECTED, FIX::CxlRejResponseTo_ORDER_CANCEL_REQUEST,
+                                      "Unknown order");
+            }
+            return;
+        }
+        
+        if (msgType == "G") {
+            auto orderId = static_cast<engine::OrderId>(message.getInt(37));
+            auto clOrdId = message.get(11);
+            auto origClOrdId = message.get(41);
+            
+            std::string reason = message.get(44).empty() ? "Price required" : submitReplace(
+                sessionIndex, orderId, PendingReplace{std::string(clOrdId), std::string(origClOrdId)},
+                std::string(message.get(55)), static_cast<engine::Quantity>(message.getDouble(38)),
+                message.getDouble(44));
+            if (!reason.empty()) {
+                sendOrderCancelReject(*sessions_[sessionIndex], orderId, clOrdId, origClOrdId,
+                                      FIX::OrdStatus_REJECTED, FIX::CxlRejResponseTo_ORDER_CANCEL_REPLACE_REQUEST,
+                                      reason);
+            }
+            return;
+        }
+        
+        LOG_WARNING("Native FIX session {}: unsupported message type {}", session.getTargetCompId(), msgType);
+        
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error processing native FIX message: {}", e.what());
+    }
+}
+
 } // namespace networking
\ No newline at end of file
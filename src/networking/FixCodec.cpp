@@ -0,0 +1,224 @@
+// src/networking/FixCodec.cpp
+#include "FixCodec.hpp"
+#include <ctime>
+
+namespace networking {
+
+ptrdiff_t FixMessageView::frameLength(std::string_view buffer) {
+    // "8=FIX.x.y<SOH>9=<len><SOH>" + body + "10=nnn<SOH>"
+    if (buffer.size() < 2) {
+        return 0;
+    }
+    if (buffer.compare(0, 2, "8=") != 0) {
+        return -1;
+    }
+    
+    size_t beginEnd = buffer.find(FIX_SOH);
+    if (beginEnd == std::string_view::npos) {
+        return buffer.size() > 32 ? -1 : 0;
+    }
+    
+    size_t lengthStart = beginEnd + 1;
+    if (buffer.size() < lengthStart + 2) {
+        return 0;
+    }
+    if (buffer.compare(lengthStart, 2, "9=") != 0) {
+        return -1;
+    }
+    
+    size_t lengthEnd = buffer.find(FIX_SOH, lengthStart + 2);
+    if (lengthEnd == std::string_view::npos) {
+        return buffer.size() - lengthStart > 12 ? -1 : 0;
+    }
+    
+    size_t bodyLength = 0;
+    auto result = std::from_chars(buffer.data() + lengthStart + 2, buffer.data() + lengthEnd, bodyLength);
+    if (result.ec != std::errc() || result.ptr != buffer.data() + lengthEnd) {
+        return -1;
+    }
+    
+    constexpr size_t CHECKSUM_FIELD_SIZE = 7; // "10=nnn<SOH>"
+    size_t total = lengthEnd + 1 + bodyLength + CHECKSUM_FIELD_SIZE;
+    return buffer.size() < total ? 0 : static_cast<ptrdiff_t>(total);
+}
+
+bool FixMessageView::parse(std::string_view message) {
+    message_ = message;
+    fieldCount_ = 0;
+    tagIndex_.fill(0);
+    
+    size_t pos = 0;
+    size_t checksumStart = 0;
+    
+    while (pos < message.size()) {
+        uint32_t tag = 0;
+        while (pos < message.size() && message[pos] >= '0' && message[pos] <= '9') {
+            tag = tag * 10 + static_cast<uint32_t>(message[pos] - '0');
+            ++pos;
+        }
+        if (pos >= message.size() || message[pos] != '=' || tag == 0) {
+            return false;
+        }
+        
+        size_t valueStart = ++pos;
+        size_t valueEnd = message.find(FIX_SOH, valueStart);
+        if (valueEnd == std::string_view::npos || fieldCount_ == MAX_FIELDS) {
+            return false;
+        }
+        
+        if (tag == 10) {
+            checksumStart = valueStart - 3;
+        }
+        
+        fields_[fieldCount_] = {tag, static_cast<uint32_t>(valueStart),
+                                static_cast<uint32_t>(valueEnd - valueStart)};
+        if (tag < INDEXED_TAGS && tagIndex_[tag] == 0) {
+            tagIndex_[tag] = static_cast<uint8_t>(fieldCount_ + 1);
+        }
+        ++fieldCount_;
+        
+        pos = valueEnd + 1;
+    }
+    
+    if (checksumStart == 0) {
+        return false;
+    }
+    
+    return getInt(10, -1) == fixChecksum(message.data(), checksumStart);
+}
+
+std::string_view FixMessageView::get(uint32_t tag) const {
+    if (tag < INDEXED_TAGS) {
+        uint8_t index = tagIndex_[tag];
+        if (index == 0) {
+            return {};
+        }
+        const auto& field = fields_[index - 1];
+        return message_.substr(field.offset, field.length);
+    }
+    
+    for (size_t i = 0; i < fieldCount_; ++i) {
+        if (fields_[i].tag == tag) {
+            return message_.substr(fields_[i].offset, fields_[i].length);
+        }
+    }
+    
+    return {};
+}
+
+int64_t FixMessageView::getInt(uint32_t tag, int64_t defaultValue) const {
+    auto value = get(tag);
+    int64_t result = 0;
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    return (value.empty() || ec != std::errc()) ? defaultValue : result;
+}
+
+double FixMessageView::getDouble(uint32_t tag, double defaultValue) const {
+    auto value = get(tag);
+    double result = 0.0;
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    return (value.empty() || ec != std::errc()) ? defaultValue : result;
+}
+
+char FixMessageView::getChar(uint32_t tag, char defaultValue) const {
+    auto value = get(tag);
+    return value.empty() ? defaultValue : value[0];
+}
+
+FixMessageBuilder::FixMessageBuilder(char* buffer, size_t capacity, std::string_view beginString,
+                                     std::string_view msgType)
+    : buffer_(buffer)
+    , capacity_(capacity)
+{
+    append("8=");
+    append(beginString);
+    // BodyLength is written as 4 digits and patched in finish()
+    append("\x01" "9=0000\x01");
+    bodyStart_ = size_;
+    add(35, msgType);
+}
+
+FixMessageBuilder& FixMessageBuilder::add(uint32_t tag, std::string_view value) {
+    char tagBuffer[16];
+    auto result = std::to_chars(tagBuffer, tagBuffer + sizeof(tagBuffer), tag);
+    append(std::string_view(tagBuffer, result.ptr - tagBuffer));
+    append("=");
+    append(value);
+    append("\x01");
+    return *this;
+}
+
+FixMessageBuilder& FixMessageBuilder::add(uint32_t tag, int64_t value) {
+    char valueBuffer[24];
+    auto result = std::to_chars(valueBuffer, valueBuffer + sizeof(valueBuffer), value);
+    return add(tag, std::string_view(valueBuffer, result.ptr - valueBuffer));
+}
+
+FixMessageBuilder& FixMessageBuilder::add(uint32_t tag, char value) {
+    return add(tag, std::string_view(&value, 1));
+}
+
+std::string_view FixMessageBuilder::finish() {
+    size_t bodyLength = size_ - bodyStart_;
+    if (overflow_ || bodyLength > 9999) {
+        return {};
+    }
+    
+    char* lengthField = buffer_ + bodyStart_ - 5;
+    for (int i = 3; i >= 0; --i) {
+        lengthField[i] = static_cast<char>('0' + bodyLength % 10);
+        bodyLength /= 10;
+    }
+    
+    uint8_t checksum = fixChecksum(buffer_, size_);
+    char checksumField[] = "10=000\x01";
+    checksumField[3] = static_cast<char>('0' + checksum / 100);
+    checksumField[4] = static_cast<char>('0' + (checksum / 10) % 10);
+    checksumField[5] = static_cast<char>('0' + checksum % 10);
+    append(std::string_view(checksumField, 7));
+    
+    return overflow_ ? std::string_view() : std::string_view(buffer_, size_);
+}
+
+void FixMessageBuilder::append(std::string_view data) {
+    if (size_ + data.size() > capacity_) {
+        overflow_ = true;
+        return;
+    }
+    std::memcpy(buffer_ + size_, data.data(), data.size());
+    size_ += data.size();
+}
+
+void formatFixTimestamp(char* out, std::chrono::system_clock::time_point time) {
+    // The date/time prefix only changes once per second; cache it per thread
+    thread_local std::time_t cachedSecond = -1;
+    thread_local char cachedPrefix[18];
+    
+    auto sinceEpoch = time.time_since_epoch();
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch - seconds).count();
+    
+    std::time_t second = static_cast<std::time_t>(seconds.count());
+    if (second != cachedSecond) {
+        std::tm utc{};
+        gmtime_r(&second, &utc);
+        std::strftime(cachedPrefix, sizeof(cachedPrefix), "%Y%m%d-%H:%M:%S", &utc);
+        cachedSecond = second;
+    }
+    
+    std::memcpy(out, cachedPrefix, 17);
+    out[17] = '.';
+    out[18] = static_cast<char>('0' + millis / 100);
+    out[19] = static_cast<char>('0' + (millis / 10) % 10);
+    out[20] = static_cast<char>('0' + millis % 10);
+}
+
+uint8_t fixChecksum(const char* data, size_t size) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sum += static_cast<uint8_t>(data[i]);
+    }
+    return static_cast<uint8_t>(sum % 256);
+}
+
+} // namespace networking
@@ -0,0 +1,100 @@
+// src/networking/MappedFixStore.cpp
+#include "MappedFixStore.hpp"
+#include "../utils/Logger.hpp"
+
+namespace networking {
+
+MappedFixStore::MappedFixStore(const std::string& path, uint32_t indexCapacity, size_t dataCapacity)
+    : store_(path, indexCapacity, dataCapacity)
+{}
+
+bool MappedFixStore::set(int seqNum, const std::string& message) {
+    return store_.set(static_cast<uint64_t>(seqNum), message);
+}
+
+void MappedFixStore::get(int beginSeqNum, int endSeqNum, std::vector<std::string>& messages) const {
+    messages.clear();
+    store_.forEach(static_cast<uint64_t>(beginSeqNum), static_cast<uint64_t>(endSeqNum),
+                   [&messages](uint64_t, std::string_view message) {
+        // QuickFIX gap-fills whatever is missing from the returned range
+        if (!message.empty()) {
+            messages.emplace_back(message);
+        }
+    });
+}
+
+int MappedFixStore::getNextSenderMsgSeqNum() const {
+    return static_cast<int>(store_.getNextSenderMsgSeqNum());
+}
+
+int MappedFixStore::getNextTargetMsgSeqNum() const {
+    return static_cast<int>(store_.getNextTargetMsgSeqNum());
+}
+
+void MappedFixStore::setNextSenderMsgSeqNum(int seqNum) {
+    store_.setNextSenderMsgSeqNum(static_cast<uint64_t>(seqNum));
+}
+
+void MappedFixStore::setNextTargetMsgSeqNum(int seqNum) {
+    store_.setNextTargetMsgSeqNum(static_cast<uint64_t>(seqNum));
+}
+
+void MappedFixStore::incrNextSenderMsgSeqNum() {
+    store_.incrNextSenderMsgSeqNum();
+}
+
+void MappedFixStore::incrNextTargetMsgSeqNum() {
+    store_.incrNextTargetMsgSeqNum();
+}
+
+FIX::UtcTimeStamp MappedFixStore::getCreationTime() const {
+    auto creation = store_.getCreationTime();
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        creation.time_since_epoch()).count() % 1000;
+    return FIX::UtcTimeStamp(std::chrono::system_clock::to_time_t(creation), static_cast<int>(millis));
+}
+
+void MappedFixStore::reset() {
+    store_.reset();
+}
+
+void MappedFixStore::refresh() {
+    // The mapping is the store; there is nothing cached to reload
+}
+
+MappedFixStoreFactory::MappedFixStoreFactory(const FIX::SessionSettings& settings,
+                                             uint32_t indexCapacity, size_t dataCapacity)
+    : settings_(&settings)
+    , indexCapacity_(indexCapacity)
+    , dataCapacity_(dataCapacity)
+{}
+
+MappedFixStoreFactory::MappedFixStoreFactory(const std::string& directory,
+                                             uint32_t indexCapacity, size_t dataCapacity)
+    : directory_(directory)
+    , indexCapacity_(indexCapacity)
+    , dataCapacity_(dataCapacity)
+{}
+
+FIX::MessageStore* MappedFixStoreFactory::create(const FIX::SessionID& sessionID) {
+    std::string directory = directory_;
+    if (settings_) {
+        const auto& dictionary = settings_->get(sessionID);
+        directory = dictionary.has(FIX::FILE_STORE_PATH) ? dictionary.getString(FIX::FILE_STORE_PATH) : "store";
+    }
+    
+    auto path = storePath(directory, sessionID.getBeginString().getValue(),
+                          sessionID.getSenderCompID().getValue(), sessionID.getTargetCompID().getValue());
+    return new MappedFixStore(path, indexCapacity_, dataCapacity_);
+}
+
+void MappedFixStoreFactory::destroy(FIX::MessageStore* store) {
+    delete store;
+}
+
+std::string MappedFixStoreFactory::storePath(const std::string& directory, const std::string& beginString,
+                                             const std::string& senderCompId, const std::string& targetCompId) {
+    return directory + "/" + beginString + "-" + senderCompId + "-" + targetCompId + ".store";
+}
+
+} // namespace networking
\ No newline at end of file
@@ -0,0 +1,459 @@
+// src/networking/NativeFixSession.cpp
+#include "NativeFixSession.hpp"
+#include "../utils/Logger.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace networking {
+
+NativeFixSession::NativeFixSession(int socketFd, std::string senderCompId, MessageHandler handler,
+                                   std::string storeDirectory, LogonHandler logonHandler)
+    : socket_(socketFd)
+    , senderCompId_(std::move(senderCompId))
+    , handler_(std::move(handler))
+    , storeDirectory_(std::move(storeDirectory))
+    , logonHandler_(std::move(logonHandler))
+{}
+
+NativeFixSession::~NativeFixSession() {
+    stop();
+    if (socket_ >= 0) {
+        close(socket_);
+    }
+}
+
+void NativeFixSession::stop() {
+    running_.store(false, std::memory_order_release);
+}
+
+void NativeFixSession::run() {
+    pollfd item{socket_, POLLIN, 0};
+    
+    while (running_.load(std::memory_order_acquire)) {
+        int ready = ::poll(&item, 1, 100);
+        if (ready <= 0) {
+            continue;
+        }
+        
+        ssize_t bytes = ::recv(socket_, receiveBuffer_.data() + receivedBytes_,
+                               receiveBuffer_.size() - receivedBytes_, 0);
+        if (bytes <= 0) {
+            if (bytes < 0 && (errno == EAGAIN || errno == EINTR)) {
+                continue;
+            }
+            LOG_INFO("Native FIX session {} disconnected", targetCompId_);
+            break;
+        }
+        receivedBytes_ += static_cast<size_t>(bytes);
+        
+        // Dispatch every complete frame in place, then move the partial tail to the front
+        size_t consumed = 0;
+        FixMessageView message;
+        while (consumed < receivedBytes_) {
+            std::string_view pending(receiveBuffer_.data() + consumed, receivedBytes_ - consumed);
+            ptrdiff_t length = FixMessageView::frameLength(pending);
+            
+            if (length == 0) {
+                break;
+            }
+            if (length < 0) {
+                LOG_ERROR("Native FIX session {}: garbled stream, disconnecting", targetCompId_);
+                running_.store(false, std::memory_order_release);
+                break;
+            }
+            
+            if (message.parse(pending.substr(0, static_cast<size_t>(length)))) {
+                processMessage(message);
+            } else {
+                LOG_WARNING("Native FIX session {}: dropped message with bad checksum", targetCompId_);
+            }
+            consumed += static_cast<size_t>(length);
+        }
+        
+        if (consumed > 0) {
+            std::memmove(receiveBuffer_.data(), receiveBuffer_.data() + consumed, receivedBytes_ - consumed);
+            receivedBytes_ -= consumed;
+        }
+        
+        if (receivedBytes_ == receiveBuffer_.size()) {
+            LOG_ERROR("Native FIX session {}: message exceeds receive buffer", targetCompId_);
+            break;
+        }
+    }
+    
+    loggedOn_.store(false, std::memory_order_release);
+    running_.store(false, std::memory_order_release);
+}
+
+void NativeFixSession::processMessage(const FixMessageView& message) {
+    auto msgType = message.getMsgType();
+    auto seqNum = static_cast<uint64_t>(message.getInt(34));
+    
+    if (msgType == "A") {
+        onLogon(message, seqNum);
+        return;
+    }
+    
+    if (!isLoggedOn()) {
+        LOG_WARNING("Native FIX session: {} received before Logon, ignoring", msgType);
+        return;
+    }
+    
+    // SequenceReset-Reset applies whatever its own MsgSeqNum
+    bool gapFill = message.getChar(123, 'N') == 'Y';
+    if (msgType == "4" && !gapFill) {
+        setNextIncomingSeqNum(static_cast<uint64_t>(message.getInt(36, static_cast<int64_t>(nextIncomingSeqNum_))));
+        return;
+    }
+    
+    if (!acceptSeqNum(message, seqNum)) {
+        // The peer's own resend request is served even past a gap, or both sides would wait
+        if (msgType == "2" && seqNum > nextIncomingSeqNum_) {
+            resend(static_cast<uint64_t>(message.getInt(7, 1)), static_cast<uint64_t>(message.getInt(16, 0)));
+        }
+        return;
+    }
+    
+    if (msgType == "4") {
+        auto newSeqNum = static_cast<uint64_t>(message.getInt(36, 0));
+        setNextIncomingSeqNum(newSeqNum > seqNum ? newSeqNum : seqNum + 1);
+        return;
+    }
+    setNextIncomingSeqNum(seqNum + 1);
+    
+    if (msgType == "0") {
+        return;
+    }
+    
+    if (msgType == "1") {
+        auto testReqId = message.get(112);
+        sendMessage("0", [&](FixMessageBuilder& builder) { builder.add(112, testReqId); });
+        return;
+    }
+    
+    if (msgType == "2") {
+        resend(static_cast<uint64_t>(message.getInt(7, 1)), static_cast<uint64_t>(message.getInt(16, 0)));
+        return;
+    }
+    
+    if (msgType == "5") {
+        logout({});
+        return;
+    }
+    
+    handler_(*this, message);
+}
+
+bool NativeFixSession::acceptSeqNum(const FixMessageView& message, uint64_t seqNum) {
+    if (seqNum == nextIncomingSeqNum_) {
+        return true;
+    }
+    
+    if (seqNum < nextIncomingSeqNum_) {
+        // A possible duplicate that was already processed; anything else is fatal
+        if (message.getChar(43, 'N') != 'Y') {
+            LOG_ERROR("Native FIX session {}: MsgSeqNum too low, expected {} got {}",
+                     targetCompId_, nextIncomingSeqNum_, seqNum);
+            logout("MsgSeqNum too low, expecting " + std::to_string(nextIncomingSeqNum_) +
+                   " but received " + std::to_string(seqNum));
+        }
+        return false;
+    }
+    
+    // Nothing past a gap is processed; the peer resends it all, in order
+    requestResend(seqNum);
+    return false;
+}
+
+void NativeFixSession::requestResend(uint64_t receivedSeqNum) {
+    // One request to infinity covers every later message until the gap is filled
+    if (nextIncomingSeqNum_ <= resendRequestedTo_) {
+        return;
+    }
+    
+    LOG_WARNING("Native FIX session {}: sequence gap, expected {} got {}, requesting resend",
+               targetCompId_, nextIncomingSeqNum_, receivedSeqNum);
+    resendRequestedTo_ = receivedSeqNum;
+    sendMessage("2", [&](FixMessageBuilder& builder) {
+        builder.add(7, static_cast<int64_t>(nextIncomingSeqNum_))
+               .add(16, int64_t{0});
+    });
+}
+
+void NativeFixSession::logout(const std::string& text) {
+    sendMessage("5", [&](FixMessageBuilder& builder) {
+        if (!text.empty()) {
+            builder.add(58, std::string_view(text));
+        }
+    });
+    loggedOn_.store(false, std::memory_order_release);
+    running_.store(false, std::memory_order_release);
+}
+
+void NativeFixSession::onLogon(const FixMessageView& message, uint64_t seqNum) {
+    auto beginString = message.getBeginString();
+    if (beginString == "FIX.4.2") {
+        version_ = FixVersion::FIX42;
+    } else if (beginString == "FIX.4.4") {
+        version_ = FixVersion::FIX44;
+    } else {
+        LOG_ERROR("Native FIX session: unsupported BeginString {}", beginString);
+        running_.store(false, std::memory_order_release);
+        return;
+    }
+    
+    targetCompId_ = std::string(message.get(49));
+    auto heartBtInt = message.getInt(108, 30);
+    
+    if (!storeDirectory_.empty()) {
+        std::lock_guard lock(sendMutex_);
+        store_ = std::make_unique<persistence::MappedMessageStore>(
+            storeDirectory_ + "/" + std::string(beginString) + "-" + senderCompId_ + "-" + targetCompId_ + ".store");
+        
+        if (message.getChar(141) == 'Y') {
+            store_->reset();
+        }
+        nextOutgoingSeqNum_ = store_->getNextSenderMsgSeqNum();
+        nextIncomingSeqNum_ = store_->getNextTargetMsgSeqNum();
+    } else if (message.getChar(141) == 'Y') {
+        nextOutgoingSeqNum_ = 1;
+        nextIncomingSeqNum_ = 1;
+    }
+    
+    // Validated against what was stored from the last connection, not taken from the peer
+    if (seqNum < nextIncomingSeqNum_) {
+        LOG_ERROR("Native FIX session {}: Logon MsgSeqNum too low, expected {} got {}",
+                 targetCompId_, nextIncomingSeqNum_, seqNum);
+        logout("MsgSeqNum too low, expecting " + std::to_string(nextIncomingSeqNum_) +
+               " but received " + std::to_string(seqNum));
+        return;
+    }
+    
+    if (logonHandler_ && !logonHandler_(*this)) {
+        LOG_ERROR("Native FIX session {}: Logon refused", targetCompId_);
+        logout("Logon refused");
+        return;
+    }
+    
+    sendMessage("A", [&](FixMessageBuilder& builder) {
+        builder.add(98, int64_t{0})
+               .add(108, heartBtInt);
+    });
+    
+    loggedOn_.store(true, std::memory_order_release);
+    LOG_INFO("Native FIX session logon: {} ({})", targetCompId_, beginString);
+    
+    if (seqNum > nextIncomingSeqNum_) {
+        requestResend(seqNum);
+    } else {
+        setNextIncomingSeqNum(seqNum + 1);
+    }
+}
+
+bool NativeFixSession::sendExecutionReport(engine::OrderId orderId, std::string_view clOrdId,
+                                           std::string_view symbol, char side,
+                                           engine::Quantity orderQty, ExecutionReportFields fields,
+                                           std::string_view origClOrdId) {
+    std::lock_guard lock(sendMutex_);
+    fields.msgSeqNum = nextOutgoingSeqNum_;
+    
+    // 4.4 has no partial/fill ExecTypes; anything that reports a fill is a Trade
+    if (version_ == FixVersion::FIX44 && (fields.execType == '1' || fields.execType == '2')) {
+        fields.execType = fix44Encoder_.fillExecType(fields.execType == '2');
+    }
+    
+    // The order's later reports are prepared afresh with its new ClOrdID and OrderQty
+    if (!origClOrdId.empty()) {
+        if (preparedOrderId_ == orderId) {
+            preparedOrderId_ = 0;
+        }
+        return sendBuiltExecutionReport(orderId, clOrdId, symbol, side, orderQty, fields, origClOrdId);
+    }
+    
+    // Consecutive reports for the same order reuse the laid-out template as is
+    if (preparedOrderId_ != orderId) {
+        bool prepared = version_ == FixVersion::FIX42
+            ? fix42Encoder_.prepare(senderCompId_, targetCompId_, orderId, clOrdId, symbol, side, orderQty)
+            : fix44Encoder_.prepare(senderCompId_, targetCompId_, orderId, clOrdId, symbol, side, orderQty);
+        if (!prepared) {
+            // Identifiers too long for a template; the last order's stays prepared
+            return sendBuiltExecutionReport(orderId, clOrdId, symbol, side, orderQty, fields);
+        }
+        preparedOrderId_ = orderId;
+    }
+    
+    return sendRaw(version_ == FixVersion::FIX42 ? fix42Encoder_.encode(fields) : fix44Encoder_.encode(fields));
+}
+
+bool NativeFixSession::sendBuiltExecutionReport(engine::OrderId orderId, std::string_view clOrdId,
+                                                std::string_view symbol, char side, engine::Quantity orderQty,
+                                                const ExecutionReportFields& fields, std::string_view origClOrdId) {
+    auto price = [](char* buffer, engine::Price value) {
+        auto result = std::to_chars(buffer, buffer + 32, value, std::chars_format::fixed, 6);
+        return std::string_view(buffer, static_cast<size_t>(result.ptr - buffer));
+    };
+    char lastPx[32], avgPx[32];
+    char transactTime[21];
+    formatFixTimestamp(transactTime, std::chrono::system_clock::now());
+    
+    std::array<char, 4096> buffer;
+    FixMessageBuilder builder(buffer.data(), buffer.size(), beginString(), "8");
+    addHeader(builder);
+    builder.add(37, static_cast<int64_t>(orderId))
+           .add(11, clOrdId);
+    if (!origClOrdId.empty()) {
+        builder.add(41, origClOrdId);
+    }
+    builder.add(17, static_cast<int64_t>(fields.execId));
+    if (version_ == FixVersion::FIX42) {
+        builder.add(20, '0');
+    }
+    builder.add(150, fields.execType)
+           .add(39, fields.ordStatus)
+           .add(55, symbol)
+           .add(54, side)
+           .add(38, orderQty)
+           .add(32, fields.lastQty)
+           .add(31, price(lastPx, fields.lastPx))
+           .add(151, fields.leavesQty)
+           .add(14, fields.cumQty)
+           .add(6, price(avgPx, fields.avgPx))
+           .add(60, std::string_view(transactTime, sizeof(transactTime)));
+    
+    return sendRaw(builder.finish());
+}
+
+std::string_view NativeFixSession::beginString() const {
+    return version_ == FixVersion::FIX42 ? "FIX.4.2" : "FIX.4.4";
+}
+
+void NativeFixSession::addHeader(FixMessageBuilder& builder) {
+    char sendingTime[21];
+    formatFixTimestamp(sendingTime, std::chrono::system_clock::now());
+    
+    builder.add(34, static_cast<int64_t>(nextOutgoingSeqNum_))
+           .add(49, senderCompId_)
+           .add(52, std::string_view(sendingTime, sizeof(sendingTime)))
+           .add(56, targetCompId_);
+}
+
+bool NativeFixSession::sendRaw(std::string_view message) {
+    if (message.empty()) {
+        return false;
+    }
+    
+    // Persist before sending so a resend can always be served after a crash
+    if (store_) {
+        store_->set(nextOutgoingSeqNum_, message);
+        store_->incrNextSenderMsgSeqNum();
+    }
+    ++nextOutgoingSeqNum_;
+    
+    return writeSocket(message);
+}
+
+bool NativeFixSession::writeSocket(std::string_view message) {
+    size_t sent = 0;
+    while (sent < message.size()) {
+        ssize_t bytes = ::send(socket_, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (bytes < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            LOG_ERROR("Native FIX session {}: send failed: {}", targetCompId_, std::strerror(errno));
+            return false;
+        }
+        sent += static_cast<size_t>(bytes);
+    }
+    
+    return true;
+}
+
+void NativeFixSession::setNextIncomingSeqNum(uint64_t seqNum) {
+    nextIncomingSeqNum_ = seqNum;
+    if (store_) {
+        store_->setNextTargetMsgSeqNum(seqNum);
+    }
+}
+
+void NativeFixSession::resend(uint64_t beginSeqNum, uint64_t endSeqNum) {
+    std::lock_guard lock(sendMutex_);
+    
+    uint64_t lastSent = nextOutgoingSeqNum_ - 1;
+    if (endSeqNum == 0 || endSeqNum > lastSent) {
+        endSeqNum = lastSent;
+    }
+    
+    LOG_INFO("Native FIX session {}: resending {} to {}", targetCompId_, beginSeqNum, endSeqNum);
+    
+    // Session-level and overwritten messages collapse into gap fills; application
+    // messages are replayed from the mapping with PossDupFlag set
+    constexpr std::string_view SESSION_MSG_TYPES = "0A12345";
+    uint64_t gapStart = 0;
+    FixMessageView original;
+    
+    for (uint64_t seqNum = beginSeqNum; seqNum <= endSeqNum; ++seqNum) {
+        auto stored = store_ ? store_->get(seqNum) : std::string_view();
+        bool replay = !stored.empty() && original.parse(stored) && original.getMsgType().size() == 1 &&
+                      SESSION_MSG_TYPES.find(original.getMsgType()[0]) == std::string_view::npos;
+        
+        if (!replay) {
+            if (gapStart == 0) {
+                gapStart = seqNum;
+            }
+            continue;
+        }
+        
+        if (gapStart != 0) {
+            sendGapFill(gapStart, seqNum);
+            gapStart = 0;
+        }
+        
+        std::array<char, 1024> buffer;
+        char sendingTime[21];
+        formatFixTimestamp(sendingTime, std::chrono::system_clock::now());
+        
+        FixMessageBuilder builder(buffer.data(), buffer.size(), beginString(), original.getMsgType());
+        builder.add(34, static_cast<int64_t>(seqNum))
+               .add(43, 'Y')
+               .add(49, senderCompId_)
+               .add(52, std::string_view(sendingTime, sizeof(sendingTime)))
+               .add(56, targetCompId_)
+               .add(122, original.get(52));
+        original.forEachField([&](uint32_t tag, std::string_view value) {
+            switch (tag) {
+                case 8: case 9: case 10: case 34: case 35: case 43: case 49: case 52: case 56: case 122:
+                    break; // header rebuilt above, trailer by finish()
+                default:
+                    builder.add(tag, value);
+            }
+        });
+        writeSocket(builder.finish());
+    }
+    
+    if (gapStart != 0) {
+        sendGapFill(gapStart, endSeqNum + 1);
+    }
+}
+
+void NativeFixSession::sendGapFill(uint64_t seqNum, uint64_t newSeqNum) {
+    std::array<char, 256> buffer;
+    char sendingTime[21];
+    formatFixTimestamp(sendingTime, std::chrono::system_clock::now());
+    
+    FixMessageBuilder builder(buffer.data(), buffer.size(), beginString(), "4");
+    builder.add(34, static_cast<int64_t>(seqNum))
+           .add(43, 'Y')
+           .add(49, senderCompId_)
+           .add(52, std::string_view(sendingTime, sizeof(sendingTime)))
+           .add(56, targetCompId_)
+           .add(123, 'Y')
+           .add(36, static_cast<int64_t>(newSeqNum));
+    writeSocket(builder.finish());
+}
+
+} // namespace networking
@@ -0,0 +1,323 @@
+// src/networking/Protocol.cpp
+#include "Protocol.hpp"
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace networking {
+
+namespace {
+
+constexpr char SEPARATOR = '|';
+
+class FieldWriter {
+public:
+    explicit FieldWriter(MessageType type) {
+        add(static_cast<int>(type));
+    }
+    
+    template<typename T>
+    FieldWriter& add(T value) {
+        if (!out_.empty()) {
+            out_ += SEPARATOR;
+        }
+        if constexpr (std::is_enum_v<T>) {
+            return addNumber(static_cast<int>(value));
+        } else {
+            return addNumber(value);
+        }
+    }
+    
+    FieldWriter& add(std::string_view value) {
+        if (!out_.empty()) {
+            out_ += SEPARATOR;
+        }
+        out_ += value;
+        return *this;
+    }
+    
+    FieldWriter& add(std::chrono::system_clock::time_point time) {
+        return add(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+    }
+    
+    std::string take() { return std::move(out_); }
+    
+private:
+    std::string out_;
+    
+    template<typename T>
+    FieldWriter& addNumber(T value) {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out_.append(buffer, result.ptr);
+        return *this;
+    }
+};
+
+class FieldReader {
+public:
+    FieldReader(std::string_view data, MessageType expected) : data_(data) {
+        if (number<int>() != static_cast<int>(expected)) {
+            throw std::invalid_argument("unexpected message type");
+        }
+    }
+    
+    std::string_view next() {
+        if (done_) {
+            throw std::invalid_argument("message truncated");
+        }
+        size_t end = data_.find(SEPARATOR, position_);
+        if (end == std::string_view::npos) {
+            done_ = true;
+            end = data_.size();
+        }
+        auto field = data_.substr(position_, end - position_);
+        position_ = end + 1;
+        return field;
+    }
+    
+    // Everything left, separators included
+    std::string_view rest() {
+        if (done_) {
+            throw std::invalid_argument("message truncated");
+        }
+        done_ = true;
+        return data_.substr(position_);
+    }
+    
+    template<typename T>
+    T number() {
+        auto field = next();
+        T value{};
+        auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+        if (result.ec != std::errc() || result.ptr != field.data() + field.size()) {
+            throw std::invalid_argument("malformed field '" + std::string(field) + "'");
+        }
+        return value;
+    }
+    
+    template<typename Enum>
+    Enum enumeration() {
+        return static_cast<Enum>(number<int>());
+    }
+    
+    std::chrono::system_clock::time_point time() {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(number<int64_t>())));
+    }
+    
+    void end() const {
+        if (!done_) {
+            throw std::invalid_argument("unexpected trailing fields");
+        }
+    }
+    
+private:
+    std::string_view data_;
+    size_t position_{0};
+    bool done_{false};
+};
+
+} // namespace
+
+std::string serializeOrderRequest(const OrderRequest& request) {
+    return FieldWriter(MessageType::ORDER_REQUEST)
+        .add(request.type)
+        .add(request.side)
+        .add(std::string_view(request.symbol))
+        .add(request.price)
+        .add(request.quantity)
+        .add(std::string_view(request.apiKey))
+        .add(std::string_view(request.clientOrderId))
+        .take();
+}
+
+OrderRequest deserializeOrderRequest(const std::string& data) {
+    FieldReader reader(data, MessageType::ORDER_REQUEST);
+    OrderRequest request;
+    request.type = reader.enumeration<engine::OrderType>();
+    request.side = reader.enumeration<engine::OrderSide>();
+    request.symbol = reader.next();
+    request.price = reader.number<engine::Price>();
+    request.quantity = reader.number<engine::Quantity>();
+    request.apiKey = reader.next();
+    request.clientOrderId = reader.rest();
+    return request;
+}
+
+std::string serializeOrderResponse(const OrderResponse& response) {
+    return FieldWriter(MessageType::ORDER_RESPONSE)
+        .add(response.orderId)
+        .add(response.status)
+        .add(response.filledQuantity)
+        .add(response.averagePrice)
+        .add(std::string_view(response.clientOrderId))
+        .add(std::string_view(response.message))
+        .take();
+}
+
+OrderResponse deserializeOrderResponse(const std::string& data) {
+    FieldReader reader(data, MessageType::ORDER_RESPONSE);
+    OrderResponse response;
+    response.orderId = reader.number<engine::OrderId>();
+    response.status = reader.enumeration<engine::OrderStatus>();
+    response.filledQuantity = reader.number<engine::Quantity>();
+    response.averagePrice = reader.number<engine::Price>();
+    response.clientOrderId = reader.next();
+    response.message = reader.rest();
+    return response;
+}
+
+std::string serializeTradeNotification(const TradeNotification& notification) {
+    return FieldWriter(MessageType::TRADE_NOTIFICATION)
+        .add(notification.tradeId)
+        .add(notification.buyOrderId)
+        .add(notification.sellOrderId)
+        .add(notification.quantity)
+        .add(notification.price)
+        .add(notification.timestamp)
+        .take();
+}
+
+TradeNotification deserializeTradeNotification(const std::string& data) {
+    FieldReader reader(data, MessageType::TRADE_NOTIFICATION);
+    TradeNotification notification;
+    notification.tradeId = reader.number<engine::TradeId>();
+    notification.buyOrderId = reader.number<engine::OrderId>();
+    notification.sellOrderId = reader.number<engine::OrderId>();
+    notification.quantity = reader.number<engine::Quantity>();
+    notification.price = reader.number<engine::Price>();
+    notification.timestamp = reader.time();
+    reader.end();
+    return notification;
+}
+
+std::string serializeMarketDataSnapshot(const MarketDataSnapshot& snapshot) {
+    FieldWriter writer(MessageType::MARKET_DATA_SNAPSHOT);
+    writer.add(std::string_view(snapshot.symbol))
+          .add(snapshot.timestamp)
+          .add(snapshot.lastPrice)
+          .add(snapshot.lastQuantity)
+          .add(snapshot.totalVolume);
+    for (const auto* levels : {&snapshot.bids, &snapshot.asks}) {
+        writer.add(levels->size());
+        for (const auto& level : *levels) {
+            writer.add(level.price).add(level.quantity);
+        }
+    }
+    return writer.take();
+}
+
+MarketDataSnapshot deserializeMarketDataSnapshot(const std::string& data) {
+    FieldReader reader(data, MessageType::MARKET_DATA_SNAPSHOT);
+    MarketDataSnapshot snapshot;
+    snapshot.symbol = reader.next();
+    snapshot.timestamp = reader.time();
+    snapshot.lastPrice = reader.number<engine::Price>();
+    snapshot.lastQuantity = reader.number<engine::Quantity>();
+    snapshot.totalVolume = reader.number<engine::Quantity>();
+    for (auto* levels : {&snapshot.bids, &snapshot.asks}) {
+        auto count = reader.number<size_t>();
+        if (count > data.size()) {
+            throw std::invalid_argument("malformed level count");
+        }
+        levels->resize(count);
+        for (auto& level : *levels) {
+            level.price = reader.number<engine::Price>();
+            level.quantity = reader.number<engine::Quantity>();
+        }
+    }
+    reader.end();
+    return snapshot;
+}
+
+std::string serializeAuctionIndicative(const AuctionIndicative& indicative) {
+    return FieldWriter(MessageType::AUCTION_INDICATIVE)
+        .add(std::string_view(indicative.symbol))
+        .add(indicative.timestamp)
+        .add(indicative.indicativePrice)
+        .add(indicative.indicativeVolume)
+        .add(indicative.surplus)
+        .add(indicative.surplusSide)
+        .take();
+}
+
+AuctionIndicative deserializeAuctionIndicative(const std::string& data) {
+    FieldReader reader(data, MessageType::AUCTION_INDICATIVE);
+    AuctionIndicative indicative;
+    indicative.symbol = reader.next();
+    indicative.timestamp = reader.time();
+    indicative.indicativePrice = reader.number<engine::Price>();
+    indicative.indicativeVolume = reader.number<engine::Quantity>();
+    indicative.surplus = reader.number<engine::Quantity>();
+    indicative.surplusSide = reader.enumeration<engine::OrderSide>();
+    reader.end();
+    return indicative;
+}
+
+std::string serializeMassQuote(const MassQuote& quote) {
+    FieldWriter writer(MessageType::MASS_QUOTE);
+    writer.add(std::string_view(quote.apiKey)).add(quote.entries.size());
+    for (const auto& entry : quote.entries) {
+        writer.add(std::string_view(entry.symbol))
+              .add(entry.bidPrice)
+              .add(entry.bidQuantity)
+              .add(entry.askPrice)
+              .add(entry.askQuantity);
+    }
+    return writer.take();
+}
+
+MassQuote deserializeMassQuote(const std::string& data) {
+    FieldReader reader(data, MessageType::MASS_QUOTE);
+    MassQuote quote;
+    quote.apiKey = reader.next();
+    auto count = reader.number<size_t>();
+    if (count > data.size()) {
+        throw std::invalid_argument("malformed entry count");
+    }
+    quote.entries.resize(count);
+    for (auto& entry : quote.entries) {
+        entry.symbol = reader.next();
+        entry.bidPrice = reader.number<engine::Price>();
+        entry.bidQuantity = reader.number<engine::Quantity>();
+        entry.askPrice = reader.number<engine::Price>();
+        entry.askQuantity = reader.number<engine::Quantity>();
+    }
+    reader.end();
+    return quote;
+}
+
+std::string serializeDepthUpdate(const DepthUpdate& update) {
+    return FieldWriter(MessageType::DEPTH_UPDATE)
+        .add(std::string_view(update.symbol))
+        .add(update.timestamp)
+        .add(update.side)
+        .add(update.price)
+        .add(update.quantity)
+        .add(update.orderCount)
+        .add(update.previousPrice)
+        .add(update.previousQuantity)
+        .add(update.previousOrderCount)
+        .take();
+}
+
+DepthUpdate deserializeDepthUpdate(const std::string& data) {
+    FieldReader reader(data, MessageType::DEPTH_UPDATE);
+    DepthUpdate update;
+    update.symbol = reader.next();
+    update.timestamp = reader.time();
+    update.side = reader.enumeration<engine::OrderSide>();
+    update.price = reader.number<engine::Price>();
+    update.quantity = reader.number<engine::Quantity>();
+    update.orderCount = reader.number<uint32_t>();
+    update.previousPrice = reader.number<engine::Price>();
+    update.previousQuantity = reader.number<engine::Quantity>();
+    update.previousOrderCount = reader.number<uint32_t>();
+    reader.end();
+    return update;
+}
+
+} // namespace networking
\ No newline at end of file
@@ -0,0 +1,124 @@
+// src/networking/ShmTransport.cpp
+#include "ShmTransport.hpp"
+#include "../utils/Logger.hpp"
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace networking {
+
+ShmTransport::ShmTransport(const std::string& name, Role role)
+    : name_(name.empty() || name[0] == '/' ? name : "/" + name)
+    , role_(role)
+{
+    if (role_ == Role::ENGINE) {
+        // A segment left behind by a previous run would carry stale ring indices
+        shm_unlink(name_.c_str());
+        fd_ = shm_open(name_.c_str(), O_CREAT | O_RDWR, 0660);
+        if (fd_ < 0 || ftruncate(fd_, sizeof(Segment)) != 0) {
+            throw std::runtime_error("Failed to create shared memory segment " + name_ +
+                                     ": " + std::strerror(errno));
+        }
+    } else {
+        fd_ = shm_open(name_.c_str(), O_RDWR, 0660);
+        if (fd_ < 0) {
+            throw std::runtime_error("Failed to open shared memory segment " + name_ +
+                                     ": " + std::strerror(errno));
+        }
+    }
+    
+    void* mapping = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd_);
+        throw std::runtime_error("Failed to map shared memory segment " + name_ +
+                                 ": " + std::strerror(errno));
+    }
+    
+    if (role_ == Role::ENGINE) {
+        segment_ = new (mapping) Segment();
+        segment_->magic.store(SEGMENT_MAGIC, std::memory_order_release);
+        inbound_ = &segment_->toEngine;
+        outbound_ = &segment_->fromEngine;
+    } else {
+        segment_ = static_cast<Segment*>(mapping);
+        
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (segment_->magic.load(std::memory_order_acquire) != SEGMENT_MAGIC) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                munmap(mapping, sizeof(Segment));
+                close(fd_);
+                throw std::runtime_error("Shared memory segment " + name_ + " was never initialized");
+            }
+            std::this_thread::yield();
+        }
+        
+        inbound_ = &segment_->fromEngine;
+        outbound_ = &segment_->toEngine;
+    }
+    
+    LOG_INFO("Shared memory transport {} attached as {} ({} bytes)",
+             name_, role_ == Role::ENGINE ? "engine" : "client", sizeof(Segment));
+}
+
+ShmTransport::~ShmTransport() {
+    stop();
+    
+    if (segment_) {
+        munmap(segment_, sizeof(Segment));
+    }
+    
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+    
+    if (role_ == Role::ENGINE) {
+        shm_unlink(name_.c_str());
+    }
+}
+
+void ShmTransport::start(MessageCallback callback) {
+    if (running_.exchange(true)) {
+        return;
+    }
+    
+    callback_ = std::move(callback);
+    pollThread_ = std::thread(&ShmTransport::runPoller, this);
+}
+
+void ShmTransport::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    
+    if (pollThread_.joinable()) {
+        pollThread_.join();
+    }
+}
+
+bool ShmTransport::publish(std::string_view topic, std::string_view message) {
+    if (topic.size() > ShmFrame::MAX_TOPIC_SIZE || message.size() > ShmFrame::MAX_DATA_SIZE) {
+        LOG_WARNING("Message on {} too large for shared memory frame ({} bytes)", topic, message.size());
+        return false;
+    }
+    
+    return outbound_->pushWith([&](ShmFrame& frame) {
+        frame.topicSize = static_cast<uint16_t>(topic.size());
+        frame.dataSize = static_cast<uint16_t>(message.size());
+        std::memcpy(frame.topic, topic.data(), topic.size());
+        std::memcpy(frame.data, message.data(), message.size());
+    });
+}
+
+void ShmTransport::runPoller() {
+    while (running_.load(std::memory_order_relaxed)) {
+        if (poll(callback_) == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace networking
@@ -0,0 +1,286 @@
+// src/networking/StreamGateway.cpp
+#include "StreamGateway.hpp"
+#include "../utils/Logger.hpp"
+#include <chrono>
+#include <stdexcept>
+
+namespace networking {
+
+namespace {
+
+// Answers to requests with no user to address
+constexpr const char* REJECTS_TOPIC = "rejects";
+
+} // namespace
+
+StreamGateway::StreamGateway(std::shared_ptr<engine::MatchingEngine> engine, ZmqInterface& zmq,
+                             ShmTransport* shm, std::shared_ptr<const utils::ApiKeys> apiKeys)
+    : engine_(std::move(engine))
+    , zmq_(zmq)
+    , shm_(shm)
+    , apiKeys_(std::move(apiKeys))
+{
+}
+
+StreamGateway::~StreamGateway() {
+    stop();
+}
+
+void StreamGateway::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    publisherThread_ = std::thread(&StreamGateway::runPublisher, this);
+}
+
+void StreamGateway::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (publisherThread_.joinable()) {
+        publisherThread_.join();
+    }
+}
+
+void StreamGateway::onOrderRequest(Transport transport, std::string_view payload) {
+    OrderRequest request;
+    try {
+        request = deserializeOrderRequest(std::string(payload));
+    } catch (const std::invalid_argument& e) {
+        LOG_WARNING("Undecodable order request: {}", e.what());
+        respond(transport, REJECTS_TOPIC, OrderResponse{0, engine::OrderStatus::REJECTED, e.what(), 0, 0.0, ""});
+        return;
+    }
+    
+    auto userId = apiKeys_->userOf(request.apiKey);
+    if (!userId) {
+        LOG_WARNING("Order request {} with an unknown api key", request.clientOrderId);
+        respond(transport, REJECTS_TOPIC, OrderResponse{0, engine::OrderStatus::REJECTED, "Unknown api key", 0, 0.0,
+                                                        std::move(request.clientOrderId)});
+        return;
+    }
+    
+    auto order = std::make_shared<engine::Order>(
+        engine_->generateOrderId(),
+        *userId,
+        request.symbol,
+        request.type,
+        request.side,
+        request.price,
+        request.quantity
+    );
+    order->setSessionRoute(engine::STREAM_SESSION_BASE + static_cast<uint32_t>(transport), 0);
+    
+    // In place before the engine can emit the order's first event
+    {
+        std::lock_guard lock(mutex_);
+        clientOrderIds_[order->getId()] = request.clientOrderId;
+    }
+    
+    if (!engine_->enqueueOrder(order)) {
+        LOG_WARNING("Order queue full, rejecting order {}", order->getId());
+        {
+            std::lock_guard lock(mutex_);
+            clientOrderIds_.erase(order->getId());
+        }
+        respond(transport, ackTopic(*userId), OrderResponse{order->getId(), engine::OrderStatus::REJECTED,
+                                                            "Order queue full", 0, 0.0,
+                                                            std::move(request.clientOrderId)});
+    }
+}
+
+void StreamGateway::onMassQuote(Transport transport, std::string_view payload) {
+    MassQuote quote;
+    try {
+        quote = deserializeMassQuote(std::string(payload));
+    } catch (const std::invalid_argument& e) {
+        LOG_WARNING("Undecodable mass quote: {}", e.what());
+        respond(transport, REJECTS_TOPIC, OrderResponse{0, engine::OrderStatus::REJECTED, e.what(), 0, 0.0, ""});
+        return;
+    }
+    
+    auto userId = apiKeys_->userOf(quote.apiKey);
+    if (!userId) {
+        LOG_WARNING("Mass quote with an unknown api key");
+        respond(transport, REJECTS_TOPIC, OrderResponse{0, engine::OrderStatus::REJECTED, "Unknown api key", 0, 0.0, ""});
+        return;
+    }
+    
+    std::vector<engine::QuoteEntry> entries;
+    entries.reserve(quote.entries.size());
+    {
+        std::lock_guard lock(mutex_);
+        for (auto& entry : quote.entries) {
+            auto bidSlot = quoteSlot(entry.symbol + ".bid");
+            auto askSlot = quoteSlot(entry.symbol + ".ask");
+            entries.push_back(engine::QuoteEntry{std::move(entry.symbol), entry.bidPrice, entry.bidQuantity,
+                                                 entry.askPrice, entry.askQuantity, bidSlot, askSlot});
+        }
+    }
+    
+    if (!engine_->enqueueMassQuote(*userId, std::move(entries),
+                                   engine::STREAM_SESSION_BASE + static_cast<uint32_t>(transport))) {
+        LOG_WARNING("Order queue full, rejecting mass quote of user {}", *userId);
+        respond(transport, ackTopic(*userId), OrderResponse{0, engine::OrderStatus::REJECTED, "Order queue full",
+                                                            0, 0.0, ""});
+    }
+}
+
+uint32_t StreamGateway::quoteSlot(std::string label) {
+    // Under mutex_; bounded by two per instrument
+    auto [it, inserted] = quoteSlots_.try_emplace(label, static_cast<uint32_t>(quoteLabels_.size() + 1));
+    if (inserted) {
+        quoteLabels_.push_back(std::move(label));
+    }
+    return it->second;
+}
+
+void StreamGateway::respond(Transport transport, std::string topic, OrderResponse response) {
+    std::lock_guard lock(mutex_);
+    pending_.push_back(PendingResponse{transport, std::move(topic), std::move(response)});
+    hasPending_.store(true, std::memory_order_release);
+}
+
+std::string StreamGateway::ackTopic(engine::UserId userId) {
+    // A client subscribes to its own user's acks only
+    return "acks." + std::to_string(userId);
+}
+
+void StreamGateway::runPublisher() {
+    while (running_.load(std::memory_order_relaxed)) {
+        bool idle = true;
+        
+        if (auto event = engine_->pollExecutionEvent(engine::Gateway::STREAM)) {
+            publishExecution(*event);
+            idle = false;
+        }
+        if (auto top = engine_->pollTopOfBook()) {
+            publishTopOfBook(*top);
+            idle = false;
+        }
+        if (auto indicative = engine_->pollIndicative()) {
+            publishIndicative(*indicative);
+            idle = false;
+        }
+        if (auto depth = engine_->pollDepthUpdate()) {
+            publishDepth(*depth);
+            idle = false;
+        }
+        if (hasPending_.load(std::memory_order_acquire)) {
+            publishPending();
+            idle = false;
+        }
+        
+        if (idle) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void StreamGateway::publishExecution(const engine::ExecutionEvent& event) {
+    const bool done = event.execType == engine::ExecType::FILL ||
+                      event.execType == engine::ExecType::CANCELLED ||
+                      event.execType == engine::ExecType::REJECTED;
+    
+    OrderResponse response{event.orderId, toOrderStatus(event), "", event.cumQty, event.avgPx, ""};
+    {
+        std::lock_guard lock(mutex_);
+        auto it = clientOrderIds_.find(event.orderId);
+        if (it != clientOrderIds_.end()) {
+            response.clientOrderId = done ? std::move(it->second) : it->second;
+            if (done) {
+                clientOrderIds_.erase(it);
+            }
+        } else if (event.sessionOrderSlot != 0 && event.sessionOrderSlot <= quoteLabels_.size()) {
+            response.clientOrderId = quoteLabels_[event.sessionOrderSlot - 1];
+        }
+    }
+    
+    auto transport = static_cast<Transport>(event.sessionIndex - engine::STREAM_SESSION_BASE);
+    send(transport, ackTopic(event.userId), serializeOrderResponse(response));
+}
+
+void StreamGateway::publishTopOfBook(const engine::TopOfBook& top) {
+    MarketDataSnapshot snapshot;
+    snapshot.symbol = top.symbol;
+    snapshot.timestamp = std::chrono::system_clock::now();
+    if (top.bidQuantity > 0) {
+        snapshot.bids.push_back({top.bidPrice, top.bidQuantity});
+    }
+    if (top.askQuantity > 0) {
+        snapshot.asks.push_back({top.askPrice, top.askQuantity});
+    }
+    snapshot.lastPrice = top.lastPrice;
+    snapshot.lastQuantity = 0;
+    snapshot.totalVolume = 0;
+    
+    publishMarketData(snapshot.symbol + ".book", serializeMarketDataSnapshot(snapshot));
+}
+
+void StreamGateway::publishIndicative(const engine::IndicativeUpdate& update) {
+    AuctionIndicative indicative{
+        update.symbol,
+        std::chrono::system_clock::now(),
+        update.auction.indicativePrice,
+        update.auction.indicativeVolume,
+        update.auction.surplus,
+        update.auction.surplusSide
+    };
+    publishMarketData(indicative.symbol + ".auction", serializeAuctionIndicative(indicative));
+}
+
+void StreamGateway::publishDepth(const engine::DepthUpdate& update) {
+    DepthUpdate depth{
+        update.symbol,
+        std::chrono::system_clock::now(),
+        update.book.side,
+        update.book.price,
+        update.book.quantity,
+        update.book.orderCount,
+        update.book.previousPrice,
+        update.book.previousQuantity,
+        update.book.previousOrderCount
+    };
+    publishMarketData(depth.symbol + ".depth", serializeDepthUpdate(depth));
+}
+
+void StreamGateway::publishMarketData(const std::string& topic, const std::string& message) {
+    send(Transport::ZMQ, topic, message);
+    if (shm_) {
+        send(Transport::SHM, topic, message);
+    }
+}
+
+void StreamGateway::publishPending() {
+    std::vector<PendingResponse> responses;
+    {
+        std::lock_guard lock(mutex_);
+        responses.swap(pending_);
+        hasPending_.store(false, std::memory_order_relaxed);
+    }
+    for (const auto& pending : responses) {
+        send(pending.transport, pending.topic, serializeOrderResponse(pending.response));
+    }
+}
+
+void StreamGateway::send(Transport transport, const std::string& topic, const std::string& message) {
+    // A subscriber that is this far behind loses messages rather than stall the engine
+    bool sent = transport == Transport::SHM ? shm_ && shm_->publish(topic, message)
+                                            : zmq_.publish(topic, message);
+    if (!sent) {
+        LOG_WARNING("Dropped {} message: {} outbound queue full", topic,
+                   transport == Transport::SHM ? "shared memory" : "ZMQ");
+    }
+}
+
+engine::OrderStatus StreamGateway::toOrderStatus(const engine::ExecutionEvent& event) {
+    switch (event.execType) {
+        case engine::ExecType::FILL: return engine::OrderStatus::FILLED;
+        case engine::ExecType::CANCELLED: return engine::OrderStatus::CANCELLED;
+        case engine::ExecType::REJECTED: return engine::OrderStatus::REJECTED;
+        default:
+            return event.cumQty > 0 ? engine::OrderStatus::PARTIAL : engine::OrderStatus::NEW;
+    }
+}
+
+} // namespace networking
\ No newline at end of file
@@ -1,37 +1,48 @@
 // src/networking/ZmqInterface.cpp (Enhanced)
 #include "ZmqInterface.hpp"
 #include "../utils/Logger.hpp"
+#include "../utils/Hash.hpp"
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <thread>
 
 namespace networking {
 
 ZmqInterface::ZmqInterface(const std::string& publishEndpoint, 
                          const std::string& subscribeEndpoint,
-                         size_t queueSize)
-    : context_(1)
-    , publisher_(context_, ZMQ_PUB)
+                         size_t queueSize,
+                         const ZmqOptions& options)
+    : context_(options.ioThreads)
     , subscriber_(context_, ZMQ_SUB)
     , publishEndpoint_(publishEndpoint)
     , subscribeEndpoint_(subscribeEndpoint)
+    , options_(options)
+    , subscriptions_(std::make_shared<const SubscriptionTable>())
 {
+    for (size_t i = 0; i < options_.dispatchWorkers; ++i) {
+        dispatchWorkers_.push_back(std::make_unique<DispatchWorker>());
+    }
+    
     try {
         // Configure sockets for high performance
         int hwm = 100000;
-        publisher_.setsockopt(ZMQ_SNDHWM, &hwm, sizeof(hwm));
-        subscriber_.setsockopt(ZMQ_RCVHWM, &hwm, sizeof(hwm));
         
-        // Enable TCP keepalive
-        int keepalive = 1;
-        publisher_.setsockopt(ZMQ_TCP_KEEPALIVE, &keepalive, sizeof(keepalive));
-        subscriber_.setsockopt(ZMQ_TCP_KEEPALIVE, &keepalive, sizeof(keepalive));
+        size_t shardCount = std::max<size_t>(1, options_.publisherShards);
+        for (size_t i = 0; i < shardCount; ++i) {
+            auto shard = std::make_unique<PublisherShard>(context_, shardEndpoint(i));
+            shard->socket.setsockopt(ZMQ_SNDHWM, &hwm, sizeof(hwm));
+            bindSocket(shard->socket, shard->endpoint);
+            publishers_.push_back(std::move(shard));
+        }
         
-        publisher_.bind(publishEndpoint_);
-        subscriber_.bind(subscribeEndpoint_);
+        subscriber_.setsockopt(ZMQ_RCVHWM, &hwm, sizeof(hwm));
+        bindSocket(subscriber_, subscribeEndpoint_);
         subscriber_.setsockopt(ZMQ_SUBSCRIBE, "", 0);
         
-        LOG_INFO("ZeroMQ interface initialized: pub={}, sub={}", 
-                publishEndpoint_, subscribeEndpoint_);
+        LOG_INFO("ZeroMQ interface initialized: pub={} ({} shards), sub={}, io threads={}, dispatch workers={}", 
+                publishEndpoint_, publishers_.size(), subscribeEndpoint_, 
+                options_.ioThreads, options_.dispatchWorkers);
     } catch (const zmq::error_t& e) {
         LOG_ERROR("Failed to initialize ZeroMQ: {}", e.what());
         throw;
@@ -47,7 +58,14 @@ void ZmqInterface::start() {
         return;
     }
     
-    publisherThread_ = std::thread(&ZmqInterface::runPublisher, this);
+    for (auto& worker : dispatchWorkers_) {
+        worker->thread = std::thread(&ZmqInterface::runDispatchWorker, this, std::ref(*worker));
+    }
+    
+    for (auto& shard : publishers_) {
+        shard->thread = std::thread(&ZmqInterface::runPublisher, this, std::ref(*shard));
+    }
+    
     subscriberThread_ = std::thread(&ZmqInterface::runSubscriber, this);
     
     LOG_INFO("ZeroMQ interface started");
@@ -58,18 +76,27 @@ void ZmqInterface::stop() {
         return;
     }
     
-    if (publisherThread_.joinable()) {
-        publisherThread_.join();
+    for (auto& shard : publishers_) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
     }
     
     if (subscriberThread_.joinable()) {
         subscriberThread_.join();
     }
     
+    // Workers drain their rings before exiting, so join them after the subscriber
+    for (auto& worker : dispatchWorkers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    
     LOG_INFO("ZeroMQ interface stopped");
 }
 
-void ZmqInterface::runPublisher() {
+void ZmqInterface::runPublisher(PublisherShard& shard) {
     constexpr size_t BATCH_SIZE = 100;
     std::vector<std::pair<std::string, std::string>> batch;
     batch.reserve(BATCH_SIZE);
@@ -77,7 +104,7 @@ void ZmqInterface::runPublisher() {
     auto lastFlush = std::chrono::steady_clock::now();
     
     while (running_.load()) {
-        auto message = publishQueue_.pop();
+        auto message = shard.queue.pop();
         
         if (message) {
             batch.push_back(std::move(*message));
@@ -93,8 +120,8 @@ void ZmqInterface::runPublisher() {
                     zmq::message_t topicMsg(topic.data(), topic.size());
                     zmq::message_t dataMsg(data.data(), data.size());
                     
-                    publisher_.send(topicMsg, ZMQ_SNDMORE);
-                    publisher_.send(dataMsg, ZMQ_DONTWAIT);
+                    shard.socket.send(topicMsg, ZMQ_SNDMORE);
+                    shard.socket.send(dataMsg, ZMQ_DONTWAIT);
                 }
                 
                 batch.clear();
@@ -116,8 +143,8 @@ void ZmqInterface::runPublisher() {
                 zmq::message_t topicMsg(topic.data(), topic.size());
                 zmq::message_t dataMsg(data.data(), data.size());
                 
-                publisher_.send(topicMsg, ZMQ_SNDMORE);
-                publisher_.send(dataMsg);
+                shard.socket.send(topicMsg, ZMQ_SNDMORE);
+                shard.socket.send(dataMsg);
             }
         } catch (const zmq::error_t& e) {
             LOG_ERROR("Failed to flush remaining messages: {}", e.what());
@@ -130,25 +157,41 @@ void ZmqInterface::runSubscriber() {
         {static_cast<void*>(subscriber_), 0, ZMQ_POLLIN, 0}
     };
     
+    SubscriptionSnapshot snapshot;
+    
     while (running_.load()) {
         try {
             zmq::poll(items, 1, 100); // 100ms timeout
             
-            if (items[0].revents & ZMQ_POLLIN) {
+            if (!(items[0].revents & ZMQ_POLLIN)) {
+                continue;
+            }
+            
+            // Drain everything that is ready instead of going back to poll per message
+            for (size_t drained = 0; drained < options_.maxDrainBatch; ++drained) {
                 zmq::message_t topicMsg;
                 zmq::message_t dataMsg;
                 
-                if (subscriber_.recv(&topicMsg, ZMQ_DONTWAIT) && 
-                    subscriber_.recv(&dataMsg, ZMQ_DONTWAIT)) {
-                    
-                    std::string topic(static_cast<char*>(topicMsg.data()), topicMsg.size());
-                    std::string data(static_cast<char*>(dataMsg.data()), dataMsg.size());
-                    
-                    std::shared_lock lock(subscriptionsMutex_);
-                    if (auto it = subscriptions_.find(topic); it != subscriptions_.end()) {
-                        it->second(topic, data);
-                    }
+                if (!subscriber_.recv(&topicMsg, ZMQ_DONTWAIT) || 
+                    !subscriber_.recv(&dataMsg, ZMQ_DONTWAIT)) {
+                    break;
                 }
+                
+                uint64_t topicHash = utils::fnv1a(static_cast<const char*>(topicMsg.data()), 
+                                                  topicMsg.size());
+                
+                if (dispatchWorkers_.empty()) {
+                    dispatch(snapshot, topicHash, topicMsg, dataMsg);
+                    continue;
+                }
+                
+                // Same topic always lands on the same worker, so per-topic ordering holds.
+                // This thread is the only producer, so once there is room the push cannot fail.
+                auto& worker = *dispatchWorkers_[topicHash % dispatchWorkers_.size()];
+                while (worker.queue.size() + 1 >= worker.queue.capacity() && running_.load()) {
+                    std::this_thread::yield();
+                }
+                worker.queue.push(InboundMessage{topicHash, std::move(topicMsg), std::move(dataMsg)});
             }
         } catch (const zmq::error_t& e) {
             if (e.num() != EAGAIN) {
@@ -158,18 +201,151 @@ void ZmqInterface::runSubscriber() {
     }
 }
 
+void ZmqInterface::runDispatchWorker(DispatchWorker& worker) {
+    SubscriptionSnapshot snapshot;
+    
+    while (running_.load() || !worker.queue.empty()) {
+        auto message = worker.queue.pop();
+        
+        if (!message) {
+            std::this_thread::yield();
+            continue;
+        }
+        
+        dispatch(snapshot, message->topicHash, message->topic, message->data);
+    }
+}
+
+void ZmqInterface::dispatch(SubscriptionSnapshot& snapshot, uint64_t topicHash,
+                            const zmq::message_t& topic, const zmq::message_t& data) const {
+    refreshSnapshot(snapshot);
+    
+    std::string_view topicView(static_cast<const char*>(topic.data()), topic.size());
+    std::string_view dataView(static_cast<const char*>(data.data()), data.size());
+    
+    if (auto subscription = findSubscription(*snapshot.table, topicHash, topicView)) {
+        subscription->callback(topicView, dataView);
+    }
+}
+
+void ZmqInterface::refreshSnapshot(SubscriptionSnapshot& snapshot) const {
+    // A single acquire load on the hot path; the shared_ptr is only touched after a change
+    uint64_t version = subscriptionsVersion_.load(std::memory_order_acquire);
+    if (version != snapshot.version) {
+        snapshot.table = subscriptions_.load(std::memory_order_acquire);
+        snapshot.version = version;
+    }
+}
+
+const ZmqInterface::Subscription* ZmqInterface::findSubscription(const SubscriptionTable& table,
+                                                                 uint64_t topicHash, 
+                                                                 std::string_view topic) {
+    auto it = std::lower_bound(table.begin(), table.end(), topicHash,
+        [](const Subscription& entry, uint64_t hash) { return entry.topicHash < hash; });
+    
+    for (; it != table.end() && it->topicHash == topicHash; ++it) {
+        if (it->topic == topic) {
+            return &*it;
+        }
+    }
+    
+    return nullptr;
+}
+
 bool ZmqInterface::publish(const std::string& topic, const std::string& message) {
-    return publishQueue_.push({topic, message});
+    return publishers_[shardFor(topic)]->queue.push({topic, message});
+}
+
+size_t ZmqInterface::shardFor(std::string_view topic) const {
+    if (publishers_.size() == 1) {
+        return 0;
+    }
+    
+    // Topics are "<instrument>" or "<instrument>.<stream>"; every stream of an
+    // instrument goes through the same socket so its updates stay ordered
+    std::string_view instrument = topic.substr(0, topic.find('.'));
+    
+    if (!options_.instrumentGroups.empty()) {
+        if (auto it = options_.instrumentGroups.find(std::string(instrument)); 
+            it != options_.instrumentGroups.end()) {
+            return it->second % publishers_.size();
+        }
+    }
+    
+    return utils::fnv1a(instrument) % publishers_.size();
+}
+
+std::string ZmqInterface::shardEndpoint(size_t shardIndex) const {
+    if (shardIndex < options_.publishEndpoints.size()) {
+        return options_.publishEndpoints[shardIndex];
+    }
+    
+    if (shardIndex == 0) {
+        return publishEndpoint_;
+    }
+    
+    if (publishEndpoint_.rfind("tcp://", 0) == 0) {
+        auto colon = publishEndpoint_.rfind(':');
+        int basePort = std::stoi(publishEndpoint_.substr(colon + 1));
+        return publishEndpoint_.substr(0, colon + 1) + std::to_string(basePort + shardIndex);
+    }
+    
+    return publishEndpoint_ + "-" + std::to_string(shardIndex);
+}
+
+void ZmqInterface::bindSocket(zmq::socket_t& socket, const std::string& endpoint) {
+    if (endpoint.rfind("tcp://", 0) == 0) {
+        // Enable TCP keepalive
+        int keepalive = 1;
+        socket.setsockopt(ZMQ_TCP_KEEPALIVE, &keepalive, sizeof(keepalive));
+    } else if (endpoint.rfind("ipc://", 0) == 0) {
+        // libzmq removes a stale socket file itself but will not create its directory
+        std::filesystem::path path(endpoint.substr(6));
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+    }
+    
+    socket.bind(endpoint);
 }
 
 void ZmqInterface::subscribe(const std::string& topic, MessageCallback callback) {
-    std::unique_lock lock(subscriptionsMutex_);
-    subscriptions_[topic] = std::move(callback);
+    std::lock_guard lock(subscriptionsWriteMutex_);
+    
+    auto table = std::make_shared<SubscriptionTable>(*subscriptions_.load(std::memory_order_acquire));
+    uint64_t topicHash = utils::fnv1a(topic);
+    
+    auto it = std::find_if(table->begin(), table->end(),
+        [&](const Subscription& entry) { return entry.topicHash == topicHash && entry.topic == topic; });
+    
+    if (it != table->end()) {
+        it->callback = std::move(callback);
+    } else {
+        auto pos = std::upper_bound(table->begin(), table->end(), topicHash,
+            [](uint64_t hash, const Subscription& entry) { return hash < entry.topicHash; });
+        table->insert(pos, Subscription{topicHash, topic, std::move(callback)});
+    }
+    
+    publishSubscriptions(std::move(table));
 }
 
 void ZmqInterface::unsubscribe(const std::string& topic) {
-    std::unique_lock lock(subscriptionsMutex_);
-    subscriptions_.erase(topic);
+    std::lock_guard lock(subscriptionsWriteMutex_);
+    
+    auto table = std::make_shared<SubscriptionTable>(*subscriptions_.load(std::memory_order_acquire));
+    uint64_t topicHash = utils::fnv1a(topic);
+    
+    std::erase_if(*table, [&](const Subscription& entry) {
+        return entry.topicHash == topicHash && entry.topic == topic;
+    });
+    
+    publishSubscriptions(std::move(table));
+}
+
+void ZmqInterface::publishSubscriptions(std::shared_ptr<const SubscriptionTable> table) {
+    // Readers holding the previous table keep it alive until they observe the new version
+    subscriptions_.store(std::move(table), std::memory_order_release);
+    subscriptionsVersion_.fetch_add(1, std::memory_order_release);
 }
 
 } // namespace networking
\ No newline at end of file
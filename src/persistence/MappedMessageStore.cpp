@@ -0,0 +1,89 @@
+// src/persistence/MappedMessageStore.cpp
+#include "MappedMessageStore.hpp"
+#include "../utils/Logger.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace persistence {
+
+MappedMessageStore::MappedMessageStore(const std::string& path, uint32_t indexCapacity, size_t dataCapacity)
+    : segment_(path, HEADER_SIZE + sizeof(IndexEntry) * indexCapacity + dataCapacity)
+    , header_(reinterpret_cast<Header*>(segment_.data()))
+    , index_(reinterpret_cast<IndexEntry*>(segment_.data() + HEADER_SIZE))
+    , data_(segment_.data() + HEADER_SIZE + sizeof(IndexEntry) * indexCapacity)
+    , indexCapacity_(indexCapacity)
+    , dataCapacity_(dataCapacity)
+{
+    if (segment_.isNew() || header_->magic != STORE_MAGIC) {
+        header_->magic = STORE_MAGIC;
+        header_->version = STORE_VERSION;
+        header_->indexCapacity = indexCapacity_;
+        header_->dataCapacity = dataCapacity_;
+        reset();
+        return;
+    }
+    
+    if (header_->version != STORE_VERSION || header_->indexCapacity != indexCapacity_ ||
+        header_->dataCapacity != dataCapacity_) {
+        throw std::runtime_error("Message store " + path + " was created with a different layout");
+    }
+    
+    LOG_INFO("Recovered message store {}: next sender {}, next target {}",
+             path, header_->nextSenderSeqNum, header_->nextTargetSeqNum);
+}
+
+bool MappedMessageStore::set(uint64_t seqNum, std::string_view message) {
+    if (message.size() > dataCapacity_ / 2) {
+        LOG_ERROR("Message {} of {} bytes does not fit the store", seqNum, message.size());
+        return false;
+    }
+    
+    // Messages never straddle the end of the ring; skip the tail if it is too short
+    uint64_t position = header_->dataTail;
+    uint64_t offset = position % dataCapacity_;
+    if (offset + message.size() > dataCapacity_) {
+        position += dataCapacity_ - offset;
+        offset = 0;
+    }
+    
+    std::memcpy(data_ + offset, message.data(), message.size());
+    
+    auto& entry = index_[seqNum % indexCapacity_];
+    entry.seqNum = seqNum;
+    entry.position = position;
+    entry.length = static_cast<uint32_t>(message.size());
+    
+    header_->dataTail = position + message.size();
+    return true;
+}
+
+std::string_view MappedMessageStore::get(uint64_t seqNum) const {
+    const auto& entry = index_[seqNum % indexCapacity_];
+    if (entry.seqNum != seqNum || entry.length == 0) {
+        return {};
+    }
+    
+    // Overwritten once the writer has gone a full ring past it
+    if (header_->dataTail - entry.position > dataCapacity_) {
+        return {};
+    }
+    
+    return std::string_view(data_ + entry.position % dataCapacity_, entry.length);
+}
+
+std::chrono::system_clock::time_point MappedMessageStore::getCreationTime() const {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(header_->creationTimeNs)));
+}
+
+void MappedMessageStore::reset() {
+    std::memset(index_, 0, sizeof(IndexEntry) * indexCapacity_);
+    header_->nextSenderSeqNum = 1;
+    header_->nextTargetSeqNum = 1;
+    header_->dataTail = 0;
+    header_->creationTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace persistence
\ No newline at end of file
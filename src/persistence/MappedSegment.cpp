@@ -0,0 +1,68 @@
+// src/persistence/MappedSegment.cpp
+#include "MappedSegment.hpp"
+#include "../utils/Logger.hpp"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace persistence {
+
+MappedSegment::MappedSegment(const std::string& path, size_t size)
+    : path_(path)
+    , size_(size)
+{
+    auto parent = std::filesystem::path(path_).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent);
+    }
+    
+    fd_ = open(path_.c_str(), O_CREAT | O_RDWR, 0640);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open segment " + path_ + ": " + std::strerror(errno));
+    }
+    
+    struct stat info{};
+    fstat(fd_, &info);
+    isNew_ = info.st_size == 0;
+    
+    if (static_cast<size_t>(info.st_size) < size_) {
+        // Reserve the blocks up front so a full disk fails here, not as SIGBUS on a later store
+        int error = posix_fallocate(fd_, 0, static_cast<off_t>(size_));
+        if (error != 0) {
+            close(fd_);
+            throw std::runtime_error("Failed to preallocate segment " + path_ + ": " + std::strerror(error));
+        }
+    }
+    
+    void* mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd_);
+        throw std::runtime_error("Failed to map segment " + path_ + ": " + std::strerror(errno));
+    }
+    data_ = static_cast<char*>(mapping);
+    
+    LOG_INFO("Mapped segment {} ({} bytes, {})", path_, size_, isNew_ ? "new" : "existing");
+}
+
+MappedSegment::~MappedSegment() {
+    if (data_) {
+        msync(data_, size_, MS_ASYNC);
+        munmap(data_, size_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+void MappedSegment::sync(bool blocking) {
+    if (msync(data_, size_, blocking ? MS_SYNC : MS_ASYNC) != 0) {
+        LOG_ERROR("msync failed on {}: {}", path_, std::strerror(errno));
+    }
+}
+
+} // namespace persistence
\ No newline at end of file
@@ -76,15 +76,18 @@ bool RedisStorage::saveTrade(const engine::Trade& trade) {
     
     std::stringstream ss;
     ss << "HSET " << generateTradeKey(trade) << " "
+       << "symbol " << trade.getSymbol() << " "
        << "buy_order_id " << trade.getBuyOrderId() << " "
        << "sell_order_id " << trade.getSellOrderId() << " "
+       << "buyer_id " << trade.getBuyerId() << " "
+       << "seller_id " << trade.getSellerId() << " "
        << "quantity " << trade.getQuantity() << " "
        << "price " << trade.getPrice() << " "
        << "timestamp " << trade.getTimestamp().count();
     
     // Also add to sorted set for time-based queries
     std::stringstream zaddCmd;
-    zaddCmd << "ZADD trades:" << "SYMBOL" << " " 
+    zaddCmd << "ZADD trades:" << trade.getSymbol() << " " 
             << trade.getTimestamp().count() << " " << generateTradeKey(trade);
     executeCommand(zaddCmd.str());
     
@@ -124,7 +127,7 @@ std::string RedisStorage::generateOrderKey(engine::OrderId orderId) const {
 }
 
 std::string RedisStorage::generateTradeKey(const engine::Trade& trade) const {
-    return "trade:" + std::to_string(trade.getId());
+    return "trade:" + trade.getSymbol() + ":" + std::to_string(trade.getId());
 }
 
 std::string RedisStorage::generateOrderBookKey(const std::string& symbol) const {
@@ -3,40 +3,78 @@
 #include "../utils/Logger.hpp"
 #include <algorithm>
 #include <cmath>
-#include <numeric>
+#include <stdexcept>
 
 namespace risk {
 
-CircuitBreaker::CircuitBreaker(const utils::Config& config) : config_(config) {
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+CircuitBreaker::CircuitBreaker(const utils::Config& config)
+    : maxSymbols_(static_cast<size_t>(std::max(1, config.get<int>("risk.max_instruments", 64))))
+    , haltDurationNs_(static_cast<int64_t>(
+          std::max(0.001, config.get<double>("risk.circuit_breaker.halt_seconds", 300.0)) * 1e9))
+    , symbolData_(std::make_unique<SymbolData[]>(maxSymbols_))
+    , config_(config)
+{
     loadConfiguration();
-    LOG_INFO("Circuit Breaker initialized");
+    LOG_INFO("Circuit Breaker initialized for {} symbols", symbolIndex_.size());
 }
 
 void CircuitBreaker::loadConfiguration() {
-    // Load circuit breaker limits from config
-    // This would typically read from config file
+    for (const auto& symbol : config_.getVector<std::string>("engine.symbols")) {
+        registerSymbol(symbol);
+    }
 }
 
-bool CircuitBreaker::checkPriceMove(const std::string& symbol, double newPrice) {
-    std::unique_lock lock(dataMutex_);
+void CircuitBreaker::registerSymbol(const std::string& symbol) {
+    if (symbolIndex_.count(symbol)) {
+        return;
+    }
+    if (symbolIndex_.size() >= maxSymbols_) {
+        throw std::runtime_error("Too many symbols for risk.max_instruments: " + symbol);
+    }
+    
+    auto& data = symbolData_[symbolIndex_.size()];
+    data.maxPriceMovePercent = config_.get<double>("risk.circuit_breaker.max_price_move", data.maxPriceMovePercent);
+    data.maxVolumeSpike = config_.get<int>("risk.circuit_breaker.max_volume_spike", static_cast<int>(data.maxVolumeSpike));
+    data.maxOrderRate = config_.get<int>("risk.circuit_breaker.max_order_rate", data.maxOrderRate);
     
-    auto& data = symbolData_[symbol];
+    // Volume: one slice per second over the window; order rate: tenths of the last second
+    int volumeWindowSeconds = std::max(2, config_.get<int>("risk.circuit_breaker.volume_window_seconds", 60));
+    data.volume.configure(1000000000LL, static_cast<size_t>(volumeWindowSeconds));
+    data.orders.configure(100000000LL, 10);
     
-    if (data.priceHistory.empty()) {
-        data.priceHistory.push_back(newPrice);
-        data.referencePrice = newPrice;
+    symbolIndex_.emplace(symbol, symbolIndex_.size());
+}
+
+CircuitBreaker::SymbolData* CircuitBreaker::findSymbol(const std::string& symbol) const {
+    auto it = symbolIndex_.find(symbol);
+    return it != symbolIndex_.end() ? &symbolData_[it->second] : nullptr;
+}
+
+bool CircuitBreaker::checkPriceMove(const std::string& symbol, double newPrice) {
+    auto* data = findSymbol(symbol);
+    if (!data) {
         return true;
     }
     
-    double priceChange = calculatePriceChange(symbol, newPrice);
-    data.priceHistory.push_back(newPrice);
-    
-    // Keep only recent prices (e.g., last 100)
-    if (data.priceHistory.size() > 100) {
-        data.priceHistory.pop_front();
+    // The session's first print, or the first after a halt, is the reference
+    if (data->referencePrice <= 0.0 ||
+        (data->rebaseReference.load(std::memory_order_relaxed) && !isHalted(*data))) {
+        data->rebaseReference.store(false, std::memory_order_relaxed);
+        data->referencePrice = newPrice;
+        return true;
     }
     
-    if (std::abs(priceChange) > data.maxPriceMovePercent) {
+    double priceChange = calculatePriceChange(*data, newPrice);
+    if (std::abs(priceChange) > data->maxPriceMovePercent) {
         LOG_WARNING("Circuit breaker triggered for {}: price moved {:.2f}%", 
                    symbol, priceChange * 100);
         haltSymbol(symbol, "Price movement limit exceeded");
@@ -46,35 +84,16 @@ bool CircuitBreaker::checkPriceMove(const std::string& symbol, double newPrice)
     return true;
 }
 
-bool CircuitBreaker::checkVolatility(const std::string& symbol, double currentVolatility) {
-    std::unique_lock lock(dataMutex_);
-    
-    auto& data = symbolData_[symbol];
-    
-    if (currentVolatility > data.maxVolatility) {
-        LOG_WARNING("Circuit breaker triggered for {}: volatility {:.2f}% exceeded limit", 
-                   symbol, currentVolatility * 100);
-        haltSymbol(symbol, "Volatility limit exceeded");
-        return false;
-    }
-    
-    return true;
-}
-
 bool CircuitBreaker::checkVolumeSpike(const std::string& symbol, int64_t volume) {
-    std::unique_lock lock(dataMutex_);
-    
-    auto& data = symbolData_[symbol];
-    data.volumeHistory.push_back(volume);
-    
-    // Keep only recent volumes (e.g., last 50)
-    if (data.volumeHistory.size() > 50) {
-        data.volumeHistory.pop_front();
+    auto* data = findSymbol(symbol);
+    if (!data) {
+        return true;
     }
     
-    int64_t volumeSpike = calculateVolumeSpike(symbol, volume);
+    data->volume.add(steadyNowNs(), volume);
+    int64_t volumeSpike = calculateVolumeSpike(*data);
     
-    if (volumeSpike > data.maxVolumeSpike) {
+    if (volumeSpike > data->maxVolumeSpike) {
         LOG_WARNING("Circuit breaker triggered for {}: volume spike {} exceeded limit", 
                    symbol, volumeSpike);
         haltSymbol(symbol, "Volume spike detected");
@@ -84,22 +103,17 @@ bool CircuitBreaker::checkVolumeSpike(const std::string& symbol, int64_t volume)
     return true;
 }
 
-bool CircuitBreaker::checkOrderRate(const std::string& symbol, int ordersPerSecond) {
-    std::unique_lock lock(dataMutex_);
-    
-    auto& data = symbolData_[symbol];
-    auto now = std::chrono::system_clock::now();
-    data.orderTimestamps.push_back(now);
-    
-    // Remove timestamps older than 1 second
-    auto oneSecondAgo = now - std::chrono::seconds(1);
-    while (!data.orderTimestamps.empty() && data.orderTimestamps.front() < oneSecondAgo) {
-        data.orderTimestamps.pop_front();
+bool CircuitBreaker::checkOrderRate(const std::string& symbol) {
+    auto* data = findSymbol(symbol);
+    if (!data) {
+        return true;
     }
     
-    int currentOrderRate = data.orderTimestamps.size();
+    // The window covers the last second in 100ms slices
+    data->orders.add(steadyNowNs(), 1);
+    int64_t currentOrderRate = data->orders.total();
     
-    if (currentOrderRate > data.maxOrderRate) {
+    if (currentOrderRate > data->maxOrderRate) {
         LOG_WARNING("Circuit breaker triggered for {}: order rate {} exceeded limit", 
                    symbol, currentOrderRate);
         haltSymbol(symbol, "Order rate limit exceeded");
@@ -110,79 +124,88 @@ bool CircuitBreaker::checkOrderRate(const std::string& symbol, int ordersPerSeco
 }
 
 void CircuitBreaker::haltSymbol(const std::string& symbol, const std::string& reason) {
-    std::unique_lock lock(dataMutex_);
+    auto* data = findSymbol(symbol);
+    if (!data) {
+        LOG_WARNING("Cannot halt unknown symbol {}", symbol);
+        return;
+    }
     
-    auto& data = symbolData_[symbol];
-    data.halted = true;
-    data.haltReason = reason;
-    data.haltTime = std::chrono::system_clock::now();
+    {
+        std::lock_guard lock(haltMutex_);
+        data->haltReason = reason;
+        data->haltTime = std::chrono::system_clock::now();
+    }
+    data->resumeAtNs.store(steadyNowNs() + haltDurationNs_, std::memory_order_relaxed);
+    data->rebaseReference.store(true, std::memory_order_relaxed);
+    data->halted.store(true, std::memory_order_release);
     
-    LOG_ERROR("Symbol {} halted: {}", symbol, reason);
+    LOG_ERROR("Symbol {} halted for {}s: {}", symbol, haltDurationNs_ / 1000000000.0, reason);
 }
 
 void CircuitBreaker::resumeSymbol(const std::string& symbol) {
-    std::unique_lock lock(dataMutex_);
+    auto* data = findSymbol(symbol);
+    if (!data) {
+        return;
+    }
     
-    auto& data = symbolData_[symbol];
-    data.halted = false;
-    data.haltReason.clear();
+    data->halted.store(false, std::memory_order_release);
+    {
+        std::lock_guard lock(haltMutex_);
+        data->haltReason.clear();
+    }
     
     LOG_INFO("Symbol {} resumed", symbol);
 }
 
 bool CircuitBreaker::isSymbolHalted(const std::string& symbol) const {
-    std::shared_lock lock(dataMutex_);
-    
-    auto it = symbolData_.find(symbol);
-    if (it == symbolData_.end()) {
-        return false;
+    auto* data = findSymbol(symbol);
+    return data && isHalted(*data);
+}
+
+bool CircuitBreaker::isHalted(const SymbolData& data) {
+    return data.halted.load(std::memory_order_acquire) &&
+           steadyNowNs() < data.resumeAtNs.load(std::memory_order_relaxed);
+}
+
+void CircuitBreaker::triggerMarketWideHalt(const std::string& reason) {
+    {
+        std::lock_guard lock(haltMutex_);
+        marketHaltReason_ = reason;
+        marketHaltTime_ = std::chrono::system_clock::now();
     }
+    marketWideHalt_.store(true, std::memory_order_release);
     
-    return it->second.halted;
+    LOG_ERROR("Market-wide halt: {}", reason);
 }
 
-double CircuitBreaker::calculatePriceChange(const std::string& symbol, double newPrice) {
-    auto& data = symbolData_[symbol];
-    
-    if (data.referencePrice == 0.0) {
-        return 0.0;
+void CircuitBreaker::liftMarketWideHalt() {
+    marketWideHalt_.store(false, std::memory_order_release);
+    {
+        std::lock_guard lock(haltMutex_);
+        marketHaltReason_.clear();
     }
     
-    return (newPrice - data.referencePrice) / data.referencePrice;
+    LOG_INFO("Market-wide halt lifted");
 }
 
-double CircuitBreaker::calculateVolatility(const std::string& symbol) {
-    auto& data = symbolData_[symbol];
-    
-    if (data.priceHistory.size() < 2) {
+bool CircuitBreaker::isMarketHalted() const {
+    return marketWideHalt_.load(std::memory_order_acquire);
+}
+
+double CircuitBreaker::calculatePriceChange(const SymbolData& data, double newPrice) const {
+    if (data.referencePrice == 0.0) {
         return 0.0;
     }
     
-    // Calculate standard deviation of returns
-    std::vector<double> returns;
-    for (size_t i = 1; i < data.priceHistory.size(); ++i) {
-        double ret = (data.priceHistory[i] - data.priceHistory[i-1]) / data.priceHistory[i-1];
-        returns.push_back(ret);
-    }
-    
-    double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-    double sq_sum = std::inner_product(returns.begin(), returns.end(), returns.begin(), 0.0);
-    double stdev = std::sqrt(sq_sum / returns.size() - mean * mean);
-    
-    return stdev * std::sqrt(252); // Annualized volatility
+    return (newPrice - data.referencePrice) / data.referencePrice;
 }
 
-int64_t CircuitBreaker::calculateVolumeSpike(const std::string& symbol, int64_t currentVolume) {
-    auto& data = symbolData_[symbol];
-    
-    if (data.volumeHistory.size() < 2) {
-        return currentVolume;
-    }
-    
-    int64_t averageVolume = std::accumulate(data.volumeHistory.begin(), 
-                                           data.volumeHistory.end(), 0LL) / data.volumeHistory.size();
+int64_t CircuitBreaker::calculateVolumeSpike(const SymbolData& data) const {
+    // Volume in the current slice against the average of the rest of the window
+    int64_t current = data.volume.current();
+    int64_t averageVolume = (data.volume.total() - current) / static_cast<int64_t>(data.volume.slices() - 1);
     
-    return currentVolume - averageVolume;
+    return current - averageVolume;
 }
 
 } // namespace risk
\ No newline at end of file
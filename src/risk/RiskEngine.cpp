@@ -1,220 +1,727 @@
 // src/risk/RiskEngine.cpp
 #include "RiskEngine.hpp"
+#include "../engine/Order.hpp"
+#include "../engine/Trade.hpp"
 #include "../utils/Logger.hpp"
 #include <algorithm>
 #include <cmath>
-#include <numeric>
+#include <stdexcept>
+#include <thread>
 
 namespace risk {
 
-RiskEngine::RiskEngine(const utils::Config& config) : config_(config) {
-    LOG_INFO("RiskEngine initialized");
+namespace {
+
+constexpr auto relaxed = std::memory_order_relaxed;
+
+} // namespace
+
+RiskEngine::RiskEngine(const utils::Config& config)
+    : maxUsers_(static_cast<size_t>(std::max(1, config.get<int>("risk.max_users", 16384))))
+    , maxInstruments_(static_cast<size_t>(std::max(1, config.get<int>("risk.max_instruments", 64))))
+    , lazyMarkToMarket_(config.get<bool>("risk.lazy_mark_to_market", false))
+    , marketPrices_(std::make_unique<std::atomic<double>[]>(maxInstruments_))
+    , instrumentStats_(std::make_unique<InstrumentStats[]>(maxInstruments_))
+    , varSampleInterval_(std::chrono::milliseconds(std::max(1, config.get<int>("risk.var_sample_interval_ms", 1000))))
+    , config_(config)
+{
+    defaultLimits_.maxPosition = config.get<int>("risk.max_position_per_symbol", static_cast<int>(defaultLimits_.maxPosition));
+    defaultLimits_.maxNotional = config.get<double>("risk.max_notional_per_user", defaultLimits_.maxNotional);
+    defaultLimits_.maxOrderSize = config.get<int>("risk.max_order_size", static_cast<int>(defaultLimits_.maxOrderSize));
+    defaultLimits_.dailyVolumeLimit = config.get<int>("risk.daily_volume_limit", static_cast<int>(defaultLimits_.dailyVolumeLimit));
+    defaultLimits_.maxDrawdown = config.get<double>("risk.max_drawdown", defaultLimits_.maxDrawdown);
+    
+    // One shard per matching lane
+    size_t shardCount = static_cast<size_t>(std::max(1, config.get<int>("engine.matching_threads", 1)));
+    shards_.resize(shardCount);
+    
+    for (auto& shard : shards_) {
+        shard.userCount = (maxUsers_ + shardCount - 1) / shardCount;
+        shard.users = std::make_unique<UserRiskState[]>(shard.userCount);
+        shard.positions = std::make_unique<PositionState[]>(shard.userCount * maxInstruments_);
+        shard.holders.resize(maxInstruments_);
+        shard.marks = std::make_unique<double[]>(maxInstruments_);
+        shard.markSequence = std::make_unique<engine::TradeId[]>(maxInstruments_);
+        
+        for (size_t i = 0; i < shard.userCount; ++i) {
+            auto& user = shard.users[i];
+            user.maxOrderSize.store(defaultLimits_.maxOrderSize, relaxed);
+            user.dailyVolumeLimit.store(defaultLimits_.dailyVolumeLimit, relaxed);
+            user.maxNotional.store(defaultLimits_.maxNotional, relaxed);
+            user.maxDrawdown.store(defaultLimits_.maxDrawdown, relaxed);
+        }
+        for (size_t i = 0; i < shard.userCount * maxInstruments_; ++i) {
+            shard.positions[i].maxPosition.store(defaultLimits_.maxPosition, relaxed);
+        }
+    }
+    
+    for (size_t producer = 0; producer < shardCount; ++producer) {
+        for (size_t owner = 0; owner < shardCount; ++owner) {
+            postTradeRings_.push_back(producer == owner ? nullptr : std::make_unique<PostTradeRing>());
+        }
+    }
+    
+    for (const auto& symbol : config.getVector<std::string>("risk.instruments",
+                                                                config.getVector<std::string>("engine.symbols"))) {
+        registerInstrument(symbol);
+    }
+    
+    LOG_INFO("RiskEngine initialized: {} shards, {} users, {} instruments, {} mark-to-market",
+             shards_.size(), maxUsers_, maxInstruments_, lazyMarkToMarket_ ? "lazy" : "eager");
 }
 
-RiskCheckResult RiskEngine::checkOrder(const engine::Order& order) {
+InstrumentId RiskEngine::registerInstrument(const std::string& symbol) {
+    if (auto it = instrumentIds_.find(symbol); it != instrumentIds_.end()) {
+        return it->second;
+    }
+    
+    if (instrumentSymbols_.size() >= maxInstruments_) {
+        throw std::runtime_error("Too many instruments for risk.max_instruments: " + symbol);
+    }
+    
+    auto id = static_cast<InstrumentId>(instrumentSymbols_.size());
+    instrumentSymbols_.push_back(symbol);
+    instrumentIds_.emplace(symbol, id);
+    return id;
+}
+
+InstrumentId RiskEngine::findInstrument(const std::string& symbol) const {
+    auto it = instrumentIds_.find(symbol);
+    return it != instrumentIds_.end() ? it->second : INVALID_INSTRUMENT;
+}
+
+RiskEngine::UserRiskState* RiskEngine::findUser(engine::UserId userId) const {
+    if (userId >= maxUsers_) {
+        return nullptr;
+    }
+    const auto& shard = shards_[userId % shards_.size()];
+    return &shard.users[userId / shards_.size()];
+}
+
+RiskEngine::UserRiskState& RiskEngine::userState(engine::UserId userId) const {
+    auto* user = findUser(userId);
+    if (!user) {
+        throw std::out_of_range("User id beyond risk.max_users: " + std::to_string(userId));
+    }
+    return *user;
+}
+
+RiskEngine::PositionState& RiskEngine::positionState(engine::UserId userId, InstrumentId instrument) const {
+    const auto& shard = shards_[userId % shards_.size()];
+    return shard.positions[(userId / shards_.size()) * maxInstruments_ + instrument];
+}
+
+RiskCheckResult RiskEngine::checkOrder(engine::Order& order) {
+    auto* user = findUser(order.getUserId());
+    if (!user) {
+        return RiskCheckResult{false, "Unknown user", 0.0};
+    }
+    
+    auto instrument = findInstrument(order.getSymbol());
+    if (instrument == INVALID_INSTRUMENT) {
+        return RiskCheckResult{false, "Unknown instrument", 0.0};
+    }
+    
+    auto& position = positionState(order.getUserId(), instrument);
+    const int64_t quantity = order.getQuantity();
+    const bool buy = order.getSide() == engine::OrderSide::BUY;
+    
     // Check order size limit
-    auto sizeCheck = checkOrderSizeLimit(order.getUserId(), order.getQuantity());
-    if (!sizeCheck.approved) {
-        return sizeCheck;
+    int64_t maxOrderSize = user->maxOrderSize.load(relaxed);
+    if (quantity > maxOrderSize) {
+        return RiskCheckResult{false, "Order size limit exceeded", static_cast<double>(maxOrderSize)};
     }
     
-    // Check position limit
-    auto positionCheck = checkPositionLimit(order.getUserId(), order.getSymbol(), 
-                                          order.getSide(), order.getQuantity());
-    if (!positionCheck.approved) {
-        return positionCheck;
+    // Check position limit, assuming every open order on this side fills too
+    int64_t maxPosition = position.maxPosition.load(relaxed);
+    int64_t netPosition = position.netPosition.load(relaxed);
+    int64_t newPosition = buy ? netPosition + position.openBuyQuantity.load(relaxed) + quantity
+                              : netPosition - position.openSellQuantity.load(relaxed) - quantity;
+    if (std::abs(newPosition) > maxPosition) {
+        return RiskCheckResult{false, "Position limit exceeded", static_cast<double>(maxPosition)};
     }
     
     // Check notional limit
-    double notional = order.getPrice() * order.getQuantity();
-    auto notionalCheck = checkNotionalLimit(order.getUserId(), notional);
-    if (!notionalCheck.approved) {
-        return notionalCheck;
+    double price = reservationPrice(order, instrument);
+    if (price <= 0.0 && order.getType() == engine::OrderType::MARKET) {
+        return RiskCheckResult{false, "No mark to value market order", 0.0};
+    }
+    double maxNotional = user->maxNotional.load(relaxed);
+    if (user->openNotional.load(relaxed) + price * quantity > maxNotional) {
+        return RiskCheckResult{false, "Notional limit exceeded", maxNotional};
     }
     
     // Check daily volume limit
-    auto volumeCheck = checkDailyVolumeLimit(order.getUserId(), order.getQuantity());
-    if (!volumeCheck.approved) {
-        return volumeCheck;
+    int64_t dailyVolumeLimit = user->dailyVolumeLimit.load(relaxed);
+    if (user->dailyVolume.load(relaxed) + quantity > dailyVolumeLimit) {
+        return RiskCheckResult{false, "Daily volume limit exceeded", static_cast<double>(dailyVolumeLimit)};
     }
     
     // Check drawdown limit
-    auto drawdownCheck = checkDrawdownLimit(order.getUserId());
-    if (!drawdownCheck.approved) {
-        return drawdownCheck;
+    double startingEquity = user->startingEquity.load(relaxed);
+    double maxDrawdown = user->maxDrawdown.load(relaxed);
+    double equity = lazyMarkToMarket_ ? markedEquity(order.getUserId(), *user) : user->currentEquity.load(relaxed);
+    if (startingEquity > 0.0 && (startingEquity - equity) / startingEquity > maxDrawdown) {
+        return RiskCheckResult{false, "Drawdown limit exceeded", maxDrawdown};
     }
     
-    // Check price deviation (for market orders)
-    if (order.getType() == engine::OrderType::MARKET) {
-        auto priceCheck = checkPriceDeviation(order.getSymbol(), order.getPrice());
-        if (!priceCheck.approved) {
-            return priceCheck;
+    // Approved: hold the exposure until the book reports fills or a cancel
+    (buy ? position.openBuyQuantity : position.openSellQuantity).fetch_add(quantity, relaxed);
+    user->openNotional.fetch_add(price * quantity, relaxed);
+    order.setReservedPrice(price);
+    
+    return RiskCheckResult{true, "Approved", 0.0};
+}
+
+RiskCheckResult RiskEngine::checkModify(engine::Order& order, int64_t newQuantity, double newPrice) {
+    auto* user = findUser(order.getUserId());
+    auto instrument = findInstrument(order.getSymbol());
+    if (!user || instrument == INVALID_INSTRUMENT) {
+        return RiskCheckResult{false, "Unknown order", 0.0};
+    }
+    
+    auto& position = positionState(order.getUserId(), instrument);
+    const bool buy = order.getSide() == engine::OrderSide::BUY;
+    const int64_t remaining = order.getRemainingQuantity();
+    const int64_t newRemaining = newQuantity - order.getFilledQuantity();
+    const int64_t addedQuantity = newRemaining - remaining;
+    const double addedNotional = newPrice * newRemaining - order.getReservedPrice() * remaining;
+    
+    int64_t maxOrderSize = user->maxOrderSize.load(relaxed);
+    if (newQuantity > maxOrderSize) {
+        return RiskCheckResult{false, "Order size limit exceeded", static_cast<double>(maxOrderSize)};
+    }
+    
+    // Only what the modify adds needs headroom; a reduce always fits
+    if (addedQuantity > 0) {
+        int64_t maxPosition = position.maxPosition.load(relaxed);
+        int64_t netPosition = position.netPosition.load(relaxed);
+        int64_t newPosition = buy ? netPosition + position.openBuyQuantity.load(relaxed) + addedQuantity
+                                  : netPosition - position.openSellQuantity.load(relaxed) - addedQuantity;
+        if (std::abs(newPosition) > maxPosition) {
+            return RiskCheckResult{false, "Position limit exceeded", static_cast<double>(maxPosition)};
+        }
+        
+        int64_t dailyVolumeLimit = user->dailyVolumeLimit.load(relaxed);
+        if (user->dailyVolume.load(relaxed) + addedQuantity > dailyVolumeLimit) {
+            return RiskCheckResult{false, "Daily volume limit exceeded", static_cast<double>(dailyVolumeLimit)};
         }
     }
     
+    double maxNotional = user->maxNotional.load(relaxed);
+    if (addedNotional > 0.0 && user->openNotional.load(relaxed) + addedNotional > maxNotional) {
+        return RiskCheckResult{false, "Notional limit exceeded", maxNotional};
+    }
+    
+    (buy ? position.openBuyQuantity : position.openSellQuantity).fetch_add(addedQuantity, relaxed);
+    user->openNotional.fetch_add(addedNotional, relaxed);
+    order.setReservedPrice(newPrice);
+    
     return RiskCheckResult{true, "Approved", 0.0};
 }
 
-RiskCheckResult RiskEngine::checkPositionLimit(engine::UserId userId, const std::string& symbol, 
-                                              engine::OrderSide side, int64_t quantity) {
-    std::shared_lock lock(riskDataMutex_);
+double RiskEngine::reservationPrice(const engine::Order& order, InstrumentId instrument) const {
+    // Market orders carry a sentinel price, so value them at the last mark (0, and
+    // so rejected, before the instrument's first print); stop market orders at the
+    // stop that elects them
+    switch (order.getType()) {
+        case engine::OrderType::MARKET:
+            return marketPrices_[instrument].load(relaxed);
+        case engine::OrderType::STOP:
+            return order.getStopPrice();
+        default:
+            return order.getPrice();
+    }
+}
+
+RiskCheckResult RiskEngine::checkOrders(std::span<const engine::OrderPtr> orders) {
+    if (orders.empty()) {
+        return RiskCheckResult{true, "Approved", 0.0};
+    }
     
-    auto userIt = userRiskData_.find(userId);
-    if (userIt == userRiskData_.end()) {
-        return RiskCheckResult{true, "No position data", 0.0};
+    const engine::UserId userId = orders.front()->getUserId();
+    auto* user = findUser(userId);
+    if (!user) {
+        return RiskCheckResult{false, "Unknown user", 0.0};
     }
     
-    auto& userData = userIt->second;
-    std::shared_lock userLock(userData.mutex);
+    // Batch totals per instrument and side; only the instruments touched are visited
+    struct BatchExposure {
+        int64_t buyQuantity{0};
+        int64_t sellQuantity{0};
+        bool touched{false};
+    };
+    thread_local std::vector<BatchExposure> exposure;
+    thread_local std::vector<InstrumentId> touched;
+    thread_local std::vector<double> prices;
+    exposure.resize(std::max(exposure.size(), maxInstruments_));
+    touched.clear();
+    prices.clear();
+    
+    RiskCheckResult result{true, "Approved", 0.0};
+    const int64_t maxOrderSize = user->maxOrderSize.load(relaxed);
+    int64_t totalQuantity = 0;
+    double totalNotional = 0.0;
+    
+    for (const auto& order : orders) {
+        if (order->getUserId() != userId) {
+            result = RiskCheckResult{false, "Batch spans users", 0.0};
+            break;
+        }
+        
+        auto instrument = findInstrument(order->getSymbol());
+        if (instrument == INVALID_INSTRUMENT) {
+            result = RiskCheckResult{false, "Unknown instrument", 0.0};
+            break;
+        }
+        
+        const int64_t quantity = order->getQuantity();
+        if (quantity > maxOrderSize) {
+            result = RiskCheckResult{false, "Order size limit exceeded", static_cast<double>(maxOrderSize)};
+            break;
+        }
+        
+        auto& batch = exposure[instrument];
+        if (!batch.touched) {
+            batch.touched = true;
+            touched.push_back(instrument);
+        }
+        (order->getSide() == engine::OrderSide::BUY ? batch.buyQuantity : batch.sellQuantity) += quantity;
+        
+        double price = reservationPrice(*order, instrument);
+        if (price <= 0.0 && order->getType() == engine::OrderType::MARKET) {
+            result = RiskCheckResult{false, "No mark to value market order", 0.0};
+            break;
+        }
+        prices.push_back(price);
+        totalQuantity += quantity;
+        totalNotional += price * quantity;
+    }
     
-    auto posIt = userData.positions.find(symbol);
-    int64_t currentPosition = (posIt != userData.positions.end()) ? posIt->second.netPosition : 0;
+    // Position limits per instrument and side, as if the whole batch and every open order fill
+    for (size_t i = 0; result.approved && i < touched.size(); ++i) {
+        const auto& batch = exposure[touched[i]];
+        auto& position = positionState(userId, touched[i]);
+        int64_t maxPosition = position.maxPosition.load(relaxed);
+        int64_t netPosition = position.netPosition.load(relaxed);
+        int64_t longPosition = netPosition + position.openBuyQuantity.load(relaxed) + batch.buyQuantity;
+        int64_t shortPosition = netPosition - position.openSellQuantity.load(relaxed) - batch.sellQuantity;
+        if ((batch.buyQuantity > 0 && std::abs(longPosition) > maxPosition) ||
+            (batch.sellQuantity > 0 && std::abs(shortPosition) > maxPosition)) {
+            result = RiskCheckResult{false, "Position limit exceeded", static_cast<double>(maxPosition)};
+        }
+    }
     
-    int64_t newPosition = currentPosition + ((side == engine::OrderSide::BUY) ? quantity : -quantity);
+    if (result.approved) {
+        double maxNotional = user->maxNotional.load(relaxed);
+        int64_t dailyVolumeLimit = user->dailyVolumeLimit.load(relaxed);
+        double startingEquity = user->startingEquity.load(relaxed);
+        double maxDrawdown = user->maxDrawdown.load(relaxed);
+        double equity = lazyMarkToMarket_ ? markedEquity(userId, *user) : user->currentEquity.load(relaxed);
+        
+        if (user->openNotional.load(relaxed) + totalNotional > maxNotional) {
+            result = RiskCheckResult{false, "Notional limit exceeded", maxNotional};
+        } else if (user->dailyVolume.load(relaxed) + totalQuantity > dailyVolumeLimit) {
+            result = RiskCheckResult{false, "Daily volume limit exceeded", static_cast<double>(dailyVolumeLimit)};
+        } else if (startingEquity > 0.0 && (startingEquity - equity) / startingEquity > maxDrawdown) {
+            result = RiskCheckResult{false, "Drawdown limit exceeded", maxDrawdown};
+        }
+    }
     
-    if (std::abs(newPosition) > userData.limits.maxPosition) {
-        return RiskCheckResult{false, "Position limit exceeded", 
-                              static_cast<double>(userData.limits.maxPosition)};
+    // Approved: reserve the aggregate, one add per instrument side
+    if (result.approved) {
+        for (InstrumentId instrument : touched) {
+            auto& position = positionState(userId, instrument);
+            position.openBuyQuantity.fetch_add(exposure[instrument].buyQuantity, relaxed);
+            position.openSellQuantity.fetch_add(exposure[instrument].sellQuantity, relaxed);
+        }
+        user->openNotional.fetch_add(totalNotional, relaxed);
+        for (size_t i = 0; i < orders.size(); ++i) {
+            orders[i]->setReservedPrice(prices[i]);
+        }
     }
     
-    return RiskCheckResult{true, "Position check passed", 0.0};
+    for (InstrumentId instrument : touched) {
+        exposure[instrument] = BatchExposure{};
+    }
+    return result;
 }
 
-RiskCheckResult RiskEngine::checkOrderSizeLimit(engine::UserId userId, int64_t orderSize) {
-    std::shared_lock lock(riskDataMutex_);
+void RiskEngine::recordTrades(std::span<const engine::Trade> trades, size_t producerShard) {
+    if (trades.empty()) {
+        return;
+    }
     
-    auto userIt = userRiskData_.find(userId);
-    if (userIt == userRiskData_.end()) {
-        return RiskCheckResult{true, "No user data", 0.0};
+    // One order's trades are all in one instrument
+    InstrumentId instrument = findInstrument(trades.front().getSymbol());
+    if (instrument == INVALID_INSTRUMENT) {
+        return;
     }
     
-    auto& userData = userIt->second;
-    std::shared_lock userLock(userData.mutex);
+    for (const auto& trade : trades) {
+        PostTradeUpdate update;
+        update.instrument = instrument;
+        update.price = trade.getPrice();
+        update.sequence = trade.getId();
+        
+        update.userId = trade.getBuyerId();
+        update.quantity = trade.getQuantity();
+        postUpdate(producerShard, shardOf(update.userId), update);
+        
+        update.userId = trade.getSellerId();
+        update.quantity = -trade.getQuantity();
+        postUpdate(producerShard, shardOf(update.userId), update);
+    }
+    
+    const auto& last = trades.back();
+    marketPrices_[instrument].store(last.getPrice(), relaxed);
+    updateReturnStatistics(instrument, trades);
+    
+    // Any shard may hold the instrument: every one marks to the last print
+    if (!lazyMarkToMarket_) {
+        PostTradeUpdate mark;
+        mark.kind = PostTradeUpdate::Kind::MARK;
+        mark.instrument = instrument;
+        mark.price = last.getPrice();
+        mark.sequence = last.getId();
+        for (size_t owner = 0; owner < shards_.size(); ++owner) {
+            postUpdate(producerShard, owner, mark);
+        }
+    }
+}
+
+void RiskEngine::applyPostTradeUpdates(size_t shard) {
+    const size_t shardCount = shards_.size();
+    for (size_t producer = 0; producer < shardCount; ++producer) {
+        if (producer == shard) {
+            continue;
+        }
+        auto& ring = *postTradeRings_[producer * shardCount + shard];
+        while (auto update = ring.pop()) {
+            applyUpdate(shards_[shard], *update);
+        }
+    }
+}
+
+void RiskEngine::releaseExposure(const std::string& symbol, std::span<const engine::ExecutionEvent> events,
+                                 size_t producerShard) {
+    InstrumentId instrument = findInstrument(symbol);
+    if (instrument == INVALID_INSTRUMENT) {
+        return;
+    }
+    
+    for (const auto& event : events) {
+        int64_t direction = event.side == engine::OrderSide::BUY ? 1 : -1;
+        switch (event.execType) {
+            case engine::ExecType::PARTIAL_FILL:
+            case engine::ExecType::FILL: {
+                // Queued behind the trade's FILL so the owner never sees the quantity in neither
+                PostTradeUpdate update;
+                update.kind = PostTradeUpdate::Kind::RELEASE;
+                update.userId = event.userId;
+                update.instrument = instrument;
+                update.quantity = direction * event.lastQty;
+                update.price = event.reservedPx;
+                if (producerShard == NO_SHARD) {
+                    applyUpdate(shards_[shardOf(event.userId)], update);
+                } else {
+                    postUpdate(producerShard, shardOf(event.userId), update);
+                }
+                break;
+            }
+            case engine::ExecType::CANCELLED:
+                release(event.userId, instrument, direction * (event.orderQty - event.cumQty), event.reservedPx);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void RiskEngine::release(engine::UserId userId, InstrumentId instrument, int64_t signedQuantity, double price) {
+    auto* user = findUser(userId);
+    if (!user || signedQuantity == 0) {
+        return;
+    }
     
-    if (orderSize > userData.limits.maxOrderSize) {
-        return RiskCheckResult{false, "Order size limit exceeded", 
-                              static_cast<double>(userData.limits.maxOrderSize)};
+    auto& position = positionState(userId, instrument);
+    int64_t quantity = std::abs(signedQuantity);
+    (signedQuantity > 0 ? position.openBuyQuantity : position.openSellQuantity).fetch_sub(quantity, relaxed);
+    user->openNotional.fetch_sub(price * quantity, relaxed);
+}
+
+void RiskEngine::postUpdate(size_t producerShard, size_t ownerShard, const PostTradeUpdate& update) {
+    if (ownerShard == producerShard) {
+        applyUpdate(shards_[ownerShard], update);
+        return;
     }
     
-    return RiskCheckResult{true, "Order size check passed", 0.0};
+    auto& ring = *postTradeRings_[producerShard * shards_.size() + ownerShard];
+    while (!ring.push(update)) {
+        // The owner is behind. Drain our own inbound rings meanwhile, or two
+        // lanes filling each other's rings would wait on each other forever.
+        applyPostTradeUpdates(producerShard);
+        std::this_thread::yield();
+    }
+}
+
+void RiskEngine::applyUpdate(RiskShard& shard, const PostTradeUpdate& update) {
+    switch (update.kind) {
+        case PostTradeUpdate::Kind::FILL:
+            updatePosition(shard, update.userId, update.instrument, update.quantity, update.price);
+            break;
+        case PostTradeUpdate::Kind::MARK:
+            updateMark(shard, update.instrument, update.price, update.sequence);
+            break;
+        case PostTradeUpdate::Kind::RELEASE:
+            release(update.userId, update.instrument, update.quantity, update.price);
+            break;
+    }
 }
 
-void RiskEngine::recordTrade(const engine::Trade& trade) {
-    // This would be called by the matching engine when a trade occurs
-    // For now, we'll update positions based on the trade
+void RiskEngine::updatePosition(RiskShard& shard, engine::UserId userId, InstrumentId instrument,
+                               int64_t signedQuantity, double price) {
+    auto* user = findUser(userId);
+    if (!user) {
+        return;
+    }
+    auto& position = positionState(userId, instrument);
+    const int64_t quantity = std::abs(signedQuantity);
+    const bool buy = signedQuantity > 0;
     
-    // In a real implementation, we'd have the user IDs from the orders
-    // For demonstration, we'll use placeholder user IDs
-    engine::UserId buyerId = 1; // Would come from buy order
-    engine::UserId sellerId = 2; // Would come from sell order
+    user->dailyVolume.fetch_add(quantity, relaxed);
+    user->dailyNotional.fetch_add(quantity * price, relaxed);
     
-    updatePosition(buyerId, "SYMBOL", engine::OrderSide::BUY, 
-                  trade.getQuantity(), trade.getPrice());
-    updatePosition(sellerId, "SYMBOL", engine::OrderSide::SELL, 
-                  trade.getQuantity(), trade.getPrice());
+    if (!position.listed) {
+        position.listed = true;
+        shard.holders[instrument].push_back(static_cast<uint32_t>(userId / shards_.size()));
+    }
     
-    // Update daily volume
-    {
-        std::unique_lock lock(riskDataMutex_);
-        if (auto it = userRiskData_.find(buyerId); it != userRiskData_.end()) {
-            std::unique_lock userLock(it->second.mutex);
-            it->second.dailyVolume += trade.getQuantity();
-            it->second.dailyNotional += trade.getQuantity() * trade.getPrice();
-        }
-        if (auto it = userRiskData_.find(sellerId); it != userRiskData_.end()) {
-            std::unique_lock userLock(it->second.mutex);
-            it->second.dailyVolume += trade.getQuantity();
-            it->second.dailyNotional += trade.getQuantity() * trade.getPrice();
+    // The first print of an instrument is its first mark
+    double mark = shard.marks[instrument];
+    if (mark <= 0.0) {
+        mark = price;
+        shard.marks[instrument] = price;
+    }
+    
+    int64_t netPosition = position.netPosition.load(relaxed);
+    double costBasis = position.costBasis.load(relaxed);
+    double unrealizedBefore = netPosition * mark - costBasis;
+    double realized = 0.0;
+    
+    // The part of the fill that reduces the position realises PnL against average cost
+    if (netPosition != 0 && (netPosition > 0) != buy) {
+        int64_t closed = std::min(quantity, std::abs(netPosition));
+        int64_t direction = netPosition > 0 ? 1 : -1;
+        double closedCost = costBasis * closed / std::abs(netPosition);
+        realized = direction * closed * price - closedCost;
+        costBasis -= closedCost;
+        netPosition -= direction * closed;
+        signedQuantity += direction * closed;
+    }
+    netPosition += signedQuantity;
+    costBasis += signedQuantity * price;
+    
+    position.netPosition.store(netPosition, relaxed);
+    position.costBasis.store(costBasis, relaxed);
+    position.realizedPnl.store(position.realizedPnl.load(relaxed) + realized, relaxed);
+    (buy ? position.buyQuantity : position.sellQuantity).fetch_add(quantity, relaxed);
+    
+    double equityChange = realized;
+    if (!lazyMarkToMarket_) {
+        equityChange += (netPosition * mark - costBasis) - unrealizedBefore;
+    }
+    user->currentEquity.store(user->currentEquity.load(relaxed) + equityChange, relaxed);
+}
+
+void RiskEngine::updateReturnStatistics(InstrumentId instrument, std::span<const engine::Trade> trades) {
+    auto& stats = instrumentStats_[instrument];
+    for (const auto& trade : trades) {
+        double price = trade.getPrice();
+        if (stats.lastPrint > 0.0) {
+            double tickReturn = price / stats.lastPrint - 1.0;
+            stats.tickReturns.add(tickReturn);
+            stats.recentTickReturns.add(tickReturn);
         }
+        stats.lastPrint = price;
     }
+    
+    stats.ticks.store(stats.tickReturns.count(), relaxed);
+    stats.meanReturn.store(stats.tickReturns.mean(), relaxed);
+    stats.variance.store(stats.tickReturns.variance(), relaxed);
+    stats.ewmaVariance.store(stats.recentTickReturns.variance(), relaxed);
 }
 
-void RiskEngine::updatePosition(engine::UserId userId, const std::string& symbol, 
-                               engine::OrderSide side, int64_t quantity, double price) {
-    std::unique_lock lock(riskDataMutex_);
+void RiskEngine::updateMark(RiskShard& shard, InstrumentId instrument, double price, engine::TradeId sequence) {
+    // Prints reach a shard through one ring per producer; drop one overtaken by a later print
+    if (sequence <= shard.markSequence[instrument]) {
+        return;
+    }
+    double previous = shard.marks[instrument];
+    shard.marks[instrument] = price;
+    shard.markSequence[instrument] = sequence;
+    if (previous <= 0.0 || previous == price) {
+        return;
+    }
     
-    auto& userData = userRiskData_[userId];
-    std::unique_lock userLock(userData.mutex);
+    // Incremental mark-to-market over this shard's holders of the instrument only
+    double delta = price - previous;
+    for (uint32_t local : shard.holders[instrument]) {
+        int64_t netPosition = shard.positions[local * maxInstruments_ + instrument].netPosition.load(relaxed);
+        if (netPosition != 0) {
+            auto& equity = shard.users[local].currentEquity;
+            equity.store(equity.load(relaxed) + netPosition * delta, relaxed);
+        }
+    }
+}
+
+double RiskEngine::markedEquity(engine::UserId userId, const UserRiskState& user) const {
+    double equity = user.currentEquity.load(relaxed);
+    for (InstrumentId instrument = 0; instrument < instrumentSymbols_.size(); ++instrument) {
+        const auto& position = positionState(userId, instrument);
+        int64_t netPosition = position.netPosition.load(relaxed);
+        if (netPosition != 0) {
+            equity += netPosition * marketPrices_[instrument].load(relaxed) - position.costBasis.load(relaxed);
+        }
+    }
+    return equity;
+}
+
+Position RiskEngine::getPosition(engine::UserId userId, const std::string& symbol) const {
+    Position result;
+    result.symbol = symbol;
     
-    auto& position = userData.positions[symbol];
-    position.symbol = symbol;
+    auto instrument = findInstrument(symbol);
+    if (instrument == INVALID_INSTRUMENT || !findUser(userId)) {
+        return result;
+    }
     
-    if (side == engine::OrderSide::BUY) {
-        position.netPosition += quantity;
-        position.buyQuantity += quantity;
-    } else {
-        position.netPosition -= quantity;
-        position.sellQuantity += quantity;
+    const auto& position = positionState(userId, instrument);
+    double mark = marketPrices_[instrument].load(relaxed);
+    result.netPosition = position.netPosition.load(relaxed);
+    result.notionalValue = result.netPosition * mark;
+    result.buyQuantity = position.buyQuantity.load(relaxed);
+    result.sellQuantity = position.sellQuantity.load(relaxed);
+    result.realizedPnl = position.realizedPnl.load(relaxed);
+    result.unrealizedPnl = mark > 0.0 ? result.netPosition * mark - position.costBasis.load(relaxed) : 0.0;
+    return result;
+}
+
+std::unordered_map<std::string, Position> RiskEngine::getAllPositions(engine::UserId userId) const {
+    std::unordered_map<std::string, Position> result;
+    if (!findUser(userId)) {
+        return result;
     }
     
-    // Update notional value with current market price
-    std::shared_lock priceLock(pricesMutex_);
-    if (auto priceIt = marketPrices_.find(symbol); priceIt != marketPrices_.end()) {
-        position.notionalValue = position.netPosition * priceIt->second;
-        
-        // Update unrealized PnL
-        double avgPrice = (position.buyQuantity > 0 || position.sellQuantity > 0) ?
-            (position.buyQuantity - position.sellQuantity) * price / position.netPosition : 0.0;
-        position.unrealizedPnl = position.netPosition * (priceIt->second - avgPrice);
+    for (InstrumentId instrument = 0; instrument < instrumentSymbols_.size(); ++instrument) {
+        const auto& position = positionState(userId, instrument);
+        if (position.buyQuantity.load(relaxed) != 0 || position.sellQuantity.load(relaxed) != 0) {
+            const auto& symbol = instrumentSymbols_[instrument];
+            result.emplace(symbol, getPosition(userId, symbol));
+        }
     }
+    return result;
 }
 
-void RiskEngine::updateMarketPrice(const std::string& symbol, double price) {
-    std::unique_lock lock(pricesMutex_);
-    marketPrices_[symbol] = price;
-    
-    // Update all positions with this symbol
-    std::shared_lock riskLock(riskDataMutex_);
-    for (auto& [userId, userData] : userRiskData_) {
-        std::unique_lock userLock(userData.mutex);
-        if (auto posIt = userData.positions.find(symbol); posIt != userData.positions.end()) {
-            auto& position = posIt->second;
-            position.notionalValue = position.netPosition * price;
-            
-            // Recalculate unrealized PnL
-            // This is simplified - in reality, we'd track cost basis
-            double avgPrice = (position.buyQuantity > 0 || position.sellQuantity > 0) ?
-                std::abs(position.netPosition * price / position.netPosition) : 0.0;
-            position.unrealizedPnl = position.netPosition * (price - avgPrice);
-            
-            updateEquity(userId, symbol, price);
+void RiskEngine::setPositionLimit(engine::UserId userId, const std::string& symbol, int64_t limit) {
+    userState(userId);
+    auto instrument = findInstrument(symbol);
+    if (instrument == INVALID_INSTRUMENT) {
+        throw std::invalid_argument("Unknown instrument: " + symbol);
+    }
+    positionState(userId, instrument).maxPosition.store(limit, relaxed);
+}
+
+void RiskEngine::setNotionalLimit(engine::UserId userId, double limit) {
+    userState(userId).maxNotional.store(limit, relaxed);
+}
+
+void RiskEngine::setDailyVolumeLimit(engine::UserId userId, int64_t limit) {
+    userState(userId).dailyVolumeLimit.store(limit, relaxed);
+}
+
+void RiskEngine::setMaxOrderSize(engine::UserId userId, int64_t size) {
+    userState(userId).maxOrderSize.store(size, relaxed);
+}
+
+void RiskEngine::resetDailyCounters() {
+    for (auto& shard : shards_) {
+        for (size_t i = 0; i < shard.userCount; ++i) {
+            shard.users[i].dailyVolume.store(0, relaxed);
+            shard.users[i].dailyNotional.store(0.0, relaxed);
         }
     }
 }
 
-double RiskEngine::calculateVar(engine::UserId userId, double confidenceLevel) const {
-    std::shared_lock lock(riskDataMutex_);
+bool RiskEngine::sampleReturns(std::chrono::steady_clock::time_point now) {
+    if (now < nextVarSample_) {
+        return false;
+    }
+    nextVarSample_ = now + varSampleInterval_;
     
-    auto userIt = userRiskData_.find(userId);
-    if (userIt == userRiskData_.end()) {
-        return 0.0;
+    // Every ring gets a sample, zero for an instrument that has not moved or printed,
+    // so index t lines up across instruments
+    for (InstrumentId instrument = 0; instrument < instrumentSymbols_.size(); ++instrument) {
+        auto& stats = instrumentStats_[instrument];
+        double price = marketPrices_[instrument].load(relaxed);
+        double sampled = stats.lastSampledPrice > 0.0 && price > 0.0 ? price / stats.lastSampledPrice - 1.0 : 0.0;
+        stats.sampledReturns.push(sampled);
+        if (price > 0.0) {
+            stats.lastSampledPrice = price;
+        }
+    }
+    varSamples_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+ReturnStatistics RiskEngine::getReturnStatistics(const std::string& symbol) const {
+    ReturnStatistics result;
+    InstrumentId instrument = findInstrument(symbol);
+    if (instrument == INVALID_INSTRUMENT) {
+        return result;
     }
     
-    return calculatePortfolioVaR(userIt->second, confidenceLevel);
+    const auto& stats = instrumentStats_[instrument];
+    result.ticks = stats.ticks.load(relaxed);
+    result.meanReturn = stats.meanReturn.load(relaxed);
+    result.volatility = std::sqrt(stats.variance.load(relaxed));
+    result.ewmaVolatility = std::sqrt(stats.ewmaVariance.load(relaxed));
+    result.varSamples = stats.sampledReturns.size();
+    return result;
 }
 
-double RiskEngine::calculatePortfolioVaR(const UserRiskData& userData, double confidenceLevel) const {
-    // Simplified VaR calculation
-    // In production, this would use historical simulation or parametric methods
-    if (userData.portfolioReturns.empty()) {
+double RiskEngine::calculateVar(engine::UserId userId, double confidenceLevel) const {
+    if (!findUser(userId)) {
         return 0.0;
     }
     
-    // For demonstration, using a simple standard deviation approach
-    double sum = std::accumulate(userData.portfolioReturns.begin(), 
-                                userData.portfolioReturns.end(), 0.0);
-    double mean = sum / userData.portfolioReturns.size();
+    uint64_t end = varSamples_.load(std::memory_order_acquire);
+    size_t window = static_cast<size_t>(std::min<uint64_t>(end, VAR_WINDOW));
+    if (window == 0) {
+        return 0.0;
+    }
     
-    double sq_sum = std::inner_product(userData.portfolioReturns.begin(), 
-                                      userData.portfolioReturns.end(),
-                                      userData.portfolioReturns.begin(), 0.0);
-    double stdev = std::sqrt(sq_sum / userData.portfolioReturns.size() - mean * mean);
+    // Scenario PnL[t] = sum over held instruments of exposure * return[t]
+    thread_local std::vector<double> scenarios;
+    thread_local std::vector<double> returns;
+    scenarios.assign(window, 0.0);
+    returns.resize(window);
     
-    // Assuming normal distribution, 95% VaR is 1.645 standard deviations
-    double zScore = (confidenceLevel == 0.95) ? 1.645 : 
-                   (confidenceLevel == 0.99) ? 2.326 : 1.0;
+    for (InstrumentId instrument = 0; instrument < instrumentSymbols_.size(); ++instrument) {
+        int64_t netPosition = positionState(userId, instrument).netPosition.load(relaxed);
+        if (netPosition == 0) {
+            continue;
+        }
+        double exposure = netPosition * marketPrices_[instrument].load(relaxed);
+        instrumentStats_[instrument].sampledReturns.copyRange(end, window, returns.data());
+        axpy(exposure, returns.data(), scenarios.data(), window);
+    }
     
-    return zScore * stdev * userData.currentEquity;
+    // The loss at the confidence quantile: the k-th worst scenario
+    auto k = static_cast<size_t>((1.0 - confidenceLevel) * static_cast<double>(window));
+    k = std::min(k, window - 1);
+    std::nth_element(scenarios.begin(), scenarios.begin() + k, scenarios.end());
+    return std::max(0.0, -scenarios[k]);
 }
 
 } // namespace risk
\ No newline at end of file
@@ -0,0 +1,31 @@
+// src/utils/ApiKeys.cpp
+#include "ApiKeys.hpp"
+#include "Logger.hpp"
+#include <charconv>
+
+namespace utils {
+
+ApiKeys::ApiKeys(const std::vector<std::string>& entries) {
+    for (const auto& entry : entries) {
+        auto colon = entry.rfind(':');
+        engine::UserId userId{};
+        auto result = colon == std::string::npos || colon == 0
+            ? std::from_chars_result{entry.data(), std::errc::invalid_argument}
+            : std::from_chars(entry.data() + colon + 1, entry.data() + entry.size(), userId);
+        if (result.ec != std::errc() || result.ptr != entry.data() + entry.size()) {
+            LOG_ERROR("Ignoring malformed api.keys entry (expected \"key:userId\")");
+            continue;
+        }
+        users_[entry.substr(0, colon)] = userId;
+    }
+}
+
+std::optional<engine::UserId> ApiKeys::userOf(std::string_view key) const {
+    auto it = users_.find(std::string(key));
+    if (it == users_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+} // namespace utils
\ No newline at end of file
@@ -0,0 +1,166 @@
+// tests/performance/BenchmarkFixThroughput.cpp
+#include <benchmark/benchmark.h>
+#include <networking/MappedFixStore.hpp>
+#include <quickfix/Application.h>
+#include <quickfix/FileStore.h>
+#include <quickfix/Log.h>
+#include <quickfix/Session.h>
+#include <quickfix/SessionSettings.h>
+#include <quickfix/SocketInitiator.h>
+#include <quickfix/ThreadedSocketAcceptor.h>
+#include <quickfix/fix42/ExecutionReport.h>
+#include <quickfix/fix42/NewOrderSingle.h>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+// FIX session throughput with QuickFIX's FileStore versus MappedFixStore. The
+// store benchmarks isolate set() on an ExecutionReport-sized message; the session
+// benchmarks run a local initiator -> acceptor pair over loopback TCP, so every
+// NewOrderSingle is persisted on both sides, and count messages per second.
+
+namespace {
+
+enum class StoreType { FILE, MAPPED };
+
+const char* storeDirectory(StoreType type) {
+    return type == StoreType::FILE ? "/tmp/ome-bench-filestore" : "/tmp/ome-bench-mappedstore";
+}
+
+std::unique_ptr<FIX::MessageStoreFactory> makeStoreFactory(StoreType type, const FIX::SessionSettings& settings) {
+    if (type == StoreType::FILE) {
+        return std::make_unique<FIX::FileStoreFactory>(settings);
+    }
+    return std::make_unique<networking::MappedFixStoreFactory>(settings);
+}
+
+std::string sampleExecutionReport() {
+    FIX42::ExecutionReport report(
+        FIX::OrderID("1000001"), FIX::ExecID("2000001"), FIX::ExecTransType(FIX::ExecTransType_NEW),
+        FIX::ExecType(FIX::ExecType_PARTIAL_FILL), FIX::OrdStatus(FIX::OrdStatus_PARTIALLY_FILLED),
+        FIX::Symbol("AAPL"), FIX::Side(FIX::Side_BUY), FIX::LeavesQty(400), FIX::CumQty(100), FIX::AvgPx(150.25));
+    report.set(FIX::ClOrdID("client-order-000001"));
+    report.set(FIX::LastShares(100));
+    report.set(FIX::LastPx(150.25));
+    report.getHeader().set(FIX::SenderCompID("EXCHANGE"));
+    report.getHeader().set(FIX::TargetCompID("CLIENT"));
+    return report.toString();
+}
+
+void runStoreSet(benchmark::State& state, StoreType type) {
+    std::filesystem::remove_all(storeDirectory(type));
+    
+    std::istringstream config(std::string("[DEFAULT]\nFileStorePath=") + storeDirectory(type) + "\n");
+    FIX::SessionSettings settings(config);
+    auto factory = makeStoreFactory(type, settings);
+    
+    FIX::SessionID sessionID("FIX.4.2", "EXCHANGE", "CLIENT");
+    FIX::MessageStore* store = factory->create(sessionID);
+    
+    auto message = sampleExecutionReport();
+    for (auto _ : state) {
+        int seqNum = store->getNextSenderMsgSeqNum();
+        benchmark::DoNotOptimize(store->set(seqNum, message));
+        store->incrNextSenderMsgSeqNum();
+    }
+    
+    factory->destroy(store);
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(message.size()));
+}
+
+class CountingApplication : public FIX::Application {
+public:
+    std::atomic<uint64_t> received{0};
+    std::atomic<bool> loggedOn{false};
+    
+    void onCreate(const FIX::SessionID&) override {}
+    void onLogon(const FIX::SessionID&) override { loggedOn = true; }
+    void onLogout(const FIX::SessionID&) override { loggedOn = false; }
+    void toAdmin(FIX::Message&, const FIX::SessionID&) override {}
+    void toApp(FIX::Message&, const FIX::SessionID&) override {}
+    void fromAdmin(const FIX::Message&, const FIX::SessionID&) override {}
+    void fromApp(const FIX::Message&, const FIX::SessionID&) override {
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+void runSessionThroughput(benchmark::State& state, StoreType type) {
+    std::filesystem::remove_all(storeDirectory(type));
+    
+    const std::string common = std::string("StartTime=00:00:00\nEndTime=23:59:59\nHeartBtInt=30\n") +
+                               "UseDataDictionary=N\nFileStorePath=" + storeDirectory(type) + "\n";
+    std::istringstream acceptorConfig(
+        "[DEFAULT]\nConnectionType=acceptor\nSocketAcceptPort=5601\n" + common +
+        "[SESSION]\nBeginString=FIX.4.2\nSenderCompID=EXCHANGE\nTargetCompID=CLIENT\n");
+    std::istringstream initiatorConfig(
+        "[DEFAULT]\nConnectionType=initiator\nSocketConnectHost=127.0.0.1\nSocketConnectPort=5601\n"
+        "ReconnectInterval=1\n" + common +
+        "[SESSION]\nBeginString=FIX.4.2\nSenderCompID=CLIENT\nTargetCompID=EXCHANGE\n");
+    
+    FIX::SessionSettings acceptorSettings(acceptorConfig);
+    FIX::SessionSettings initiatorSettings(initiatorConfig);
+    auto acceptorStore = makeStoreFactory(type, acceptorSettings);
+    auto initiatorStore = makeStoreFactory(type, initiatorSettings);
+    FIX::NullLogFactory logFactory;
+    
+    CountingApplication exchange;
+    CountingApplication client;
+    FIX::ThreadedSocketAcceptor acceptor(exchange, *acceptorStore, acceptorSettings, logFactory);
+    FIX::SocketInitiator initiator(client, *initiatorStore, initiatorSettings, logFactory);
+    acceptor.start();
+    initiator.start();
+    
+    while (!client.loggedOn || !exchange.loggedOn) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    
+    const FIX::SessionID sessionID("FIX.4.2", "CLIENT", "EXCHANGE");
+    const int64_t batch = state.range(0);
+    uint64_t sent = 0;
+    
+    for (auto _ : state) {
+        for (int64_t i = 0; i < batch; ++i) {
+            FIX42::NewOrderSingle order(
+                FIX::ClOrdID(std::to_string(++sent)), FIX::HandlInst('1'), FIX::Symbol("AAPL"),
+                FIX::Side(FIX::Side_BUY), FIX::TransactTime(), FIX::OrdType(FIX::OrdType_LIMIT));
+            order.set(FIX::OrderQty(100));
+            order.set(FIX::Price(150.25));
+            FIX::Session::sendToTarget(order, sessionID);
+        }
+        
+        while (exchange.received.load(std::memory_order_relaxed) < sent) {
+            std::this_thread::yield();
+        }
+    }
+    
+    initiator.stop();
+    acceptor.stop();
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+} // namespace
+
+static void BM_StoreSet_FileStore(benchmark::State& state) {
+    runStoreSet(state, StoreType::FILE);
+}
+BENCHMARK(BM_StoreSet_FileStore);
+
+static void BM_StoreSet_MappedStore(benchmark::State& state) {
+    runStoreSet(state, StoreType::MAPPED);
+}
+BENCHMARK(BM_StoreSet_MappedStore);
+
+static void BM_SessionThroughput_FileStore(benchmark::State& state) {
+    runSessionThroughput(state, StoreType::FILE);
+}
+BENCHMARK(BM_SessionThroughput_FileStore)->Arg(1000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_SessionThroughput_MappedStore(benchmark::State& state) {
+    runSessionThroughput(state, StoreType::MAPPED);
+}
+BENCHMARK(BM_SessionThroughput_MappedStore)->Arg(1000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
\ No newline at end of file
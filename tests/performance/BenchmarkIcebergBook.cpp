@@ -0,0 +1,74 @@
+// tests/performance/BenchmarkIcebergBook.cpp
+#include <benchmark/benchmark.h>
+#include <engine/OrderBook.hpp>
+#include <engine/Order.hpp>
+#include <memory>
+
+// Matching against a book of icebergs versus one of plain limit orders at the
+// same levels. Resting orders are large enough never to fill, so every
+// aggressor hits a steady-state book: on the iceberg book each consumed peak is
+// replenished and re-queued, on the plain book the head order just shrinks.
+
+namespace {
+
+constexpr engine::Quantity PEAK = 10;
+constexpr engine::Quantity RESERVE = engine::Quantity{1} << 50;
+constexpr int LEVELS = 10;
+constexpr int ORDERS_PER_LEVEL = 50;
+
+std::unique_ptr<engine::OrderBook> makeBook(bool icebergs, engine::OrderId& nextId) {
+    auto book = std::make_unique<engine::OrderBook>("AAPL");
+    for (int level = 0; level < LEVELS; ++level) {
+        for (int i = 0; i < ORDERS_PER_LEVEL; ++i) {
+            auto order = std::make_shared<engine::Order>(
+                nextId++, 100 + i, "AAPL", icebergs ? engine::OrderType::ICEBERG : engine::OrderType::LIMIT,
+                engine::OrderSide::SELL, 100.0 + level, icebergs ? RESERVE : PEAK * RESERVE);
+            if (icebergs) {
+                order->setPeakSize(PEAK);
+            }
+            book->addOrder(order);
+        }
+    }
+    return book;
+}
+
+void runSweep(benchmark::State& state, bool icebergs) {
+    engine::OrderId nextId = 1;
+    auto book = makeBook(icebergs, nextId);
+    
+    // range(0) peaks taken per aggressor, all at the best level
+    const engine::Quantity quantity = PEAK * state.range(0);
+    std::vector<engine::ExecutionEvent> events;
+    for (auto _ : state) {
+        auto order = std::make_shared<engine::Order>(
+            nextId++, 1, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 100.0, quantity);
+        benchmark::DoNotOptimize(book->addOrder(order));
+        events.clear();
+        book->drainExecutionEvents(events);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+static void BM_Sweep_IcebergBook(benchmark::State& state) {
+    runSweep(state, true);
+}
+BENCHMARK(BM_Sweep_IcebergBook)->Arg(1)->Arg(10)->Arg(100);
+
+static void BM_Sweep_PlainBook(benchmark::State& state) {
+    runSweep(state, false);
+}
+BENCHMARK(BM_Sweep_PlainBook)->Arg(1)->Arg(10)->Arg(100);
+
+static void BM_Depth_IcebergBook(benchmark::State& state) {
+    engine::OrderId nextId = 1;
+    auto book = makeBook(true, nextId);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->getDepth(LEVELS));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Depth_IcebergBook);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,103 @@
+// tests/performance/BenchmarkTransportLatency.cpp
+#include <benchmark/benchmark.h>
+#include <networking/ShmTransport.hpp>
+#include <zmq.hpp>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+// Round-trip latency of a 64-byte order-sized message: client -> echo thread -> client.
+// ZeroMQ transports use PAIR sockets so the numbers reflect the transport, not the
+// batching in ZmqInterface's publisher loop. Both sides busy-spin, so run on a host
+// with at least two free cores (e.g. taskset -c 2,3) or the numbers measure the scheduler.
+
+namespace {
+
+constexpr size_t MESSAGE_SIZE = 64;
+
+void runZmqRoundTrip(benchmark::State& state, const std::string& endpoint) {
+    zmq::context_t context(1);
+    zmq::socket_t server(context, ZMQ_PAIR);
+    zmq::socket_t client(context, ZMQ_PAIR);
+    
+    server.bind(endpoint);
+    client.connect(endpoint);
+    
+    std::atomic<bool> running{true};
+    std::thread echo([&]() {
+        zmq::pollitem_t items[] = {{static_cast<void*>(server), 0, ZMQ_POLLIN, 0}};
+        while (running.load(std::memory_order_relaxed)) {
+            zmq::poll(items, 1, 10);
+            zmq::message_t message;
+            while (server.recv(&message, ZMQ_DONTWAIT)) {
+                server.send(message);
+            }
+        }
+    });
+    
+    std::string payload(MESSAGE_SIZE, 'x');
+    for (auto _ : state) {
+        zmq::message_t request(payload.data(), payload.size());
+        client.send(request);
+        
+        zmq::message_t reply;
+        client.recv(&reply);
+        benchmark::DoNotOptimize(reply.data());
+    }
+    
+    running = false;
+    echo.join();
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+static void BM_RoundTrip_ZmqTcp(benchmark::State& state) {
+    runZmqRoundTrip(state, "tcp://127.0.0.1:5590");
+}
+BENCHMARK(BM_RoundTrip_ZmqTcp)->UseRealTime();
+
+static void BM_RoundTrip_ZmqIpc(benchmark::State& state) {
+    runZmqRoundTrip(state, "ipc:///tmp/order-matching-engine-bench.ipc");
+}
+BENCHMARK(BM_RoundTrip_ZmqIpc)->UseRealTime();
+
+static void BM_RoundTrip_ZmqInproc(benchmark::State& state) {
+    runZmqRoundTrip(state, "inproc://order-matching-engine-bench");
+}
+BENCHMARK(BM_RoundTrip_ZmqInproc)->UseRealTime();
+
+static void BM_RoundTrip_SharedMemory(benchmark::State& state) {
+    networking::ShmTransport engineSide("/ome-bench", networking::ShmTransport::Role::ENGINE);
+    networking::ShmTransport clientSide("/ome-bench", networking::ShmTransport::Role::CLIENT);
+    
+    std::atomic<bool> running{true};
+    std::thread echo([&]() {
+        while (running.load(std::memory_order_relaxed)) {
+            engineSide.poll([&](std::string_view topic, std::string_view message) {
+                while (!engineSide.publish(topic, message)) {}
+            });
+        }
+    });
+    
+    std::string payload(MESSAGE_SIZE, 'x');
+    for (auto _ : state) {
+        while (!clientSide.publish("orders", payload)) {}
+        
+        bool received = false;
+        while (!received) {
+            clientSide.poll([&](std::string_view, std::string_view message) {
+                benchmark::DoNotOptimize(message.data());
+                received = true;
+            }, 1);
+        }
+    }
+    
+    running = false;
+    echo.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RoundTrip_SharedMemory)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,14 @@
+// tests/unit/TestApiKeys.cpp
+#include <gtest/gtest.h>
+#include <utils/ApiKeys.hpp>
+
+TEST(ApiKeysTest, MapsKeysToUsersAndSkipsMalformedEntries) {
+    utils::ApiKeys keys({"alpha:7", "b:e:t:a:12", "nouser", ":3", "gamma:x", "delta:"});
+    
+    EXPECT_EQ(keys.size(), 2);
+    EXPECT_EQ(keys.userOf("alpha"), 7u);
+    EXPECT_EQ(keys.userOf("b:e:t:a"), 12u); // the user id follows the last colon
+    EXPECT_FALSE(keys.userOf("gamma"));
+    EXPECT_FALSE(keys.userOf(""));
+    EXPECT_FALSE(keys.userOf("alpha:7"));
+}
\ No newline at end of file
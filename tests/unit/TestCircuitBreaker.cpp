@@ -0,0 +1,83 @@
+// tests/unit/TestCircuitBreaker.cpp
+#include <gtest/gtest.h>
+#include <risk/CircuitBreaker.hpp>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+class CircuitBreakerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        breaker = std::make_unique<risk::CircuitBreaker>(config);
+        breaker->registerSymbol("AAPL");
+    }
+    
+    utils::Config config;
+    std::unique_ptr<risk::CircuitBreaker> breaker;
+};
+
+TEST_F(CircuitBreakerTest, PriceMoveHaltsSymbol) {
+    EXPECT_TRUE(breaker->checkPriceMove("AAPL", 100.0));
+    EXPECT_TRUE(breaker->checkPriceMove("AAPL", 105.0));
+    EXPECT_FALSE(breaker->isSymbolHalted("AAPL"));
+    
+    EXPECT_FALSE(breaker->checkPriceMove("AAPL", 115.0));
+    EXPECT_TRUE(breaker->isSymbolHalted("AAPL"));
+    
+    breaker->resumeSymbol("AAPL");
+    EXPECT_FALSE(breaker->isSymbolHalted("AAPL"));
+}
+
+TEST_F(CircuitBreakerTest, OrderRateCountsTheLastSecond) {
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(breaker->checkOrderRate("AAPL"));
+    }
+    EXPECT_FALSE(breaker->checkOrderRate("AAPL"));
+    EXPECT_TRUE(breaker->isSymbolHalted("AAPL"));
+}
+
+TEST_F(CircuitBreakerTest, VolumeSpikeAgainstWindowAverage) {
+    EXPECT_TRUE(breaker->checkVolumeSpike("AAPL", 900000));
+    EXPECT_FALSE(breaker->isSymbolHalted("AAPL"));
+    
+    // An empty window averages zero, so a single oversized print trips it
+    breaker->registerSymbol("GOOGL");
+    EXPECT_FALSE(breaker->checkVolumeSpike("GOOGL", 1500000));
+    EXPECT_TRUE(breaker->isSymbolHalted("GOOGL"));
+}
+
+TEST_F(CircuitBreakerTest, UnregisteredSymbolsPass) {
+    EXPECT_TRUE(breaker->checkPriceMove("MSFT", 100.0));
+    EXPECT_TRUE(breaker->checkPriceMove("MSFT", 200.0));
+    breaker->haltSymbol("MSFT", "test");
+    EXPECT_FALSE(breaker->isSymbolHalted("MSFT"));
+}
+
+TEST_F(CircuitBreakerTest, MarketWideHalt) {
+    EXPECT_FALSE(breaker->isMarketHalted());
+    breaker->triggerMarketWideHalt("test");
+    EXPECT_TRUE(breaker->isMarketHalted());
+    breaker->liftMarketWideHalt();
+    EXPECT_FALSE(breaker->isMarketHalted());
+}
+
+TEST_F(CircuitBreakerTest, HaltLiftsAfterItsDurationWithANewReference) {
+    auto path = std::filesystem::temp_directory_path() / "circuit_breaker_test.yaml";
+    std::ofstream(path) << "risk.circuit_breaker.halt_seconds: 0.05\n"; // Config keys are flat
+    utils::Config shortHalts(path.string());
+    std::filesystem::remove(path);
+    
+    risk::CircuitBreaker timed(shortHalts);
+    timed.registerSymbol("AAPL");
+    EXPECT_TRUE(timed.checkPriceMove("AAPL", 100.0));
+    EXPECT_FALSE(timed.checkPriceMove("AAPL", 120.0));
+    EXPECT_TRUE(timed.isSymbolHalted("AAPL"));
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(timed.isSymbolHalted("AAPL"));
+    
+    // 125 would be 25% off the old reference; after the halt it is the reference
+    EXPECT_TRUE(timed.checkPriceMove("AAPL", 125.0));
+    EXPECT_TRUE(timed.checkPriceMove("AAPL", 130.0));
+    EXPECT_FALSE(timed.checkPriceMove("AAPL", 140.0));
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+// tests/unit/TestFixCodec.cpp
+#include <gtest/gtest.h>
+#include <networking/FixCodec.hpp>
+#include <string>
+
+using networking::FixMessageView;
+using networking::FixVersion;
+
+namespace {
+
+std::string buildNewOrderSingle() {
+    char buffer[256];
+    networking::FixMessageBuilder builder(buffer, sizeof(buffer), "FIX.4.2", "D");
+    builder.add(49, "CLIENT")
+           .add(56, "EXCHANGE")
+           .add(34, int64_t{7})
+           .add(11, "ORD-1")
+           .add(55, "AAPL")
+           .add(54, '1')
+           .add(38, int64_t{100})
+           .add(40, '2')
+           .add(44, "150.25");
+    return std::string(builder.finish());
+}
+
+} // namespace
+
+TEST(FixCodecTest, FramesAndParsesBuiltMessage) {
+    auto message = buildNewOrderSingle();
+    
+    EXPECT_EQ(FixMessageView::frameLength(message), static_cast<ptrdiff_t>(message.size()));
+    EXPECT_EQ(FixMessageView::frameLength(message.substr(0, message.size() - 1)), 0);
+    
+    FixMessageView view;
+    ASSERT_TRUE(view.parse(message));
+    EXPECT_EQ(view.getMsgType(), "D");
+    EXPECT_EQ(view.get(11), "ORD-1");
+    EXPECT_EQ(view.get(55), "AAPL");
+    EXPECT_EQ(view.getChar(54), '1');
+    EXPECT_EQ(view.getInt(38), 100);
+    EXPECT_DOUBLE_EQ(view.getDouble(44), 150.25);
+    EXPECT_EQ(view.getInt(34), 7);
+    EXPECT_FALSE(view.has(99));
+}
+
+TEST(FixCodecTest, RejectsCorruptedChecksum) {
+    auto message = buildNewOrderSingle();
+    message[message.find("AAPL")] = 'B';
+    
+    FixMessageView view;
+    EXPECT_FALSE(view.parse(message));
+}
+
+TEST(FixCodecTest, ExecutionReportPatchesVariableFields) {
+    networking::ExecutionReportEncoder<FixVersion::FIX42> encoder;
+    ASSERT_TRUE(encoder.prepare("EXCHANGE", "CLIENT", 42, "ORD-1", "AAPL", '1', 100));
+    
+    auto first = std::string(encoder.encode({1, 1001, '1', '1', 40, 150.25, 60, 40, 150.25}));
+    auto second = std::string(encoder.encode({2, 1002, '2', '2', 60, 150.5, 0, 100, 150.4}));
+    
+    EXPECT_EQ(first.size(), second.size());
+    
+    FixMessageView view;
+    ASSERT_TRUE(view.parse(first));
+    EXPECT_EQ(FixMessageView::frameLength(first), static_cast<ptrdiff_t>(first.size()));
+    EXPECT_EQ(view.getMsgType(), "8");
+    EXPECT_EQ(view.get(20), "0");
+    EXPECT_EQ(view.getInt(37), 42);
+    EXPECT_EQ(view.getInt(32), 40);
+    
+    ASSERT_TRUE(view.parse(second));
+    EXPECT_EQ(view.getInt(34), 2);
+    EXPECT_EQ(view.getInt(17), 1002);
+    EXPECT_EQ(view.getChar(39), '2');
+    EXPECT_EQ(view.getInt(151), 0);
+    EXPECT_EQ(view.getInt(14), 100);
+    EXPECT_DOUBLE_EQ(view.getDouble(31), 150.5);
+    EXPECT_DOUBLE_EQ(view.getDouble(6), 150.4);
+}
+
+TEST(FixCodecTest, Fix44OmitsExecTransType) {
+    networking::ExecutionReportEncoder<FixVersion::FIX44> encoder;
+    ASSERT_TRUE(encoder.prepare("EXCHANGE", "CLIENT", 1, "C", "MSFT", '2', 10));
+    
+    FixMessageView view;
+    ASSERT_TRUE(view.parse(encoder.encode({1, 1, encoder.fillExecType(true), '2', 10, 1.0, 0, 10, 1.0})));
+    EXPECT_EQ(view.getBeginString(), "FIX.4.4");
+    EXPECT_FALSE(view.has(20));
+    EXPECT_EQ(view.getChar(150), 'F');
+}
@@ -0,0 +1,133 @@
+// tests/unit/TestMappedMessageStore.cpp
+#include <gtest/gtest.h>
+#include <persistence/MappedMessageStore.hpp>
+#include <persistence/MappedSegment.hpp>
+#include <unistd.h>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using persistence::MappedMessageStore;
+using persistence::MappedSegment;
+
+namespace {
+
+class MappedMessageStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = (std::filesystem::temp_directory_path() /
+                 ("ome-store-" + std::to_string(::getpid()) + "-" +
+                  ::testing::UnitTest::GetInstance()->current_test_info()->name())).string();
+        std::filesystem::remove(path_);
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+    
+    // 20 bytes, distinct per sequence number
+    static std::string message(uint64_t seqNum) {
+        return std::string(16, static_cast<char>('a' + seqNum % 26)) + "|" + std::to_string(100 + seqNum);
+    }
+    
+    std::string path_;
+};
+
+} // namespace
+
+TEST_F(MappedMessageStoreTest, DataRingWrapOverwritesOnlyTheOldest) {
+    MappedMessageStore store(path_, 16, 64);
+    
+    // 20-byte messages at 0, 20, 40; the fourth does not fit before the end and
+    // starts the next turn at 0, the fifth follows it over the first two
+    for (uint64_t seqNum = 1; seqNum <= 5; ++seqNum) {
+        ASSERT_TRUE(store.set(seqNum, message(seqNum)));
+    }
+    
+    EXPECT_TRUE(store.get(1).empty());
+    EXPECT_TRUE(store.get(2).empty());
+    EXPECT_EQ(store.get(3), message(3));
+    EXPECT_EQ(store.get(4), message(4));
+    EXPECT_EQ(store.get(5), message(5));
+    
+    // Larger than half the ring: refused rather than wrapped over itself
+    EXPECT_FALSE(store.set(6, std::string(33, 'x')));
+    EXPECT_EQ(store.get(3), message(3));
+}
+
+TEST_F(MappedMessageStoreTest, IndexWrapForgetsOlderSequenceNumbers) {
+    MappedMessageStore store(path_, 4, 4096);
+    for (uint64_t seqNum = 1; seqNum <= 6; ++seqNum) {
+        ASSERT_TRUE(store.set(seqNum, message(seqNum)));
+    }
+    
+    // A resend of 1-6 replays what is left and reports the rest as missing
+    std::vector<uint64_t> missing;
+    std::vector<std::string> replayed;
+    store.forEach(1, 6, [&](uint64_t seqNum, std::string_view stored) {
+        if (stored.empty()) {
+            missing.push_back(seqNum);
+        } else {
+            replayed.emplace_back(stored);
+        }
+    });
+    EXPECT_EQ(missing, (std::vector<uint64_t>{1, 2}));
+    EXPECT_EQ(replayed, (std::vector<std::string>{message(3), message(4), message(5), message(6)}));
+}
+
+TEST_F(MappedMessageStoreTest, RecoversMessagesAndSequenceNumbersAfterReopen) {
+    std::chrono::system_clock::time_point created;
+    {
+        MappedMessageStore store(path_, 16, 64);
+        for (uint64_t seqNum = 1; seqNum <= 5; ++seqNum) {
+            store.set(seqNum, message(seqNum));
+            store.incrNextSenderMsgSeqNum();
+        }
+        store.setNextTargetMsgSeqNum(42);
+        created = store.getCreationTime();
+        store.sync(true);
+    }
+    
+    MappedMessageStore store(path_, 16, 64);
+    EXPECT_EQ(store.getNextSenderMsgSeqNum(), 6u);
+    EXPECT_EQ(store.getNextTargetMsgSeqNum(), 42u);
+    EXPECT_EQ(store.getCreationTime(), created);
+    EXPECT_TRUE(store.get(2).empty());
+    EXPECT_EQ(store.get(3), message(3));
+    EXPECT_EQ(store.get(5), message(5));
+    
+    // Writing on continues the ring where the last connection left it
+    ASSERT_TRUE(store.set(6, message(6)));
+    EXPECT_TRUE(store.get(3).empty());
+    EXPECT_EQ(store.get(4), message(4));
+    EXPECT_EQ(store.get(6), message(6));
+    
+    store.reset();
+    EXPECT_EQ(store.getNextSenderMsgSeqNum(), 1u);
+    EXPECT_EQ(store.getNextTargetMsgSeqNum(), 1u);
+    EXPECT_TRUE(store.get(6).empty());
+}
+
+TEST_F(MappedMessageStoreTest, ReopenWithAnotherLayoutThrows) {
+    {
+        MappedMessageStore store(path_, 16, 64);
+        store.set(1, message(1));
+    }
+    EXPECT_THROW(MappedMessageStore(path_, 32, 64), std::runtime_error);
+}
+
+TEST_F(MappedMessageStoreTest, SegmentIsZeroFilledThenKeepsItsContents) {
+    {
+        MappedSegment segment(path_, 4096);
+        EXPECT_TRUE(segment.isNew());
+        EXPECT_EQ(segment.size(), 4096u);
+        EXPECT_EQ(segment.data()[0], 0);
+        EXPECT_EQ(segment.data()[4095], 0);
+        segment.data()[4095] = 'z';
+    }
+    
+    MappedSegment segment(path_, 4096);
+    EXPECT_FALSE(segment.isNew());
+    EXPECT_EQ(segment.data()[4095], 'z');
+}
\ No newline at end of file
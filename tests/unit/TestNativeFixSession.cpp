@@ -0,0 +1,244 @@
+// tests/unit/TestNativeFixSession.cpp
+#include <gtest/gtest.h>
+#include <networking/NativeFixSession.hpp>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using networking::FixMessageBuilder;
+using networking::FixMessageView;
+using networking::NativeFixSession;
+
+namespace {
+
+// Drives a session over a socket pair as the initiating counterparty would
+class NativeFixSessionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        int sockets[2];
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+        peer_ = sockets[1];
+        session_ = std::make_unique<NativeFixSession>(
+            sockets[0], "EXCHANGE",
+            [this](NativeFixSession&, const FixMessageView& message) {
+                handled_.push_back(message.getInt(34));
+            },
+            std::string(),
+            [this](NativeFixSession& session) {
+                loggedOnAs_ = session.getTargetCompId();
+                return !refuseLogon_.load();
+            });
+        thread_ = std::thread([this] { session_->run(); });
+    }
+    
+    void TearDown() override {
+        session_->stop();
+        thread_.join();
+        close(peer_);
+    }
+    
+    void send(std::string_view msgType, int64_t seqNum, bool possDup = false,
+              std::string_view extraTag = {}, std::string_view extraValue = {}) {
+        char buffer[256];
+        FixMessageBuilder builder(buffer, sizeof(buffer), "FIX.4.2", msgType);
+        builder.add(34, seqNum).add(49, "CLIENT").add(56, "EXCHANGE");
+        if (possDup) {
+            builder.add(43, 'Y');
+        }
+        if (msgType == "A") {
+            builder.add(98, int64_t{0}).add(108, int64_t{30});
+        }
+        if (!extraTag.empty()) {
+            builder.add(static_cast<uint32_t>(std::stoul(std::string(extraTag))), extraValue);
+        }
+        auto message = builder.finish();
+        ASSERT_EQ(::write(peer_, message.data(), message.size()), static_cast<ssize_t>(message.size()));
+    }
+    
+    // The next message the session sent, empty after a second without one
+    std::string receive() {
+        while (true) {
+            ptrdiff_t length = FixMessageView::frameLength(received_);
+            if (length > 0) {
+                std::string message = received_.substr(0, static_cast<size_t>(length));
+                received_.erase(0, static_cast<size_t>(length));
+                return message;
+            }
+            pollfd item{peer_, POLLIN, 0};
+            if (::poll(&item, 1, 1000) <= 0) {
+                return {};
+            }
+            char buffer[1024];
+            ssize_t bytes = ::read(peer_, buffer, sizeof(buffer));
+            if (bytes <= 0) {
+                return {};
+            }
+            received_.append(buffer, static_cast<size_t>(bytes));
+        }
+    }
+    
+    std::string receiveType() {
+        auto message = receive();
+        FixMessageView view;
+        return !message.empty() && view.parse(message) ? std::string(view.getMsgType()) : std::string();
+    }
+    
+    int peer_{-1};
+    std::unique_ptr<NativeFixSession> session_;
+    std::thread thread_;
+    std::vector<int64_t> handled_; // written by the session thread, read once it has answered
+    std::string loggedOnAs_;       // likewise
+    std::atomic<bool> refuseLogon_{false};
+    std::string received_;
+};
+
+} // namespace
+
+TEST_F(NativeFixSessionTest, GapIsAnsweredWithOneResendRequest) {
+    send("A", 1);
+    ASSERT_EQ(receiveType(), "A");
+    
+    send("D", 3);
+    auto message = receive();
+    FixMessageView view;
+    ASSERT_TRUE(view.parse(message));
+    EXPECT_EQ(view.getMsgType(), "2");
+    EXPECT_EQ(view.getInt(7), 2);
+    EXPECT_EQ(view.getInt(16), 0);
+    
+    // Still in the gap: dropped, and not asked for again
+    send("D", 4);
+    send("1", 5, false, "112", "PING");
+    EXPECT_EQ(receiveType(), "");
+    
+    // The resent messages fill it, in order
+    send("D", 2, true);
+    send("D", 3, true);
+    send("1", 4, true, "112", "PING");
+    EXPECT_EQ(receiveType(), "0");
+    EXPECT_EQ(handled_, (std::vector<int64_t>{2, 3}));
+}
+
+TEST_F(NativeFixSessionTest, PossibleDuplicateBelowExpectedIsDropped) {
+    send("A", 1);
+    ASSERT_EQ(receiveType(), "A");
+    send("D", 2);
+    send("D", 2, true);
+    send("1", 3, false, "112", "PING");
+    EXPECT_EQ(receiveType(), "0");
+    EXPECT_EQ(handled_, (std::vector<int64_t>{2}));
+}
+
+TEST_F(NativeFixSessionTest, TooLowWithoutPossDupLogsOut) {
+    send("A", 1);
+    ASSERT_EQ(receiveType(), "A");
+    send("D", 2);
+    send("D", 2);
+    
+    auto message = receive();
+    FixMessageView view;
+    ASSERT_TRUE(view.parse(message));
+    EXPECT_EQ(view.getMsgType(), "5");
+    EXPECT_NE(view.get(58).find("too low"), std::string_view::npos);
+    EXPECT_EQ(handled_, (std::vector<int64_t>{2}));
+}
+
+TEST_F(NativeFixSessionTest, LogonHandlerSeesCounterpartyAndCanRefuse) {
+    refuseLogon_ = true;
+    send("A", 1);
+    
+    auto message = receive();
+    FixMessageView view;
+    ASSERT_TRUE(view.parse(message));
+    EXPECT_EQ(view.getMsgType(), "5");
+    EXPECT_EQ(loggedOnAs_, "CLIENT");
+    EXPECT_FALSE(session_->isLoggedOn());
+    
+    // Nothing is handed on for a refused session
+    send("D", 2);
+    EXPECT_EQ(receiveType(), "");
+    EXPECT_TRUE(handled_.empty());
+}
+
+TEST_F(NativeFixSessionTest, LogonAboveExpectedRequestsResend) {
+    send("A", 5);
+    ASSERT_EQ(receiveType(), "A");
+    
+    auto message = receive();
+    FixMessageView view;
+    ASSERT_TRUE(view.parse(message));
+    EXPECT_EQ(view.getMsgType(), "2");
+    EXPECT_EQ(view.getInt(7), 1);
+}
+
+TEST_F(NativeFixSessionTest, ReportTooLongForTemplateIsBuilt) {
+    send("A", 1);
+    ASSERT_EQ(receiveType(), "A");
+    
+    networking::ExecutionReportFields fields{0, 1001, '0', '0', 0, 0.0, 100, 0, 0.0};
+    ASSERT_TRUE(session_->sendExecutionReport(8, "SHORT", "AAPL", '1', 100, fields));
+    std::string longClOrdId(300, 'X');
+    fields.execId = 1002;
+    ASSERT_TRUE(session_->sendExecutionReport(7, longClOrdId, "AAPL", '1', 100, fields));
+    fields.execId = 1003;
+    fields.execType = fields.ordStatus = '4';
+    ASSERT_TRUE(session_->sendExecutionReport(8, "SHORT", "AAPL", '1', 100, fields));
+    
+    FixMessageView view;
+    auto first = receive();
+    ASSERT_TRUE(view.parse(first));
+    EXPECT_EQ(view.getInt(37), 8);
+    
+    auto built = receive();
+    ASSERT_TRUE(view.parse(built));
+    EXPECT_EQ(view.getInt(37), 7);
+    EXPECT_EQ(view.get(11), longClOrdId);
+    EXPECT_EQ(view.getInt(17), 1002);
+    EXPECT_EQ(view.getInt(34), 3);
+    
+    // The prepared template is still order 8's
+    auto last = receive();
+    ASSERT_TRUE(view.parse(last));
+    EXPECT_EQ(view.getInt(37), 8);
+    EXPECT_EQ(view.get(11), "SHORT");
+    EXPECT_EQ(view.getChar(150), '4');
+    EXPECT_EQ(view.getInt(34), 4);
+}
+TEST_F(NativeFixSessionTest, ReplaceReportCarriesOrigClOrdId) {
+    send("A", 1);
+    ASSERT_EQ(receiveType(), "A");
+    
+    networking::ExecutionReportFields fields{0, 1001, '0', '0', 0, 0.0, 100, 0, 0.0};
+    ASSERT_TRUE(session_->sendExecutionReport(8, "FIRST", "AAPL", '1', 100, fields));
+    fields.execId = 1002;
+    fields.execType = fields.ordStatus = '5';
+    fields.leavesQty = 150;
+    ASSERT_TRUE(session_->sendExecutionReport(8, "SECOND", "AAPL", '1', 150, fields, "FIRST"));
+    fields.execId = 1003;
+    fields.execType = fields.ordStatus = '1';
+    ASSERT_TRUE(session_->sendExecutionReport(8, "SECOND", "AAPL", '1', 150, fields));
+    
+    FixMessageView view;
+    auto first = receive();
+    ASSERT_TRUE(view.parse(first));
+    EXPECT_EQ(view.get(11), "FIRST");
+    
+    auto replaced = receive();
+    ASSERT_TRUE(view.parse(replaced));
+    EXPECT_EQ(view.get(11), "SECOND");
+    EXPECT_EQ(view.get(41), "FIRST");
+    EXPECT_EQ(view.getChar(150), '5');
+    EXPECT_EQ(view.getInt(38), 150);
+    
+    // The template was prepared again for the replaced order
+    auto last = receive();
+    ASSERT_TRUE(view.parse(last));
+    EXPECT_EQ(view.get(11), "SECOND");
+    EXPECT_EQ(view.getInt(38), 150);
+    EXPECT_TRUE(view.get(41).empty());
+    EXPECT_EQ(view.getInt(34), 4);
+}
\ No newline at end of file
@@ -71,4 +71,440 @@ TEST_F(OrderBookTest, MatchingOrders) {
     EXPECT_TRUE(std::isnan(orderBook->getBestAsk()));
 }
 
-// More tests...
\ No newline at end of file
+TEST_F(OrderBookTest, TradeCarriesInstrumentAndCounterparties) {
+    auto sellOrder = std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 
+        100.0, 50
+    );
+    orderBook->addOrder(sellOrder);
+    
+    auto buyOrder = std::make_shared<engine::Order>(
+        2, 101, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 
+        100.0, 100
+    );
+    auto trades = orderBook->addOrder(buyOrder);
+    
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].getSymbol(), "AAPL");
+    EXPECT_EQ(trades[0].getBuyOrderId(), 2);
+    EXPECT_EQ(trades[0].getSellOrderId(), 1);
+    EXPECT_EQ(trades[0].getBuyerId(), 101);
+    EXPECT_EQ(trades[0].getSellerId(), 100);
+    EXPECT_EQ(trades[0].getId(), 1);
+}
+
+TEST_F(OrderBookTest, PriceBandStopsSweepAndPauses) {
+    orderBook->setPriceBand(0.05, std::chrono::seconds(60));
+    
+    engine::OrderId nextId = 1;
+    for (double price : {100.0, 103.0, 110.0}) {
+        orderBook->addOrder(std::make_shared<engine::Order>(
+            nextId++, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, price, 10));
+    }
+    
+    // The first print sets the band to [95, 105]
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        nextId++, 101, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 100.0, 10));
+    
+    auto sweep = std::make_shared<engine::Order>(
+        nextId++, 101, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 111.0, 30);
+    auto trades = orderBook->addOrder(sweep);
+    
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].getPrice(), 103.0);
+    EXPECT_EQ(sweep->getStatus(), engine::OrderStatus::CANCELLED);
+    EXPECT_EQ(orderBook->getBestAsk(), 110.0);
+    EXPECT_TRUE(std::isnan(orderBook->getBestBid()));
+    EXPECT_TRUE(orderBook->isPaused());
+    
+    // Nothing matches during the pause
+    auto during = std::make_shared<engine::Order>(
+        nextId++, 102, "AAPL", engine::OrderType::MARKET, engine::OrderSide::BUY, 0.0, 10);
+    EXPECT_TRUE(orderBook->addOrder(during).empty());
+    EXPECT_EQ(during->getStatus(), engine::OrderStatus::CANCELLED);
+}
+
+TEST_F(OrderBookTest, StopOrdersCascadeInOneMatchCycle) {
+    engine::OrderId nextId = 1;
+    for (double price : {101.0, 102.0, 103.0}) {
+        orderBook->addOrder(std::make_shared<engine::Order>(
+            nextId++, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, price, 10));
+    }
+    
+    auto stop = std::make_shared<engine::Order>(
+        nextId++, 101, "AAPL", engine::OrderType::STOP, engine::OrderSide::BUY, 0.0, 10);
+    stop->setStopPrice(101.0);
+    auto stopLimit = std::make_shared<engine::Order>(
+        nextId++, 102, "AAPL", engine::OrderType::STOP_LIMIT, engine::OrderSide::BUY, 102.5, 10);
+    stopLimit->setStopPrice(102.0);
+    EXPECT_TRUE(orderBook->addOrder(stop).empty());
+    EXPECT_TRUE(orderBook->addOrder(stopLimit).empty());
+    EXPECT_EQ(orderBook->getStopOrderCount(), 2);
+    
+    // The print at 101 elects the stop, whose print at 102 elects the stop-limit
+    auto trades = orderBook->addOrder(std::make_shared<engine::Order>(
+        nextId++, 103, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 101.0, 10));
+    
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(trades[0].getPrice(), 101.0);
+    EXPECT_EQ(trades[1].getPrice(), 102.0);
+    EXPECT_EQ(trades[1].getBuyOrderId(), stop->getId());
+    EXPECT_EQ(stop->getStatus(), engine::OrderStatus::FILLED);
+    EXPECT_EQ(orderBook->getStopOrderCount(), 0);
+    EXPECT_EQ(orderBook->getBestBid(), 102.5);
+}
+
+TEST_F(OrderBookTest, CancelParkedStop) {
+    auto stop = std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::STOP_LIMIT, engine::OrderSide::SELL, 95.0, 10);
+    stop->setStopPrice(96.0);
+    orderBook->addOrder(stop);
+    
+    EXPECT_TRUE(orderBook->cancelOrder(1));
+    EXPECT_EQ(stop->getStatus(), engine::OrderStatus::CANCELLED);
+    EXPECT_EQ(orderBook->getStopOrderCount(), 0);
+    EXPECT_FALSE(orderBook->cancelOrder(1));
+}
+
+// More tests...
+TEST_F(OrderBookTest, IcebergShowsPeakAndRequeuesBehindLevel) {
+    auto iceberg = std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::ICEBERG, engine::OrderSide::SELL, 101.0, 100);
+    iceberg->setPeakSize(10);
+    orderBook->addOrder(iceberg);
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        2, 101, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 101.0, 5));
+    
+    // Only the peak is displayed
+    auto depth = orderBook->getDepth(1);
+    ASSERT_EQ(depth.asks.size(), 1);
+    EXPECT_EQ(depth.asks[0].totalQuantity, 15);
+    EXPECT_EQ(depth.asks[0].orderCount, 2);
+    
+    // Taking the peak replenishes it behind the plain order
+    auto trades = orderBook->addOrder(std::make_shared<engine::Order>(
+        3, 102, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 101.0, 12));
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(trades[0].getSellOrderId(), 1);
+    EXPECT_EQ(trades[0].getQuantity(), 10);
+    EXPECT_EQ(trades[1].getSellOrderId(), 2);
+    EXPECT_EQ(trades[1].getQuantity(), 2);
+    EXPECT_EQ(iceberg->getVisibleQuantity(), 10);
+    EXPECT_EQ(orderBook->getDepth(1).asks[0].totalQuantity, 13);
+    
+    EXPECT_TRUE(orderBook->cancelOrder(1));
+    EXPECT_EQ(orderBook->getDepth(1).asks[0].totalQuantity, 3);
+}
+
+TEST_F(OrderBookTest, FillOrKillChecksLiquidityBeforeMatching) {
+    auto iceberg = std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::ICEBERG, engine::OrderSide::SELL, 101.0, 30);
+    iceberg->setPeakSize(10);
+    orderBook->addOrder(iceberg);
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        2, 101, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 102.0, 10));
+    
+    // 40 available up to 102, hidden quantity included: 41 is killed untouched
+    auto tooBig = std::make_shared<engine::Order>(
+        3, 102, "AAPL", engine::OrderType::FOK, engine::OrderSide::BUY, 102.0, 41);
+    EXPECT_TRUE(orderBook->addOrder(tooBig).empty());
+    EXPECT_EQ(tooBig->getStatus(), engine::OrderStatus::CANCELLED);
+    EXPECT_EQ(iceberg->getFilledQuantity(), 0);
+    EXPECT_EQ(orderBook->getDepth(2).asks[0].totalQuantity, 10);
+    
+    auto fits = std::make_shared<engine::Order>(
+        4, 102, "AAPL", engine::OrderType::FOK, engine::OrderSide::BUY, 102.0, 40);
+    auto trades = orderBook->addOrder(fits);
+    EXPECT_EQ(trades.size(), 4);
+    EXPECT_EQ(fits->getStatus(), engine::OrderStatus::FILLED);
+    EXPECT_TRUE(std::isnan(orderBook->getBestAsk()));
+}
+
+TEST_F(OrderBookTest, ImmediateOrCancelNeverRests) {
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 101.0, 10));
+    
+    auto ioc = std::make_shared<engine::Order>(
+        2, 101, "AAPL", engine::OrderType::IOC, engine::OrderSide::BUY, 101.0, 25);
+    auto trades = orderBook->addOrder(ioc);
+    
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(ioc->getFilledQuantity(), 10);
+    EXPECT_EQ(ioc->getStatus(), engine::OrderStatus::CANCELLED);
+    EXPECT_TRUE(std::isnan(orderBook->getBestBid()));
+    EXPECT_TRUE(std::isnan(orderBook->getBestAsk()));
+}
+
+TEST_F(OrderBookTest, ModifyReducesInPlaceAndRepriceRequeues) {
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 101.0, 10));
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        2, 101, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 101.0, 10));
+    std::vector<engine::BookUpdate> updates;
+    orderBook->drainBookUpdates(updates);
+    updates.clear();
+    
+    // A reduce keeps its place at the front of the level
+    std::vector<engine::Trade> trades;
+    ASSERT_TRUE(orderBook->modifyOrder(1, 4, 101.0, trades));
+    EXPECT_TRUE(trades.empty());
+    EXPECT_EQ(orderBook->getDepth(1).asks[0].totalQuantity, 14);
+    orderBook->drainBookUpdates(updates);
+    ASSERT_EQ(updates.size(), 1);
+    EXPECT_EQ(updates[0].quantity, 14);
+    EXPECT_EQ(updates[0].orderCount, 2);
+    EXPECT_EQ(updates[0].previousPrice, 0.0);
+    
+    // Growing it re-queues it behind order 2
+    ASSERT_TRUE(orderBook->modifyOrder(1, 6, 101.0, trades));
+    auto buy = std::make_shared<engine::Order>(
+        3, 102, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 101.0, 10);
+    trades = orderBook->addOrder(buy);
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].getSellOrderId(), 2);
+    
+    // A reprice through the bid trades on entry
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        4, 102, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 100.0, 5));
+    trades.clear();
+    ASSERT_TRUE(orderBook->modifyOrder(1, 6, 100.0, trades));
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].getBuyOrderId(), 4);
+    EXPECT_EQ(trades[0].getQuantity(), 5);
+    EXPECT_EQ(orderBook->getBestAsk(), 100.0);
+    
+    EXPECT_FALSE(orderBook->modifyOrder(99, 5, 100.0, trades));
+    EXPECT_FALSE(orderBook->modifyOrder(1, 0, 100.0, trades));
+}
+
+TEST_F(OrderBookTest, MassCancelByUserAndSession) {
+    auto makeOrder = [](engine::OrderId id, engine::UserId user, engine::OrderSide side, double price) {
+        return std::make_shared<engine::Order>(id, user, "AAPL", engine::OrderType::LIMIT, side, price, 10);
+    };
+    orderBook->addOrder(makeOrder(1, 100, engine::OrderSide::BUY, 99.0));
+    orderBook->addOrder(makeOrder(2, 101, engine::OrderSide::BUY, 99.0));
+    orderBook->addOrder(makeOrder(3, 100, engine::OrderSide::SELL, 101.0));
+    auto stop = std::make_shared<engine::Order>(
+        4, 100, "AAPL", engine::OrderType::STOP, engine::OrderSide::SELL, 0.0, 10);
+    stop->setStopPrice(95.0);
+    orderBook->addOrder(stop);
+    auto routed = makeOrder(5, 101, engine::OrderSide::SELL, 102.0);
+    routed->setSessionRoute(7, 0);
+    orderBook->addOrder(routed);
+    
+    // A filled order leaves its chain as it leaves the book
+    orderBook->addOrder(makeOrder(6, 101, engine::OrderSide::BUY, 101.0));
+    
+    EXPECT_EQ(orderBook->cancelUserOrders(100), 2);
+    EXPECT_EQ(stop->getStatus(), engine::OrderStatus::CANCELLED);
+    EXPECT_EQ(orderBook->getStopOrderCount(), 0);
+    EXPECT_EQ(orderBook->getDepth(1).bids[0].totalQuantity, 10);
+    EXPECT_EQ(orderBook->cancelUserOrders(100), 0);
+    
+    EXPECT_EQ(orderBook->cancelSessionOrders(7), 1);
+    EXPECT_EQ(routed->getStatus(), engine::OrderStatus::CANCELLED);
+    EXPECT_TRUE(std::isnan(orderBook->getBestAsk()));
+    
+    EXPECT_EQ(orderBook->cancelUserOrders(101), 1);
+    EXPECT_TRUE(std::isnan(orderBook->getBestBid()));
+    
+    std::vector<engine::ExecutionEvent> events;
+    orderBook->drainExecutionEvents(events);
+    EXPECT_EQ(std::count_if(events.begin(), events.end(), [](const engine::ExecutionEvent& event) {
+        return event.execType == engine::ExecType::CANCELLED;
+    }), 4);
+}
+
+TEST_F(OrderBookTest, QuoteUpdatesInPlaceWithoutTradingWithItself) {
+    engine::OrderBook::Quote quote{
+        std::make_shared<engine::Order>(1, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 0.0, 0),
+        std::make_shared<engine::Order>(2, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 0.0, 0)};
+    quote.bid->rearm(1, 100.0, 10);
+    quote.ask->rearm(2, 101.0, 10);
+    EXPECT_TRUE(orderBook->updateQuote(quote, {100.0, 10}, {101.0, 10}).empty());
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        3, 101, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 102.0, 5));
+    
+    // Shifted up through its own ask: the ask moves first, so only order 3 trades
+    auto trades = orderBook->updateQuote(quote, {102.0, 8}, {103.0, 10});
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].getSellOrderId(), 3);
+    EXPECT_EQ(orderBook->getBestBid(), 102.0);
+    EXPECT_EQ(orderBook->getBestAsk(), 103.0);
+    EXPECT_EQ(orderBook->getDepth(1).bids[0].totalQuantity, 3);
+    
+    // Pulling a side, then quoting it again re-enters the same order object under a new id
+    EXPECT_TRUE(orderBook->updateQuote(quote, {102.0, 3}, {103.0, 0}).empty());
+    EXPECT_TRUE(std::isnan(orderBook->getBestAsk()));
+    EXPECT_EQ(quote.ask->getStatus(), engine::OrderStatus::CANCELLED);
+    quote.ask->rearm(4, 104.0, 7);
+    orderBook->updateQuote(quote, {102.0, 3}, {104.0, 7});
+    EXPECT_EQ(orderBook->findOrder(4), quote.ask);
+    EXPECT_FALSE(orderBook->findOrder(2));
+    EXPECT_EQ(orderBook->getDepth(1).asks[0].totalQuantity, 7);
+    
+    // A modify the approver refuses pulls the side; it is asked only for resting sides
+    std::vector<engine::OrderId> asked;
+    orderBook->updateQuote(quote, {101.0, 5}, {104.0, 7}, [&](engine::Order& order, engine::Quantity, engine::Price) {
+        asked.push_back(order.getId());
+        return order.getSide() == engine::OrderSide::SELL;
+    });
+    EXPECT_EQ(asked, (std::vector<engine::OrderId>{1, 4}));
+    EXPECT_TRUE(std::isnan(orderBook->getBestBid()));
+    EXPECT_EQ(orderBook->getBestAsk(), 104.0);
+}
+
+TEST_F(OrderBookTest, CallAuctionUncrossesAtMaximumVolume) {
+    auto limit = [](engine::OrderId id, engine::OrderSide side, double price, engine::Quantity quantity) {
+        return std::make_shared<engine::Order>(id, 100 + id, "AAPL", engine::OrderType::LIMIT, side, price, quantity);
+    };
+    orderBook->startAuction();
+    EXPECT_TRUE(orderBook->addOrder(limit(1, engine::OrderSide::BUY, 101.0, 10)).empty());
+    EXPECT_TRUE(orderBook->addOrder(limit(2, engine::OrderSide::BUY, 100.0, 5)).empty());
+    EXPECT_TRUE(orderBook->addOrder(limit(3, engine::OrderSide::SELL, 99.0, 8)).empty());
+    EXPECT_TRUE(orderBook->addOrder(limit(4, engine::OrderSide::SELL, 100.0, 4)).empty());
+    
+    auto market = std::make_shared<engine::Order>(
+        5, 105, "AAPL", engine::OrderType::MARKET, engine::OrderSide::BUY, 0.0, 1);
+    EXPECT_TRUE(orderBook->addOrder(market).empty());
+    EXPECT_EQ(market->getStatus(), engine::OrderStatus::CANCELLED);
+    
+    // Most volume at 100: 12, against 8 at 99 and 10 above 100; 3 bid left over
+    engine::AuctionUpdate indicative;
+    ASSERT_TRUE(orderBook->drainAuctionUpdate(indicative));
+    EXPECT_DOUBLE_EQ(indicative.indicativePrice, 100.0);
+    EXPECT_EQ(indicative.indicativeVolume, 12);
+    EXPECT_EQ(indicative.surplus, 3);
+    EXPECT_EQ(indicative.surplusSide, engine::OrderSide::BUY);
+    EXPECT_FALSE(orderBook->drainAuctionUpdate(indicative));
+    
+    auto trades = orderBook->uncross();
+    ASSERT_EQ(trades.size(), 3);
+    engine::Quantity volume = 0;
+    for (const auto& trade : trades) {
+        EXPECT_DOUBLE_EQ(trade.getPrice(), 100.0);
+        volume += trade.getQuantity();
+    }
+    EXPECT_EQ(volume, 12);
+    EXPECT_EQ(orderBook->getPhase(), engine::TradingPhase::CONTINUOUS);
+    EXPECT_EQ(orderBook->getBestBid(), 100.0);
+    EXPECT_EQ(orderBook->getDepth(1).bids[0].totalQuantity, 3);
+    EXPECT_TRUE(std::isnan(orderBook->getBestAsk()));
+}
+
+TEST_F(OrderBookTest, CallAuctionNeverExecutesBeyondALimit) {
+    auto limit = [](engine::OrderId id, engine::OrderSide side, double price, engine::Quantity quantity) {
+        return std::make_shared<engine::Order>(id, 100 + id, "AAPL", engine::OrderType::LIMIT, side, price, quantity);
+    };
+    
+    // Off-tick limits: the bid rounds down to 100.01, below the ask, so nothing crosses
+    orderBook->startAuction();
+    orderBook->addOrder(limit(1, engine::OrderSide::BUY, 100.016, 10));
+    orderBook->addOrder(limit(2, engine::OrderSide::SELL, 100.02, 10));
+    EXPECT_TRUE(orderBook->uncross().empty());
+    
+    // A range millions of ticks wide: the far ask stays out, the near one trades at its limit
+    orderBook->startAuction();
+    orderBook->addOrder(limit(3, engine::OrderSide::BUY, 20000.0, 5));
+    orderBook->addOrder(limit(4, engine::OrderSide::SELL, 50000.0, 5));
+    orderBook->addOrder(limit(5, engine::OrderSide::SELL, 0.05, 5));
+    auto trades = orderBook->uncross();
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].getBuyOrderId(), 3);
+    for (const auto& trade : trades) {
+        EXPECT_GE(trade.getPrice(), 0.05);
+        EXPECT_LE(trade.getPrice(), 20000.0);
+    }
+    EXPECT_TRUE(orderBook->findOrder(4));
+}
+
+TEST_F(OrderBookTest, ProRataAndLeadMarketMakerAllocation) {
+    auto sell = [](engine::OrderId id, engine::UserId user, engine::Quantity quantity) {
+        return std::make_shared<engine::Order>(id, user, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL,
+                                               101.0, quantity);
+    };
+    auto buy = [](engine::OrderId id, engine::Quantity quantity) {
+        return std::make_shared<engine::Order>(id, 300, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY,
+                                               101.0, quantity);
+    };
+    
+    orderBook->setAllocation({engine::MatchingAlgorithm::PRO_RATA, 2, 0, 0.0});
+    orderBook->addOrder(sell(1, 100, 10));
+    orderBook->addOrder(sell(2, 101, 30));
+    orderBook->addOrder(sell(3, 102, 60));
+    
+    auto trades = orderBook->addOrder(buy(4, 50));
+    ASSERT_EQ(trades.size(), 3);
+    EXPECT_EQ(trades[0].getQuantity(), 5);
+    EXPECT_EQ(trades[1].getQuantity(), 15);
+    EXPECT_EQ(trades[2].getQuantity(), 30);
+    
+    // 0.9, 2.7 and 5.4: the first share is under the minimum, and the 2 left
+    // over go to the front of the queue
+    trades = orderBook->addOrder(buy(5, 9));
+    ASSERT_EQ(trades.size(), 3);
+    EXPECT_EQ(trades[0].getSellOrderId(), 1);
+    EXPECT_EQ(trades[0].getQuantity(), 2);
+    EXPECT_EQ(trades[1].getQuantity(), 2);
+    EXPECT_EQ(trades[2].getQuantity(), 5);
+    
+    // The lead market maker (user 200) takes 40% ahead of the queue
+    orderBook->cancelUserOrders(100);
+    orderBook->cancelUserOrders(101);
+    orderBook->cancelUserOrders(102);
+    orderBook->setAllocation({engine::MatchingAlgorithm::FIFO_LMM, 1, 200, 0.4});
+    orderBook->addOrder(sell(6, 100, 10));
+    orderBook->addOrder(sell(7, 200, 10));
+    orderBook->addOrder(sell(8, 101, 10));
+    
+    trades = orderBook->addOrder(buy(9, 15));
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(trades[0].getSellOrderId(), 7);
+    EXPECT_EQ(trades[0].getQuantity(), 6);
+    EXPECT_EQ(trades[1].getSellOrderId(), 6);
+    EXPECT_EQ(trades[1].getQuantity(), 9);
+    EXPECT_EQ(orderBook->getDepth(1).asks[0].totalQuantity, 15);
+}
+
+TEST_F(OrderBookTest, TopOfBookShowsBestLevelsAndLastTrade) {
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 99.0, 100));
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        2, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 99.0, 50));
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        3, 101, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 101.0, 70));
+    
+    engine::TopOfBook top;
+    orderBook->getTopOfBook(top);
+    EXPECT_EQ(top.bidPrice, 99.0);
+    EXPECT_EQ(top.bidQuantity, 150);
+    EXPECT_EQ(top.askPrice, 101.0);
+    EXPECT_EQ(top.askQuantity, 70);
+    EXPECT_EQ(top.lastPrice, 0.0);
+    
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        4, 102, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::SELL, 101.0, 70));
+    orderBook->addOrder(std::make_shared<engine::Order>(
+        5, 103, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 101.0, 140));
+    
+    engine::TopOfBook after;
+    orderBook->getTopOfBook(after);
+    EXPECT_EQ(after.askQuantity, 0); // both asks taken
+    EXPECT_EQ(after.askPrice, 0.0);
+    EXPECT_EQ(after.lastPrice, 101.0);
+    EXPECT_FALSE(after.sameQuote(top));
+}
+
+TEST_F(OrderBookTest, ClientCancelNeedsOwningUserAndSession) {
+    auto order = std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 99.0, 100);
+    order->setSessionRoute(3, 0);
+    orderBook->addOrder(order);
+    
+    EXPECT_FALSE(orderBook->cancelOrder(1, 101, 0)); // another user
+    EXPECT_FALSE(orderBook->cancelOrder(1, 100, 4)); // same user, another session
+    EXPECT_EQ(order->getStatus(), engine::OrderStatus::NEW);
+    
+    EXPECT_TRUE(orderBook->cancelOrder(1, 100, 3));
+    EXPECT_EQ(order->getStatus(), engine::OrderStatus::CANCELLED);
+}
\ No newline at end of file
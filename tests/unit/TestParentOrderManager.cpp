@@ -0,0 +1,109 @@
+// tests/unit/TestParentOrderManager.cpp
+#include <gtest/gtest.h>
+#include <engine/ParentOrderManager.hpp>
+#include <vector>
+
+namespace {
+
+engine::OrderPtr makeParent(engine::Quantity quantity) {
+    return std::make_shared<engine::Order>(
+        1, 100, "AAPL", engine::OrderType::LIMIT, engine::OrderSide::BUY, 101.0, quantity);
+}
+
+} // namespace
+
+TEST(ParentOrderManagerTest, TwapSlicesCatchUpOnUnfilledChildren) {
+    engine::ParentOrderManager manager;
+    auto parent = makeParent(100);
+    ASSERT_TRUE(manager.add(parent, engine::ParentOrderManager::Schedule::twap(std::chrono::seconds(4), 4), 0));
+    
+    std::vector<engine::ExecutionEvent> events;
+    auto slice = manager.releaseSlice(1, 11, events);
+    ASSERT_TRUE(slice.child);
+    EXPECT_EQ(slice.child->getQuantity(), 25);
+    EXPECT_EQ(slice.nextTick, 1000);
+    
+    // 10 of 25 filled before the next slice: the 15 left over rolls forward
+    slice.child->setFilledQuantity(10);
+    slice = manager.releaseSlice(1, 12, events);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].execType, engine::ExecType::PARTIAL_FILL);
+    EXPECT_EQ(events[0].lastQty, 10);
+    EXPECT_EQ(events[0].cumQty, 10);
+    EXPECT_EQ(slice.child->getQuantity(), 40);
+    EXPECT_EQ(manager.workingChild(1), slice.child);
+}
+
+TEST(ParentOrderManagerTest, VwapFollowsProfileAndFinishesAfterLastSlice) {
+    engine::ParentOrderManager manager;
+    auto parent = makeParent(100);
+    auto profile = engine::ParentOrderManager::Schedule::vwap(std::chrono::seconds(3), {3.0, 1.0, 1.0});
+    ASSERT_TRUE(manager.add(parent, profile, 0));
+    
+    std::vector<engine::ExecutionEvent> events;
+    std::vector<engine::Quantity> childQuantities;
+    engine::OrderId childId = 10;
+    for (auto slice = manager.releaseSlice(1, ++childId, events); slice.nextTick >= 0;
+         slice = manager.releaseSlice(1, ++childId, events)) {
+        ASSERT_TRUE(slice.child);
+        childQuantities.push_back(slice.child->getQuantity());
+        slice.child->setFilledQuantity(slice.child->getQuantity());
+    }
+    
+    EXPECT_EQ(childQuantities, (std::vector<engine::Quantity>{60, 20, 20}));
+    EXPECT_EQ(parent->getStatus(), engine::OrderStatus::FILLED);
+    EXPECT_EQ(events.back().execType, engine::ExecType::FILL);
+    EXPECT_EQ(manager.size(), 0);
+}
+
+TEST(ParentOrderManagerTest, CancelReportsTheUnfilledRest) {
+    engine::ParentOrderManager manager;
+    auto parent = makeParent(100);
+    ASSERT_TRUE(manager.add(parent, engine::ParentOrderManager::Schedule::twap(std::chrono::seconds(2), 2), 0));
+    
+    std::vector<engine::ExecutionEvent> events;
+    manager.releaseSlice(1, 11, events).child->setFilledQuantity(30);
+    EXPECT_FALSE(manager.cancel(1, 7, events)); // not the owner
+    EXPECT_TRUE(events.empty());
+    EXPECT_TRUE(manager.cancel(1, 100, events));
+    
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[1].execType, engine::ExecType::CANCELLED);
+    EXPECT_EQ(events[1].cumQty, 30);
+    EXPECT_EQ(parent->getStatus(), engine::OrderStatus::CANCELLED);
+    EXPECT_FALSE(manager.cancel(1, 100, events));
+    EXPECT_TRUE(manager.releaseSlice(1, 12, events).nextTick < 0);
+}
+
+TEST(ParentOrderManagerTest, ChildFillsFoldAsTheyArrive) {
+    engine::ParentOrderManager manager;
+    auto parent = makeParent(100);
+    ASSERT_TRUE(manager.add(parent, engine::ParentOrderManager::Schedule::twap(std::chrono::seconds(2), 2), 0));
+    
+    std::vector<engine::ExecutionEvent> events;
+    auto child = manager.releaseSlice(1, 11, events).child;
+    ASSERT_TRUE(child);
+    EXPECT_EQ(child->getParentId(), 1);
+    
+    child->setFilledQuantity(20);
+    manager.onChildFill(engine::ExecutionEvent::fromOrder(*child, engine::ExecType::PARTIAL_FILL, 20, 100.5), events);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].orderId, 1);
+    EXPECT_EQ(events[0].execType, engine::ExecType::PARTIAL_FILL);
+    EXPECT_EQ(events[0].lastQty, 20);
+    EXPECT_DOUBLE_EQ(events[0].lastPx, 100.5);
+    EXPECT_EQ(parent->getFilledQuantity(), 20);
+    
+    // Reported already, so the next slice folds only what was not seen
+    child->setFilledQuantity(25);
+    auto next = manager.releaseSlice(1, 12, events).child;
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[1].lastQty, 5);
+    EXPECT_EQ(parent->getFilledQuantity(), 25);
+    
+    // A late fill of the replaced child is ignored
+    manager.onChildFill(engine::ExecutionEvent::fromOrder(*child, engine::ExecType::FILL, 5, 100.5), events);
+    EXPECT_EQ(events.size(), 2);
+    ASSERT_TRUE(next);
+    EXPECT_EQ(next->getQuantity(), 75);
+}
\ No newline at end of file
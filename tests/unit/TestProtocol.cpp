@@ -0,0 +1,107 @@
+// tests/unit/TestProtocol.cpp
+#include <gtest/gtest.h>
+#include <networking/Protocol.hpp>
+#include <stdexcept>
+
+using namespace networking;
+
+TEST(ProtocolTest, OrderRequestRoundTrips) {
+    OrderRequest request{engine::OrderType::LIMIT, engine::OrderSide::SELL, "AAPL", 150.25, 300,
+                         "client|7", "key-42"};
+    
+    auto decoded = deserializeOrderRequest(serializeOrderRequest(request));
+    EXPECT_EQ(decoded.type, engine::OrderType::LIMIT);
+    EXPECT_EQ(decoded.side, engine::OrderSide::SELL);
+    EXPECT_EQ(decoded.symbol, "AAPL");
+    EXPECT_DOUBLE_EQ(decoded.price, 150.25);
+    EXPECT_EQ(decoded.quantity, 300);
+    EXPECT_EQ(decoded.apiKey, "key-42");
+    EXPECT_EQ(decoded.clientOrderId, "client|7"); // the last field may contain the separator
+}
+
+TEST(ProtocolTest, OrderResponseRoundTrips) {
+    OrderResponse response{17, engine::OrderStatus::PARTIAL, "", 100, 99.5, "C-1"};
+    
+    auto decoded = deserializeOrderResponse(serializeOrderResponse(response));
+    EXPECT_EQ(decoded.orderId, 17u);
+    EXPECT_EQ(decoded.status, engine::OrderStatus::PARTIAL);
+    EXPECT_EQ(decoded.filledQuantity, 100);
+    EXPECT_DOUBLE_EQ(decoded.averagePrice, 99.5);
+    EXPECT_EQ(decoded.clientOrderId, "C-1");
+    EXPECT_TRUE(decoded.message.empty());
+}
+
+TEST(ProtocolTest, MarketDataSnapshotRoundTrips) {
+    MarketDataSnapshot snapshot;
+    snapshot.symbol = "MSFT";
+    snapshot.timestamp = std::chrono::system_clock::now();
+    snapshot.bids = {{300.0, 10}, {299.99, 20}};
+    snapshot.lastPrice = 300.01;
+    snapshot.lastQuantity = 5;
+    snapshot.totalVolume = 1000;
+    
+    auto decoded = deserializeMarketDataSnapshot(serializeMarketDataSnapshot(snapshot));
+    EXPECT_EQ(decoded.symbol, "MSFT");
+    ASSERT_EQ(decoded.bids.size(), 2u);
+    EXPECT_DOUBLE_EQ(decoded.bids[1].price, 299.99);
+    EXPECT_EQ(decoded.bids[1].quantity, 20);
+    EXPECT_TRUE(decoded.asks.empty());
+    EXPECT_DOUBLE_EQ(decoded.lastPrice, 300.01);
+    EXPECT_EQ(decoded.totalVolume, 1000);
+}
+
+TEST(ProtocolTest, AuctionIndicativeRoundTrips) {
+    AuctionIndicative indicative{"AAPL", std::chrono::system_clock::now(), 150.05, 1200, 300,
+                                 engine::OrderSide::SELL};
+    
+    auto decoded = deserializeAuctionIndicative(serializeAuctionIndicative(indicative));
+    EXPECT_EQ(decoded.symbol, "AAPL");
+    EXPECT_EQ(decoded.timestamp, indicative.timestamp);
+    EXPECT_DOUBLE_EQ(decoded.indicativePrice, 150.05);
+    EXPECT_EQ(decoded.indicativeVolume, 1200);
+    EXPECT_EQ(decoded.surplus, 300);
+    EXPECT_EQ(decoded.surplusSide, engine::OrderSide::SELL);
+    EXPECT_THROW(deserializeAuctionIndicative(serializeAuctionIndicative(indicative) + "|1"),
+                 std::invalid_argument);
+}
+
+TEST(ProtocolTest, MassQuoteRoundTrips) {
+    MassQuote quote{"mm-key", {{"AAPL", 150.0, 500, 150.05, 400}, {"MSFT", 0.0, 0, 300.1, 200}}};
+    
+    auto decoded = deserializeMassQuote(serializeMassQuote(quote));
+    EXPECT_EQ(decoded.apiKey, "mm-key");
+    ASSERT_EQ(decoded.entries.size(), 2u);
+    EXPECT_EQ(decoded.entries[0].symbol, "AAPL");
+    EXPECT_DOUBLE_EQ(decoded.entries[0].askPrice, 150.05);
+    EXPECT_EQ(decoded.entries[0].bidQuantity, 500);
+    EXPECT_EQ(decoded.entries[1].bidQuantity, 0);
+    EXPECT_EQ(decoded.entries[1].askQuantity, 200);
+    EXPECT_THROW(deserializeMassQuote("7|mm-key|2|AAPL|1|1|2|1"), std::invalid_argument);
+}
+
+TEST(ProtocolTest, DepthUpdateRoundTrips) {
+    DepthUpdate update{"AAPL", std::chrono::system_clock::now(), engine::OrderSide::BUY, 150.1, 700, 3, 150.0, 0, 0};
+    
+    auto decoded = deserializeDepthUpdate(serializeDepthUpdate(update));
+    EXPECT_EQ(decoded.symbol, "AAPL");
+    EXPECT_EQ(decoded.timestamp, update.timestamp);
+    EXPECT_EQ(decoded.side, engine::OrderSide::BUY);
+    EXPECT_DOUBLE_EQ(decoded.price, 150.1);
+    EXPECT_EQ(decoded.quantity, 700);
+    EXPECT_EQ(decoded.orderCount, 3u);
+    EXPECT_DOUBLE_EQ(decoded.previousPrice, 150.0);
+    EXPECT_EQ(decoded.previousQuantity, 0);
+    EXPECT_EQ(decoded.previousOrderCount, 0u);
+    EXPECT_THROW(deserializeDepthUpdate(serializeAuctionIndicative(
+                     AuctionIndicative{"AAPL", update.timestamp, 1.0, 1, 0, engine::OrderSide::BUY})),
+                 std::invalid_argument);
+}
+
+TEST(ProtocolTest, RejectsMalformedMessages) {
+    EXPECT_THROW(deserializeOrderRequest("1|1|0|AAPL|abc|100|1|C"), std::invalid_argument);
+    EXPECT_THROW(deserializeOrderRequest("1|1|0|AAPL"), std::invalid_argument);
+    
+    OrderResponse response{1, engine::OrderStatus::NEW, "", 0, 0.0, ""};
+    EXPECT_THROW(deserializeOrderRequest(serializeOrderResponse(response)), std::invalid_argument);
+    EXPECT_THROW(deserializeTradeNotification("3|1|2|3|4|5.0|6|7"), std::invalid_argument);
+}
\ No newline at end of file
@@ -0,0 +1,277 @@
+// tests/unit/TestRiskEngine.cpp
+#include <gtest/gtest.h>
+#include <risk/RiskEngine.hpp>
+#include <engine/Order.hpp>
+#include <engine/Trade.hpp>
+#include <chrono>
+#include <cmath>
+
+class RiskEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        riskEngine = std::make_unique<risk::RiskEngine>(config);
+        riskEngine->registerInstrument("AAPL");
+        riskEngine->registerInstrument("GOOGL");
+    }
+    
+    // Checks reserve exposure on the order, so they need an lvalue
+    risk::RiskCheckResult check(engine::Order order) {
+        return riskEngine->checkOrder(order);
+    }
+    
+    void report(const engine::Order& order, engine::ExecType type, engine::Quantity lastQty = 0) {
+        auto event = engine::ExecutionEvent::fromOrder(order, type, lastQty, order.getPrice());
+        riskEngine->releaseExposure(order.getSymbol(), std::span(&event, 1), risk::RiskEngine::NO_SHARD);
+    }
+    
+    engine::Trade makeTrade(const std::string& symbol, engine::UserId buyer, engine::UserId seller,
+                            engine::Quantity quantity, engine::Price price) {
+        return engine::Trade(++nextTradeId, symbol, 0, 0, buyer, seller, quantity, price, engine::Timestamp{});
+    }
+    
+    void record(const engine::Trade& trade) {
+        riskEngine->recordTrades(std::span(&trade, 1), riskEngine->shardOf(trade.getBuyerId()));
+        for (size_t shard = 0; shard < riskEngine->shardCount(); ++shard) {
+            riskEngine->applyPostTradeUpdates(shard);
+        }
+    }
+    
+    engine::Order makeOrder(engine::UserId userId, const std::string& symbol,
+                            engine::OrderSide side, engine::Quantity quantity, engine::Price price = 100.0) {
+        return engine::Order(++nextOrderId, userId, symbol, engine::OrderType::LIMIT, side, price, quantity);
+    }
+    
+    utils::Config config;
+    std::unique_ptr<risk::RiskEngine> riskEngine;
+    engine::OrderId nextOrderId{0};
+    engine::TradeId nextTradeId{0};
+};
+
+TEST_F(RiskEngineTest, ApprovesOrderWithinDefaultLimits) {
+    auto result = check(makeOrder(1, "AAPL", engine::OrderSide::BUY, 100));
+    
+    EXPECT_TRUE(result.approved);
+}
+
+TEST_F(RiskEngineTest, RejectsUnknownInstrumentAndUser) {
+    EXPECT_FALSE(check(makeOrder(1, "MSFT", engine::OrderSide::BUY, 100)).approved);
+    EXPECT_FALSE(check(makeOrder(1000000, "AAPL", engine::OrderSide::BUY, 100)).approved);
+}
+
+TEST_F(RiskEngineTest, RegisterInstrumentIsIdempotent) {
+    auto id = riskEngine->findInstrument("GOOGL");
+    
+    EXPECT_NE(id, risk::INVALID_INSTRUMENT);
+    EXPECT_EQ(riskEngine->registerInstrument("GOOGL"), id);
+    EXPECT_EQ(riskEngine->findInstrument("MSFT"), risk::INVALID_INSTRUMENT);
+}
+
+TEST_F(RiskEngineTest, LimitsArePerUser) {
+    riskEngine->setMaxOrderSize(7, 50);
+    
+    auto limited = check(makeOrder(7, "AAPL", engine::OrderSide::BUY, 100));
+    EXPECT_FALSE(limited.approved);
+    EXPECT_EQ(limited.suggestedLimit, 50.0);
+    
+    EXPECT_TRUE(check(makeOrder(8, "AAPL", engine::OrderSide::BUY, 100)).approved);
+}
+
+TEST_F(RiskEngineTest, PositionLimitIsPerSymbol) {
+    riskEngine->setPositionLimit(3, "AAPL", 10);
+    
+    EXPECT_FALSE(check(makeOrder(3, "AAPL", engine::OrderSide::SELL, 20)).approved);
+    EXPECT_TRUE(check(makeOrder(3, "GOOGL", engine::OrderSide::SELL, 20)).approved);
+}
+
+TEST_F(RiskEngineTest, NotionalAndDailyVolumeLimits) {
+    riskEngine->setNotionalLimit(4, 5000.0);
+    riskEngine->setDailyVolumeLimit(5, 10);
+    
+    EXPECT_FALSE(check(makeOrder(4, "AAPL", engine::OrderSide::BUY, 100, 100.0)).approved);
+    EXPECT_TRUE(check(makeOrder(4, "AAPL", engine::OrderSide::BUY, 10, 100.0)).approved);
+    EXPECT_FALSE(check(makeOrder(5, "AAPL", engine::OrderSide::BUY, 11)).approved);
+}
+
+TEST_F(RiskEngineTest, UsersMapToValidShards) {
+    ASSERT_GE(riskEngine->shardCount(), 1u);
+    for (engine::UserId userId = 0; userId < 64; ++userId) {
+        EXPECT_LT(riskEngine->shardOf(userId), riskEngine->shardCount());
+    }
+}
+
+TEST_F(RiskEngineTest, SettersRejectUnknownUser) {
+    EXPECT_THROW(riskEngine->setMaxOrderSize(1000000, 10), std::out_of_range);
+    EXPECT_THROW(riskEngine->setPositionLimit(1, "MSFT", 10), std::invalid_argument);
+}
+
+TEST_F(RiskEngineTest, RecordTradesUpdatesBothCounterparties) {
+    record(makeTrade("AAPL", 10, 11, 100, 100.0));
+    
+    auto buyer = riskEngine->getPosition(10, "AAPL");
+    auto seller = riskEngine->getPosition(11, "AAPL");
+    EXPECT_EQ(buyer.netPosition, 100);
+    EXPECT_EQ(buyer.buyQuantity, 100);
+    EXPECT_EQ(seller.netPosition, -100);
+    EXPECT_EQ(seller.sellQuantity, 100);
+    EXPECT_EQ(riskEngine->getPosition(10, "GOOGL").netPosition, 0);
+    EXPECT_EQ(riskEngine->getAllPositions(10).size(), 1u);
+}
+
+TEST_F(RiskEngineTest, RealisesPnlAgainstAverageCost) {
+    record(makeTrade("AAPL", 12, 13, 10, 100.0));
+    record(makeTrade("AAPL", 12, 13, 10, 110.0));
+    record(makeTrade("AAPL", 13, 12, 5, 120.0));
+    
+    auto position = riskEngine->getPosition(12, "AAPL");
+    EXPECT_EQ(position.netPosition, 15);
+    EXPECT_DOUBLE_EQ(position.realizedPnl, 75.0);
+    EXPECT_DOUBLE_EQ(position.unrealizedPnl, 15 * 120.0 - 15 * 105.0);
+    EXPECT_DOUBLE_EQ(position.notionalValue, 15 * 120.0);
+}
+
+TEST_F(RiskEngineTest, MarkToMarketReachesHoldersDrawdown) {
+    record(makeTrade("AAPL", 20, 21, 5000, 100.0));
+    EXPECT_TRUE(check(makeOrder(20, "AAPL", engine::OrderSide::SELL, 10)).approved);
+    
+    // A print between other users marks user 20 down 150k on 1M starting equity
+    record(makeTrade("AAPL", 22, 23, 1, 70.0));
+    
+    auto result = check(makeOrder(20, "AAPL", engine::OrderSide::SELL, 10));
+    EXPECT_FALSE(result.approved);
+    EXPECT_EQ(result.reason, "Drawdown limit exceeded");
+    EXPECT_TRUE(check(makeOrder(21, "AAPL", engine::OrderSide::BUY, 10)).approved);
+}
+
+TEST_F(RiskEngineTest, OpenOrdersCountTowardPositionLimit) {
+    riskEngine->setPositionLimit(30, "AAPL", 100);
+    
+    auto first = makeOrder(30, "AAPL", engine::OrderSide::BUY, 60);
+    ASSERT_TRUE(riskEngine->checkOrder(first).approved);
+    EXPECT_DOUBLE_EQ(first.getReservedPrice(), 100.0);
+    EXPECT_FALSE(check(makeOrder(30, "AAPL", engine::OrderSide::BUY, 60)).approved);
+    
+    // The other side is reserved separately
+    EXPECT_TRUE(check(makeOrder(30, "AAPL", engine::OrderSide::SELL, 60)).approved);
+    
+    // Cancelling the first order frees its reservation
+    first.setStatus(engine::OrderStatus::CANCELLED);
+    report(first, engine::ExecType::CANCELLED);
+    EXPECT_TRUE(check(makeOrder(30, "AAPL", engine::OrderSide::BUY, 60)).approved);
+}
+
+TEST_F(RiskEngineTest, FillConvertsReservationIntoPosition) {
+    riskEngine->setPositionLimit(31, "AAPL", 100);
+    
+    auto order = makeOrder(31, "AAPL", engine::OrderSide::BUY, 60);
+    ASSERT_TRUE(riskEngine->checkOrder(order).approved);
+    
+    record(makeTrade("AAPL", 31, 32, 60, 100.0));
+    order.setFilledQuantity(60);
+    report(order, engine::ExecType::FILL, 60);
+    
+    EXPECT_EQ(riskEngine->getPosition(31, "AAPL").netPosition, 60);
+    EXPECT_FALSE(check(makeOrder(31, "AAPL", engine::OrderSide::BUY, 50)).approved);
+    EXPECT_TRUE(check(makeOrder(31, "AAPL", engine::OrderSide::BUY, 40)).approved);
+}
+
+TEST_F(RiskEngineTest, OpenOrdersCountTowardNotionalLimit) {
+    riskEngine->setNotionalLimit(33, 10000.0);
+    
+    EXPECT_TRUE(check(makeOrder(33, "AAPL", engine::OrderSide::BUY, 50, 100.0)).approved);
+    EXPECT_FALSE(check(makeOrder(33, "GOOGL", engine::OrderSide::SELL, 60, 100.0)).approved);
+    EXPECT_TRUE(check(makeOrder(33, "GOOGL", engine::OrderSide::SELL, 50, 100.0)).approved);
+}
+
+TEST_F(RiskEngineTest, ReturnStatisticsStreamPerPrint) {
+    record(makeTrade("AAPL", 40, 41, 1, 100.0));
+    record(makeTrade("AAPL", 40, 41, 1, 110.0));
+    record(makeTrade("AAPL", 40, 41, 1, 99.0));
+    
+    auto stats = riskEngine->getReturnStatistics("AAPL");
+    EXPECT_EQ(stats.ticks, 2u);
+    EXPECT_NEAR(stats.meanReturn, 0.0, 1e-12);
+    EXPECT_NEAR(stats.volatility, std::sqrt(0.02), 1e-12);
+    EXPECT_GT(stats.ewmaVolatility, 0.0);
+    EXPECT_EQ(riskEngine->getReturnStatistics("GOOGL").ticks, 0u);
+}
+
+TEST_F(RiskEngineTest, HistoricalVarReplaysSampledReturns) {
+    auto start = std::chrono::steady_clock::now();
+    record(makeTrade("AAPL", 42, 43, 100, 100.0));
+    EXPECT_TRUE(riskEngine->sampleReturns(start));
+    EXPECT_FALSE(riskEngine->sampleReturns(start + std::chrono::milliseconds(1)));
+    
+    // Sampled returns 0, +10%, -10% against a 9900 long and a 9900 short
+    record(makeTrade("AAPL", 44, 45, 1, 110.0));
+    EXPECT_TRUE(riskEngine->sampleReturns(start + std::chrono::seconds(1)));
+    record(makeTrade("AAPL", 44, 45, 1, 99.0));
+    EXPECT_TRUE(riskEngine->sampleReturns(start + std::chrono::seconds(2)));
+    
+    EXPECT_EQ(riskEngine->getReturnStatistics("AAPL").varSamples, 3u);
+    EXPECT_NEAR(riskEngine->calculateVar(42), 990.0, 1e-9);
+    EXPECT_NEAR(riskEngine->calculateVar(43), 990.0, 1e-9);
+    EXPECT_DOUBLE_EQ(riskEngine->calculateVar(46), 0.0);
+}
+
+TEST_F(RiskEngineTest, BatchIsApprovedAndReservedAsAWhole) {
+    riskEngine->setPositionLimit(50, "AAPL", 100);
+    
+    auto makeShared = [this](engine::UserId userId, const std::string& symbol, engine::OrderSide side,
+                             engine::Quantity quantity) {
+        return std::make_shared<engine::Order>(makeOrder(userId, symbol, side, quantity));
+    };
+    
+    // Each order fits alone, together they breach: nothing is reserved
+    std::vector<engine::OrderPtr> tooLong{makeShared(50, "AAPL", engine::OrderSide::BUY, 60),
+                                          makeShared(50, "AAPL", engine::OrderSide::BUY, 60)};
+    auto rejected = riskEngine->checkOrders(tooLong);
+    EXPECT_FALSE(rejected.approved);
+    EXPECT_EQ(rejected.reason, "Position limit exceeded");
+    EXPECT_TRUE(check(makeOrder(51, "AAPL", engine::OrderSide::BUY, 100)).approved);
+    
+    std::vector<engine::OrderPtr> quotes{makeShared(50, "AAPL", engine::OrderSide::BUY, 60),
+                                         makeShared(50, "AAPL", engine::OrderSide::SELL, 60),
+                                         makeShared(50, "GOOGL", engine::OrderSide::BUY, 10)};
+    ASSERT_TRUE(riskEngine->checkOrders(quotes).approved);
+    EXPECT_DOUBLE_EQ(quotes[2]->getReservedPrice(), 100.0);
+    EXPECT_FALSE(check(makeOrder(50, "AAPL", engine::OrderSide::BUY, 50)).approved);
+    EXPECT_TRUE(check(makeOrder(50, "AAPL", engine::OrderSide::BUY, 40)).approved);
+    
+    std::vector<engine::OrderPtr> mixed{makeShared(52, "AAPL", engine::OrderSide::BUY, 1),
+                                        makeShared(53, "AAPL", engine::OrderSide::BUY, 1)};
+    EXPECT_EQ(riskEngine->checkOrders(mixed).reason, "Batch spans users");
+}
+
+TEST_F(RiskEngineTest, ModifyReservesOnlyTheChange) {
+    riskEngine->setPositionLimit(60, "AAPL", 100);
+    
+    auto order = makeOrder(60, "AAPL", engine::OrderSide::BUY, 80);
+    ASSERT_TRUE(riskEngine->checkOrder(order).approved);
+    
+    // Growing past the limit is refused and leaves the reservation alone
+    auto grown = riskEngine->checkModify(order, 120, 100.0);
+    EXPECT_FALSE(grown.approved);
+    EXPECT_EQ(grown.reason, "Position limit exceeded");
+    EXPECT_TRUE(check(makeOrder(60, "AAPL", engine::OrderSide::BUY, 20)).approved);
+    
+    // Shrinking frees headroom for another order
+    ASSERT_TRUE(riskEngine->checkModify(order, 30, 99.0).approved);
+    EXPECT_DOUBLE_EQ(order.getReservedPrice(), 99.0);
+    EXPECT_TRUE(check(makeOrder(60, "AAPL", engine::OrderSide::BUY, 50)).approved);
+    EXPECT_FALSE(check(makeOrder(60, "AAPL", engine::OrderSide::BUY, 1)).approved);
+}
+
+TEST_F(RiskEngineTest, MarketOrderNeedsAMark) {
+    engine::Order market(++nextOrderId, 40, "AAPL", engine::OrderType::MARKET, engine::OrderSide::BUY, 0.0, 10);
+    auto result = check(market);
+    EXPECT_FALSE(result.approved);
+    EXPECT_EQ(result.reason, "No mark to value market order");
+    
+    engine::OrderPtr batch[] = {std::make_shared<engine::Order>(market)};
+    EXPECT_FALSE(riskEngine->checkOrders(batch).approved);
+    
+    // Once the instrument has printed, the order is reserved at the mark
+    record(makeTrade("AAPL", 41, 42, 1, 150.0));
+    EXPECT_TRUE(riskEngine->checkOrder(market).approved);
+    EXPECT_DOUBLE_EQ(market.getReservedPrice(), 150.0);
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+// tests/unit/TestStreamingStats.cpp
+#include <gtest/gtest.h>
+#include <risk/StreamingStats.hpp>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+TEST(StreamingStatsTest, WelfordMatchesTwoPassEstimate) {
+    std::vector<double> samples{1.5, -2.0, 3.25, 0.5, 4.0, -1.0, 2.5};
+    risk::WelfordStats stats;
+    for (double sample : samples) {
+        stats.add(sample);
+    }
+    
+    double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    double squares = 0.0;
+    for (double sample : samples) {
+        squares += (sample - mean) * (sample - mean);
+    }
+    
+    EXPECT_EQ(stats.count(), samples.size());
+    EXPECT_NEAR(stats.mean(), mean, 1e-12);
+    EXPECT_NEAR(stats.variance(), squares / (samples.size() - 1), 1e-12);
+}
+
+TEST(StreamingStatsTest, EwmaWeightsRecentSamples) {
+    risk::EwmaStats stats(0.5);
+    stats.add(0.0);
+    EXPECT_DOUBLE_EQ(stats.variance(), 0.0);
+    
+    stats.add(2.0);
+    EXPECT_DOUBLE_EQ(stats.mean(), 1.0);
+    EXPECT_DOUBLE_EQ(stats.variance(), 1.0);
+    
+    for (int i = 0; i < 50; ++i) {
+        stats.add(5.0);
+    }
+    EXPECT_NEAR(stats.mean(), 5.0, 1e-9);
+    EXPECT_NEAR(stats.variance(), 0.0, 1e-9);
+}
+
+TEST(StreamingStatsTest, SampleRingCopiesLatestWindow) {
+    risk::SampleRing<4> ring;
+    for (int i = 1; i <= 6; ++i) {
+        ring.push(i);
+    }
+    
+    double out[4];
+    ring.copyRange(ring.count(), ring.size(), out);
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_DOUBLE_EQ(out[0], 3.0);
+    EXPECT_DOUBLE_EQ(out[3], 6.0);
+    
+    ring.copyRange(5, 2, out);
+    EXPECT_DOUBLE_EQ(out[0], 4.0);
+    EXPECT_DOUBLE_EQ(out[1], 5.0);
+}
+
+TEST(StreamingStatsTest, AxpyHandlesTail) {
+    std::vector<double> x(11), y(11, 1.0);
+    std::iota(x.begin(), x.end(), 0.0);
+    
+    risk::axpy(2.0, x.data(), y.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_DOUBLE_EQ(y[i], 1.0 + 2.0 * i);
+    }
+}
\ No newline at end of file
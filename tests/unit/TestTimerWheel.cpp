@@ -0,0 +1,62 @@
+// tests/unit/TestTimerWheel.cpp
+#include <gtest/gtest.h>
+#include <utils/TimerWheel.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST(TimerWheelTest, FiresInDeadlineOrderAcrossLevels) {
+    utils::TimerWheel<int> wheel(1000);
+    for (int deadline : {1000 + 300000, 1000 + 5, 1000 + 70, 1000 + 4100, 1000 + 64}) {
+        wheel.schedule(deadline, deadline - 1000);
+    }
+    
+    std::vector<int> fired;
+    wheel.advance(1000 + 69, [&](int offset) { fired.push_back(offset); });
+    EXPECT_EQ(fired, (std::vector<int>{5, 64}));
+    
+    wheel.advance(1000 + 400000, [&](int offset) { fired.push_back(offset); });
+    EXPECT_EQ(fired, (std::vector<int>{5, 64, 70, 4100, 300000}));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, CancelledAndStaleTimersNeverFire) {
+    utils::TimerWheel<int> wheel;
+    auto first = wheel.schedule(10, 1);
+    wheel.schedule(10, 2);
+    
+    EXPECT_TRUE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(first));
+    
+    // The freed node is reused; the old handle must not reach the new timer
+    auto reused = wheel.schedule(20, 3);
+    EXPECT_FALSE(wheel.cancel(first));
+    
+    std::vector<int> fired;
+    wheel.advance(30, [&](int payload) { fired.push_back(payload); });
+    EXPECT_EQ(fired, (std::vector<int>{2, 3}));
+    EXPECT_FALSE(wheel.cancel(reused));
+}
+
+TEST(TimerWheelTest, MatchesSortedDeadlinesBeyondTopLevel) {
+    // Two levels of 16 slots cover 256 ticks; later deadlines park and re-place
+    utils::TimerWheel<int64_t, 2, 4> wheel;
+    std::mt19937_64 rng(7);
+    std::vector<int64_t> deadlines;
+    for (int i = 0; i < 500; ++i) {
+        deadlines.push_back(static_cast<int64_t>(rng() % 5000) + 1);
+        wheel.schedule(deadlines.back(), deadlines.back());
+    }
+    
+    std::vector<int64_t> fired;
+    for (int64_t now = 0; now <= 5000; now += 37) {
+        wheel.advance(now, [&](int64_t deadline) {
+            EXPECT_LE(deadline, now);
+            fired.push_back(deadline);
+        });
+    }
+    wheel.advance(5001, [&](int64_t deadline) { fired.push_back(deadline); });
+    
+    std::sort(deadlines.begin(), deadlines.end());
+    EXPECT_EQ(fired, deadlines);
+}
\ No newline at end of file